@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "gipfeli/compression.h"
+#include "gipfeli/sinksource.h"
+
+namespace principia {
+namespace base {
+namespace _block_compressor {
+namespace internal {
+
+using ::google::compression::Compressor;
+using ::google::compression::Sink;
+using ::google::compression::Source;
+
+// A compressor that processes its input in a single block, for codecs whose
+// libraries compress contiguous buffers.  The compressed data start with the
+// uncompressed length, as an unsigned 64-bit little-endian integer, followed by
+// the output of the codec.
+class BlockCompressor : public Compressor {
+ public:
+  size_t Compress(std::string const& input, std::string* output) override;
+  size_t CompressStream(Source* source, Sink* sink) override;
+  size_t MaxCompressedLength(size_t nbytes) override;
+
+  bool GetUncompressedLength(std::string const& compressed,
+                             size_t* uncompressed_length) override;
+  bool GetUncompressedLengthStream(Source* compressed,
+                                   size_t* uncompressed_length) override;
+  bool Uncompress(std::string const& compressed,
+                  std::string* uncompressed) override;
+  bool UncompressStream(Source* compressed, Sink* uncompressed) override;
+
+ protected:
+  // The largest size of the output of |CompressBlock| for an input of |size|
+  // bytes.
+  virtual std::int64_t MaxCompressedBlockSize(std::int64_t size) const = 0;
+
+  // Compresses the |input_size| bytes at |input| into |output|, which has room
+  // for |MaxCompressedBlockSize(input_size)| bytes, and returns the size of the
+  // compressed data.
+  virtual std::int64_t CompressBlock(char const* input,
+                                     std::int64_t input_size,
+                                     char* output,
+                                     std::int64_t output_capacity) = 0;
+
+  // Uncompresses the |input_size| bytes at |input| into exactly |output_size|
+  // bytes at |output|.  Returns false if the input is corrupted.
+  virtual bool UncompressBlock(char const* input,
+                               std::int64_t input_size,
+                               char* output,
+                               std::int64_t output_size) = 0;
+
+ private:
+  static constexpr std::int64_t header_size = sizeof(std::uint64_t);
+
+  // Reads the entire |source|.
+  static std::string Drain(Source& source);
+
+  // Compresses |size| bytes at |input| and appends the result to |output|.
+  void CompressTo(char const* input, std::int64_t size, std::string& output);
+
+  // Uncompresses |compressed| into |uncompressed|, which is resized as
+  // needed.
+  bool UncompressTo(std::string const& compressed, std::string& uncompressed);
+};
+
+// The LZ4 codec: very fast, moderate ratio.
+class LZ4Compressor final : public BlockCompressor {
+ protected:
+  std::int64_t MaxCompressedBlockSize(std::int64_t size) const override;
+  std::int64_t CompressBlock(char const* input,
+                             std::int64_t input_size,
+                             char* output,
+                             std::int64_t output_capacity) override;
+  bool UncompressBlock(char const* input,
+                       std::int64_t input_size,
+                       char* output,
+                       std::int64_t output_size) override;
+};
+
+// The Zstandard codec: slower than LZ4, but with a much better ratio.
+class ZstdCompressor final : public BlockCompressor {
+ public:
+  // |level| is the compression level passed to the library; the default is
+  // the one recommended by the library.
+  explicit ZstdCompressor(int level = 3);
+
+ protected:
+  std::int64_t MaxCompressedBlockSize(std::int64_t size) const override;
+  std::int64_t CompressBlock(char const* input,
+                             std::int64_t input_size,
+                             char* output,
+                             std::int64_t output_capacity) override;
+  bool UncompressBlock(char const* input,
+                       std::int64_t input_size,
+                       char* output,
+                       std::int64_t output_size) override;
+
+ private:
+  int const level_;
+};
+
+}  // namespace internal
+
+using internal::BlockCompressor;
+using internal::LZ4Compressor;
+using internal::ZstdCompressor;
+
+}  // namespace _block_compressor
+}  // namespace base
+}  // namespace principia
+
+#include "base/block_compressor_body.hpp"
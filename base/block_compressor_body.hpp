@@ -0,0 +1,184 @@
+#pragma once
+
+#include "base/block_compressor.hpp"
+
+#include <limits>
+
+#include "glog/logging.h"
+#include "lz4.h"
+#include "zstd.h"
+
+namespace principia {
+namespace base {
+namespace _block_compressor {
+namespace internal {
+
+inline size_t BlockCompressor::Compress(std::string const& input,
+                                        std::string* const output) {
+  output->clear();
+  CompressTo(input.data(), input.size(), *output);
+  return output->size();
+}
+
+inline size_t BlockCompressor::CompressStream(Source* const source,
+                                              Sink* const sink) {
+  std::string const input = Drain(*source);
+  std::string output;
+  CompressTo(input.data(), input.size(), output);
+  sink->Append(output.data(), output.size());
+  return output.size();
+}
+
+inline size_t BlockCompressor::MaxCompressedLength(size_t const nbytes) {
+  return header_size + MaxCompressedBlockSize(nbytes);
+}
+
+inline bool BlockCompressor::GetUncompressedLength(
+    std::string const& compressed,
+    size_t* const uncompressed_length) {
+  if (compressed.size() < header_size) {
+    return false;
+  }
+  std::uint64_t length = 0;
+  for (int i = header_size - 1; i >= 0; --i) {
+    length = (length << 8) | static_cast<unsigned char>(compressed[i]);
+  }
+  if (length > std::numeric_limits<std::int64_t>::max()) {
+    return false;
+  }
+  *uncompressed_length = length;
+  return true;
+}
+
+inline bool BlockCompressor::GetUncompressedLengthStream(
+    Source* const compressed,
+    size_t* const uncompressed_length) {
+  size_t available;
+  char const* const data = compressed->Peek(&available);
+  if (available < header_size) {
+    return false;
+  }
+  return GetUncompressedLength(std::string(data, header_size),
+                               uncompressed_length);
+}
+
+inline bool BlockCompressor::Uncompress(std::string const& compressed,
+                                        std::string* const uncompressed) {
+  return UncompressTo(compressed, *uncompressed);
+}
+
+inline bool BlockCompressor::UncompressStream(Source* const compressed,
+                                              Sink* const uncompressed) {
+  std::string output;
+  if (!UncompressTo(Drain(*compressed), output)) {
+    return false;
+  }
+  uncompressed->Append(output.data(), output.size());
+  return true;
+}
+
+inline std::string BlockCompressor::Drain(Source& source) {
+  std::string result;
+  result.reserve(source.Available());
+  while (source.Available() > 0) {
+    size_t length;
+    char const* const data = source.Peek(&length);
+    result.append(data, length);
+    source.Skip(length);
+  }
+  return result;
+}
+
+inline void BlockCompressor::CompressTo(char const* const input,
+                                        std::int64_t const size,
+                                        std::string& output) {
+  std::int64_t const start = output.size();
+  output.resize(start + header_size + MaxCompressedBlockSize(size));
+  std::uint64_t length = size;
+  for (int i = 0; i < header_size; ++i) {
+    output[start + i] = static_cast<char>(length & 0xFF);
+    length >>= 8;
+  }
+  std::int64_t const compressed_size =
+      CompressBlock(input,
+                    size,
+                    output.data() + start + header_size,
+                    output.size() - start - header_size);
+  output.resize(start + header_size + compressed_size);
+}
+
+inline bool BlockCompressor::UncompressTo(std::string const& compressed,
+                                          std::string& uncompressed) {
+  size_t size;
+  if (!GetUncompressedLength(compressed, &size)) {
+    return false;
+  }
+  uncompressed.resize(size);
+  return UncompressBlock(compressed.data() + header_size,
+                         compressed.size() - header_size,
+                         uncompressed.data(),
+                         size);
+}
+
+inline std::int64_t LZ4Compressor::MaxCompressedBlockSize(
+    std::int64_t const size) const {
+  CHECK_LE(size, LZ4_MAX_INPUT_SIZE);
+  return LZ4_compressBound(size);
+}
+
+inline std::int64_t LZ4Compressor::CompressBlock(
+    char const* const input,
+    std::int64_t const input_size,
+    char* const output,
+    std::int64_t const output_capacity) {
+  int const compressed_size =
+      LZ4_compress_default(input, output, input_size, output_capacity);
+  CHECK_LT(0, compressed_size) << "LZ4 compression of " << input_size
+                               << " bytes failed";
+  return compressed_size;
+}
+
+inline bool LZ4Compressor::UncompressBlock(char const* const input,
+                                           std::int64_t const input_size,
+                                           char* const output,
+                                           std::int64_t const output_size) {
+  if (input_size > std::numeric_limits<int>::max() ||
+      output_size > std::numeric_limits<int>::max()) {
+    return false;
+  }
+  return LZ4_decompress_safe(input, output, input_size, output_size) ==
+         output_size;
+}
+
+inline ZstdCompressor::ZstdCompressor(int const level) : level_(level) {}
+
+inline std::int64_t ZstdCompressor::MaxCompressedBlockSize(
+    std::int64_t const size) const {
+  return ZSTD_compressBound(size);
+}
+
+inline std::int64_t ZstdCompressor::CompressBlock(
+    char const* const input,
+    std::int64_t const input_size,
+    char* const output,
+    std::int64_t const output_capacity) {
+  size_t const compressed_size =
+      ZSTD_compress(output, output_capacity, input, input_size, level_);
+  CHECK(!ZSTD_isError(compressed_size)) << ZSTD_getErrorName(compressed_size);
+  return compressed_size;
+}
+
+inline bool ZstdCompressor::UncompressBlock(char const* const input,
+                                            std::int64_t const input_size,
+                                            char* const output,
+                                            std::int64_t const output_size) {
+  size_t const uncompressed_size =
+      ZSTD_decompress(output, output_size, input, input_size);
+  return !ZSTD_isError(uncompressed_size) &&
+         uncompressed_size == static_cast<size_t>(output_size);
+}
+
+}  // namespace internal
+}  // namespace _block_compressor
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,106 @@
+#include "base/block_compressor.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/array.hpp"
+#include "base/sink_source.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::Le;
+using ::testing::Lt;
+using namespace principia::base::_array;
+using namespace principia::base::_block_compressor;
+using namespace principia::base::_sink_source;
+
+class BlockCompressorTest : public ::testing::Test {
+ protected:
+  BlockCompressorTest() {
+    // Compressible but not trivially so.
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<int> distribution(0, 7);
+    for (int i = 0; i < 100'000; ++i) {
+      uncompressed_.push_back('a' + distribution(random));
+    }
+    compressors_.push_back(std::make_unique<LZ4Compressor>());
+    compressors_.push_back(std::make_unique<ZstdCompressor>());
+  }
+
+  std::string uncompressed_;
+  std::vector<std::unique_ptr<BlockCompressor>> compressors_;
+};
+
+TEST_F(BlockCompressorTest, String) {
+  for (auto const& compressor : compressors_) {
+    std::string compressed;
+    std::string decompressed;
+    EXPECT_EQ(compressed.size(),
+              compressor->Compress(uncompressed_, &compressed));
+    EXPECT_THAT(compressed.size(), Lt(uncompressed_.size()));
+    EXPECT_THAT(compressed.size(),
+                Le(compressor->MaxCompressedLength(uncompressed_.size())));
+
+    std::size_t length;
+    EXPECT_TRUE(compressor->GetUncompressedLength(compressed, &length));
+    EXPECT_EQ(uncompressed_.size(), length);
+    EXPECT_TRUE(compressor->Uncompress(compressed, &decompressed));
+    EXPECT_EQ(uncompressed_, decompressed);
+
+    compressor->Compress("", &compressed);
+    EXPECT_TRUE(compressor->Uncompress(compressed, &decompressed));
+    EXPECT_EQ("", decompressed);
+  }
+}
+
+// This is how the compressors are used by |PullSerializer| and
+// |PushDeserializer|.
+TEST_F(BlockCompressorTest, Stream) {
+  for (auto const& compressor : compressors_) {
+    std::vector<std::uint8_t> compressed_bytes(
+        compressor->MaxCompressedLength(uncompressed_.size()));
+    ArraySource<std::uint8_t const> uncompressed_source(
+        Array<std::uint8_t const>(
+            reinterpret_cast<std::uint8_t const*>(uncompressed_.data()),
+            uncompressed_.size()));
+    ArraySink<std::uint8_t> compressed_sink(Array<std::uint8_t>(
+        compressed_bytes.data(), compressed_bytes.size()));
+    compressor->CompressStream(&uncompressed_source, &compressed_sink);
+    Array<std::uint8_t> const compressed = compressed_sink.array();
+
+    std::vector<std::uint8_t> decompressed_bytes(uncompressed_.size());
+    ArraySource<std::uint8_t> compressed_source(compressed);
+    ArraySink<std::uint8_t> decompressed_sink(Array<std::uint8_t>(
+        decompressed_bytes.data(), decompressed_bytes.size()));
+    std::size_t length;
+    EXPECT_TRUE(
+        compressor->GetUncompressedLengthStream(&compressed_source, &length));
+    EXPECT_EQ(uncompressed_.size(), length);
+    EXPECT_TRUE(
+        compressor->UncompressStream(&compressed_source, &decompressed_sink));
+    EXPECT_EQ(uncompressed_.size(), decompressed_sink.array().size);
+    EXPECT_EQ(uncompressed_,
+              std::string(decompressed_bytes.begin(),
+                          decompressed_bytes.end()));
+  }
+}
+
+TEST_F(BlockCompressorTest, Corrupted) {
+  for (auto const& compressor : compressors_) {
+    std::string compressed;
+    std::string decompressed;
+    EXPECT_FALSE(compressor->Uncompress("abc", &decompressed));
+    compressor->Compress(uncompressed_, &compressed);
+    compressed.resize(compressed.size() / 2);
+    EXPECT_FALSE(compressor->Uncompress(compressed, &decompressed));
+  }
+}
+
+}  // namespace base
+}  // namespace principia
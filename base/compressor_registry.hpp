@@ -0,0 +1,60 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "gipfeli/compression.h"
+
+namespace principia {
+namespace base {
+namespace _compressor_registry {
+namespace internal {
+
+using ::google::compression::Compressor;
+
+// The names under which the codecs that ship with Principia are always
+// registered.  LZ4 is the fastest, Zstandard has the best ratio, gipfeli is in
+// between and is the one used by the journal.  Other codecs may be registered
+// by the client using |RegisterCompressor|.
+constexpr std::string_view gipfeli_compressor = "gipfeli";
+constexpr std::string_view lz4_compressor = "lz4";
+constexpr std::string_view zstd_compressor = "zstd";
+
+// A function that returns a new compressor.
+using CompressorFactory = std::function<std::unique_ptr<Compressor>()>;
+
+// Registers a compressor under the given |name|, which may then be passed to
+// |NewCompressor|.  |name| must not be empty nor already registered.  This
+// function is thread-safe.
+inline void RegisterCompressor(std::string_view name,
+                               CompressorFactory factory);
+
+// Returns a new compressor for the given |name|, or null if |name| is empty,
+// which means that no compression is desired.  Fails if no compressor is
+// registered under |name|.  This function is thread-safe.
+inline std::unique_ptr<Compressor> NewCompressor(std::string_view name);
+
+// Returns the names of the registered compressors, in alphabetical order.
+inline std::vector<std::string> RegisteredCompressors();
+
+}  // namespace internal
+
+using internal::CompressorFactory;
+using internal::gipfeli_compressor;
+using internal::lz4_compressor;
+using internal::NewCompressor;
+using internal::RegisterCompressor;
+using internal::RegisteredCompressors;
+using internal::zstd_compressor;
+
+}  // namespace _compressor_registry
+}  // namespace base
+}  // namespace principia
+
+#include "base/compressor_registry_body.hpp"
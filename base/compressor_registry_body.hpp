@@ -0,0 +1,79 @@
+#pragma once
+
+#include "base/compressor_registry.hpp"
+
+#include <utility>
+
+#include "base/block_compressor.hpp"
+#include "gipfeli/gipfeli.h"
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _compressor_registry {
+namespace internal {
+
+using namespace principia::base::_block_compressor;
+
+// The registry, initialized with the compressors that are always available.
+class Registry {
+ public:
+  static Registry& Get() {
+    static auto* const registry = new Registry();
+    return *registry;
+  }
+
+  absl::Mutex lock;
+  std::map<std::string, CompressorFactory, std::less<>> factories
+      GUARDED_BY(lock);
+
+ private:
+  Registry() {
+    factories.emplace(gipfeli_compressor,
+                      &::google::compression::NewGipfeliCompressor);
+    factories.emplace(lz4_compressor,
+                      []() { return std::make_unique<LZ4Compressor>(); });
+    factories.emplace(zstd_compressor,
+                      []() { return std::make_unique<ZstdCompressor>(); });
+  }
+};
+
+inline void RegisterCompressor(std::string_view const name,
+                               CompressorFactory factory) {
+  CHECK(!name.empty());
+  auto& registry = Registry::Get();
+  absl::MutexLock l(&registry.lock);
+  bool const inserted =
+      registry.factories.emplace(name, std::move(factory)).second;
+  CHECK(inserted) << "Compressor " << name << " already registered";
+}
+
+inline std::unique_ptr<Compressor> NewCompressor(std::string_view const name) {
+  if (name.empty()) {
+    return nullptr;
+  }
+  auto& registry = Registry::Get();
+  CompressorFactory factory;
+  {
+    absl::ReaderMutexLock l(&registry.lock);
+    auto const it = registry.factories.find(name);
+    CHECK(it != registry.factories.end()) << "Unknown compressor " << name;
+    factory = it->second;
+  }
+  return factory();
+}
+
+inline std::vector<std::string> RegisteredCompressors() {
+  auto& registry = Registry::Get();
+  absl::ReaderMutexLock l(&registry.lock);
+  std::vector<std::string> names;
+  for (auto const& [name, _] : registry.factories) {
+    names.push_back(name);
+  }
+  return names;
+}
+
+}  // namespace internal
+}  // namespace _compressor_registry
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,75 @@
+#include "base/compressor_registry.hpp"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::Contains;
+using namespace principia::base::_compressor_registry;
+
+class CompressorRegistryTest : public ::testing::Test {};
+
+TEST_F(CompressorRegistryTest, Gipfeli) {
+  EXPECT_EQ(nullptr, NewCompressor(""));
+  EXPECT_THAT(RegisteredCompressors(), Contains("gipfeli"));
+
+  auto const compressor = NewCompressor(gipfeli_compressor);
+  ASSERT_NE(nullptr, compressor);
+  std::string const uncompressed(10'000, 'x');
+  std::string compressed;
+  std::string decompressed;
+  compressor->Compress(uncompressed, &compressed);
+  EXPECT_LT(compressed.size(), uncompressed.size());
+  EXPECT_TRUE(compressor->Uncompress(compressed, &decompressed));
+  EXPECT_EQ(uncompressed, decompressed);
+}
+
+TEST_F(CompressorRegistryTest, Builtin) {
+  EXPECT_THAT(RegisteredCompressors(), Contains("lz4"));
+  EXPECT_THAT(RegisteredCompressors(), Contains("zstd"));
+  std::string const uncompressed(10'000, 'x');
+  for (auto const name : {lz4_compressor, zstd_compressor}) {
+    auto const compressor = NewCompressor(name);
+    ASSERT_NE(nullptr, compressor) << name;
+    std::string compressed;
+    std::string decompressed;
+    compressor->Compress(uncompressed, &compressed);
+    EXPECT_LT(compressed.size(), uncompressed.size()) << name;
+    EXPECT_TRUE(compressor->Uncompress(compressed, &decompressed)) << name;
+    EXPECT_EQ(uncompressed, decompressed) << name;
+  }
+}
+
+TEST_F(CompressorRegistryTest, Register) {
+  // The registry is global, so each run of this test (e.g., with
+  // --gtest_repeat) must use a new name.
+  static int runs = 0;
+  std::string const name = "test" + std::to_string(runs++);
+  int calls = 0;
+  RegisterCompressor(name, [&calls]() {
+    ++calls;
+    return NewCompressor(gipfeli_compressor);
+  });
+  EXPECT_THAT(RegisteredCompressors(), Contains(name));
+  EXPECT_NE(nullptr, NewCompressor(name));
+  EXPECT_EQ(1, calls);
+}
+
+using CompressorRegistryDeathTest = CompressorRegistryTest;
+
+TEST_F(CompressorRegistryDeathTest, Errors) {
+  EXPECT_DEATH({
+    NewCompressor("brotli");
+  }, "Unknown compressor brotli");
+  EXPECT_DEATH({
+    RegisterCompressor(gipfeli_compressor, nullptr);
+  }, "already registered");
+}
+
+}  // namespace base
+}  // namespace principia
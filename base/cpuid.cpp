@@ -36,6 +36,24 @@ CPUIDResult CPUID(std::uint32_t const eax, std::uint32_t const ecx) {
 #endif
 }
 
+// Returns the value of the extended control register XCR0.  Must only be called
+// if the OSXSAVE feature flag is set.
+std::uint64_t XCR0() {
+#if PRINCIPIA_COMPILER_MSVC
+  return _xgetbv(0);
+#else
+  std::uint32_t eax;
+  std::uint32_t edx;
+  __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+// The bits of XCR0 that must be set for the operating system to save the given
+// registers.
+constexpr std::uint64_t xcr0_xmm_and_ymm = 0b110;
+constexpr std::uint64_t xcr0_opmask_and_zmm = 0b1110'0000;
+
 std::string CPUVendorIdentificationString() {
   auto const leaf_0 = CPUID(0, 0);
   std::string result(12, '\0');
@@ -51,6 +69,12 @@ CPUFeatureFlags operator|(CPUFeatureFlags const left,
                                       static_cast<std::uint64_t>(right));
 }
 
+CPUExtendedFeatureFlags operator|(CPUExtendedFeatureFlags const left,
+                                  CPUExtendedFeatureFlags const right) {
+  return static_cast<CPUExtendedFeatureFlags>(
+      static_cast<std::uint32_t>(left) | static_cast<std::uint32_t>(right));
+}
+
 bool HasCPUFeatures(CPUFeatureFlags const flags) {
   auto const leaf_1 = CPUID(1, 0);
   return static_cast<CPUFeatureFlags>(
@@ -58,6 +82,26 @@ bool HasCPUFeatures(CPUFeatureFlags const flags) {
              static_cast<std::uint64_t>(flags)) == flags;
 }
 
+bool HasCPUFeatures(CPUExtendedFeatureFlags const flags) {
+  // Leaf 7 may not exist on old processors.
+  if (CPUID(0, 0).eax < 7) {
+    return false;
+  }
+  auto const leaf_7 = CPUID(7, 0);
+  return static_cast<CPUExtendedFeatureFlags>(
+             leaf_7.ebx & static_cast<std::uint32_t>(flags)) == flags;
+}
+
+bool OperatingSystemSupportsAVX() {
+  return HasCPUFeatures(CPUFeatureFlags::OSXSAVE) &&
+         (XCR0() & xcr0_xmm_and_ymm) == xcr0_xmm_and_ymm;
+}
+
+bool OperatingSystemSupportsAVX512() {
+  std::uint64_t const mask = xcr0_xmm_and_ymm | xcr0_opmask_and_zmm;
+  return HasCPUFeatures(CPUFeatureFlags::OSXSAVE) && (XCR0() & mask) == mask;
+}
+
 }  // namespace internal
 }  // namespace _cpuid
 }  // namespace base
@@ -25,24 +25,46 @@ enum class CPUFeatureFlags : std::uint64_t {
   SSE = edx_bit << 25,   // Streaming SIMD Extensions.
   SSE2 = edx_bit << 26,  // Streaming SIMD Extensions 2.
   // Table 3-10.
-  SSE3 = ecx_bit << 0,     // Streaming SIMD Extensions 3.
-  FMA = ecx_bit << 12,     // Fused Multiply Add.
-  SSE4_1 = ecx_bit << 19,  // Streaming SIMD Extensions 4.1.
-  AVX = ecx_bit << 28,     // Advanced Vector eXtensions.
+  SSE3 = ecx_bit << 0,      // Streaming SIMD Extensions 3.
+  FMA = ecx_bit << 12,      // Fused Multiply Add.
+  SSE4_1 = ecx_bit << 19,   // Streaming SIMD Extensions 4.1.
+  OSXSAVE = ecx_bit << 27,  // XSAVE enabled by the operating system.
+  AVX = ecx_bit << 28,      // Advanced Vector eXtensions.
+};
+
+// Leaf 7, sub-leaf 0.
+// We represent feature flags as EBX.
+enum class CPUExtendedFeatureFlags : std::uint32_t {
+  // Table 3-8.
+  AVX2 = 1 << 5,      // Advanced Vector eXtensions 2.
+  AVX512F = 1 << 16,  // AVX-512 Foundation.
 };
 
 // Bitwise or of feature flags; the result represents the union of all features
 // in |left| and |right|.
 CPUFeatureFlags operator|(CPUFeatureFlags left, CPUFeatureFlags right);
 
+CPUExtendedFeatureFlags operator|(CPUExtendedFeatureFlags left,
+                                  CPUExtendedFeatureFlags right);
+
 // Whether the CPU has all features listed in |flags|.
 bool HasCPUFeatures(CPUFeatureFlags flags);
+bool HasCPUFeatures(CPUExtendedFeatureFlags flags);
+
+// Whether the operating system saves the YMM (respectively, the ZMM and opmask)
+// registers on context switches, as reported by XGETBV.  The AVX (respectively,
+// AVX-512) instructions may only be used if this returns true.
+bool OperatingSystemSupportsAVX();
+bool OperatingSystemSupportsAVX512();
 
 }  // namespace internal
 
+using internal::CPUExtendedFeatureFlags;
 using internal::CPUFeatureFlags;
 using internal::CPUVendorIdentificationString;
 using internal::HasCPUFeatures;
+using internal::OperatingSystemSupportsAVX;
+using internal::OperatingSystemSupportsAVX512;
 
 }  // namespace _cpuid
 }  // namespace base
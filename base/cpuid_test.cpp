@@ -32,5 +32,21 @@ TEST_F(CPUIDTest, CPUFeatureFlags) {
                               CPUFeatureFlags::PSN));
 }
 
+TEST_F(CPUIDTest, CPUExtendedFeatureFlags) {
+  // AVX-512 processors have AVX2.
+  if (HasCPUFeatures(CPUExtendedFeatureFlags::AVX512F)) {
+    EXPECT_TRUE(HasCPUFeatures(CPUExtendedFeatureFlags::AVX2));
+  }
+  // AVX2 processors have AVX.
+  if (HasCPUFeatures(CPUExtendedFeatureFlags::AVX2)) {
+    EXPECT_TRUE(HasCPUFeatures(CPUFeatureFlags::AVX));
+  }
+  // An operating system that saves the ZMM registers also saves the YMM
+  // registers.
+  if (OperatingSystemSupportsAVX512()) {
+    EXPECT_TRUE(OperatingSystemSupportsAVX());
+  }
+}
+
 }  // namespace base
 }  // namespace principia
@@ -48,6 +48,11 @@ class stop_token {
 // https://en.cppreference.com/w/cpp/thread/stop_source
 class stop_source {
  public:
+  // Constructs a stop_source with a new stop-state, which is shared by the
+  // copies of this object.  The tokens obtained from this object must not
+  // outlive it and its copies.
+  stop_source();
+
   bool request_stop();
 
   bool stop_requested() const;
@@ -57,6 +62,8 @@ class stop_source {
  private:
   explicit stop_source(not_null<StopState*> stop_state);
 
+  // Only set if this object was default-constructed.
+  std::shared_ptr<StopState> owned_stop_state_;
   not_null<StopState*> const stop_state_;
 
   friend class jthread;
@@ -120,6 +127,19 @@ class this_stoppable_thread {
  public:
   static stop_token get_stop_token();
 
+  // While an object of this class is alive, the stop token of the current
+  // thread is the one given at construction.  This makes it possible for work
+  // delegated by a stoppable thread to another thread (e.g., a thread of a
+  // |ThreadPool|) to honour |RETURN_IF_STOPPED|.
+  class StopTokenSetter final {
+   public:
+    explicit StopTokenSetter(stop_token const& st);
+    ~StopTokenSetter();
+
+   private:
+    stop_token const previous_stop_token_;
+  };
+
  private:
   inline static thread_local stop_token stop_token_;
 
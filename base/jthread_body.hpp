@@ -78,6 +78,10 @@ inline StopState& stop_token::get_stop_state() const {
   return *stop_state_;
 }
 
+inline stop_source::stop_source()
+    : owned_stop_state_(std::make_shared<StopState>()),
+      stop_state_(owned_stop_state_.get()) {}
+
 inline bool stop_source::request_stop() {
   return stop_state_->request_stop();
 }
@@ -179,6 +183,16 @@ inline stop_token this_stoppable_thread::get_stop_token() {
   return stop_token_;
 }
 
+inline this_stoppable_thread::StopTokenSetter::StopTokenSetter(
+    stop_token const& st)
+    : previous_stop_token_(stop_token_) {
+  stop_token_ = st;
+}
+
+inline this_stoppable_thread::StopTokenSetter::~StopTokenSetter() {
+  stop_token_ = previous_stop_token_;
+}
+
 }  // namespace internal
 }  // namespace _jthread
 }  // namespace base
@@ -142,6 +142,31 @@ TEST(JThreadTest, ThisJThread) {
   EXPECT_TRUE(observed_stop);
 }
 
+TEST(JThreadTest, StopTokenSetter) {
+  bool observed_stop = false;
+
+  auto worker = MakeStoppableThread([&observed_stop]() {
+    stop_token const st = this_stoppable_thread::get_stop_token();
+    // A thread that is not stoppable, to which the stop token is propagated.
+    std::thread delegate([&observed_stop, st]() {
+      EXPECT_FALSE(
+          this_stoppable_thread::get_stop_token().stop_requested());
+      this_stoppable_thread::StopTokenSetter setter(st);
+      while (!this_stoppable_thread::get_stop_token().stop_requested()) {
+        absl::SleepFor(absl::Milliseconds(10));
+      }
+      observed_stop = true;
+    });
+    delegate.join();
+  });
+
+  absl::SleepFor(absl::Milliseconds(30));
+  worker.request_stop();
+  worker.join();
+  EXPECT_TRUE(observed_stop);
+  EXPECT_FALSE(this_stoppable_thread::get_stop_token().stop_requested());
+}
+
 
 
 }  // namespace base
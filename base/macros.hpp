@@ -128,6 +128,7 @@ inline void noreturn() { std::exit(0); }
 // 64-bit architectures.
 #define PRINCIPIA_USE_SSE3_INTRINSICS !_DEBUG
 #define PRINCIPIA_USE_FMA_IF_AVAILABLE !_DEBUG
+#define PRINCIPIA_USE_AVX_IF_AVAILABLE !_DEBUG
 
 // Set this to 1 to test analytical series based on piecewise Poisson series.
 #define PRINCIPIA_CONTINUOUS_TRAJECTORY_SUPPORTS_PIECEWISE_POISSON_SERIES 0
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <optional>
+#include <set>
+#include <thread>
+#include <tuple>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "base/jthread.hpp"
+#include "base/not_null.hpp"
+
+namespace principia {
+namespace base {
+namespace _scheduler {
+namespace internal {
+
+using namespace principia::base::_jthread;
+using namespace principia::base::_not_null;
+
+class BaseScheduledAction;
+
+// A fixed set of worker threads shared by many |ScheduledAction|s, so that the
+// number of threads scales with the number of cores, not with the number of
+// actions.  The actions that have input are kept in a priority queue: the
+// action with the highest priority is run, the earliest deadline breaking ties.
+// An action whose deadline has passed is promoted by one priority level, so
+// that it is not starved by the actions of the level immediately above, but it
+// never delays the actions that are two levels above it.  Since background
+// actions may block for long periods, they may not occupy all the workers if
+// there are more than one: a worker is kept for the other actions.  This class
+// is thread-safe.
+class Scheduler final {
+ public:
+  // The priority of an action, from highest to lowest.
+  enum class Priority : int {
+    Urgent = 0,
+    Visible = 1,
+    Background = 2,
+  };
+
+  // Constructs a scheduler with the given number of worker threads.
+  explicit Scheduler(std::int64_t number_of_workers);
+
+  // Stops the workers.  All the actions of this scheduler must have been
+  // destroyed.
+  ~Scheduler();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // The queue entries contain the data used for ordering followed by the
+  // action.  The sequence number makes the entries unique.
+  using PriorityEntry = std::tuple<Priority,
+                                   Clock::time_point,
+                                   std::uint64_t,
+                                   BaseScheduledAction*>;
+  using DeadlineEntry =
+      std::tuple<Clock::time_point, std::uint64_t, BaseScheduledAction*>;
+
+  // Inserts |action|, which must not be queued, in the queues.
+  void EnqueueLocked(not_null<BaseScheduledAction*> action)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Removes |action|, which must be queued, from the queues.
+  void DequeueLocked(not_null<BaseScheduledAction*> action)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // True if |action| may run now given the number of workers running
+  // background actions.
+  bool MayRunLocked(BaseScheduledAction const& action) const
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // True if some queued action may run now.
+  bool HasRunnableActionLocked() const EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Returns the next action to run and removes it from the queues.
+  // |HasRunnableActionLocked| must be true.
+  not_null<BaseScheduledAction*> PopLocked() EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // The loop executed by each worker.
+  void RunActions();
+
+  // The number of workers that may run background actions at the same time.
+  std::int64_t const max_background_workers_;
+
+  absl::Mutex lock_;
+  std::int64_t background_workers_ GUARDED_BY(lock_) = 0;
+  std::set<PriorityEntry> priority_queue_ GUARDED_BY(lock_);
+  std::set<DeadlineEntry> deadline_queue_ GUARDED_BY(lock_);
+  std::uint64_t next_sequence_ GUARDED_BY(lock_) = 0;
+  bool shutdown_ GUARDED_BY(lock_) = false;
+
+  std::list<std::thread> workers_;
+
+  friend class BaseScheduledAction;
+};
+
+// An action that transforms inputs into outputs on the workers of a
+// |Scheduler|.  This is the analogue of a |RecurringThread| without a thread of
+// its own: an input that is |Put| while a previous input is waiting to be
+// processed supersedes it, and each input is processed at most once.  The
+// action is run with a stop token that is triggered by |Stop|, so it should use
+// |RETURN_IF_STOPPED| to return promptly.  This class and its subclasses are
+// thread-safe.  The base class is used to factor code common to the various
+// template specializations and should not be used directly.
+class BaseScheduledAction {
+ public:
+  virtual ~BaseScheduledAction();
+
+  // Starts or stops the processing of the inputs.  These functions are
+  // idempotent.  |Stop| waits until the action, if it is running, has returned.
+  // A pending input is kept while the action is stopped.
+  void Start();
+  void Stop();
+
+  // Stop followed by Start.
+  void Restart();
+
+  // Changes the priority of the action, including that of a pending input.
+  void set_priority(Scheduler::Priority priority);
+
+ protected:
+  // Constructs an action in the stopped state.  An input is expected to start
+  // being processed no later than |latency| after it was |Put|, if the workers
+  // are not overloaded.
+  BaseScheduledAction(not_null<Scheduler*> scheduler,
+                      Scheduler::Priority priority,
+                      std::chrono::milliseconds latency);
+
+  // Called by the subclasses after an input has been written.
+  void Schedule();
+
+  // Overidden by subclasses to actually run the action.
+  virtual absl::Status RunAction() = 0;
+
+ private:
+  bool idle() const EXCLUSIVE_LOCKS_REQUIRED(scheduler_->lock_);
+
+  not_null<Scheduler*> const scheduler_;
+  std::chrono::milliseconds const latency_;
+
+  // All the scheduling state is protected by the lock of the scheduler.
+  Scheduler::Priority priority_ GUARDED_BY(scheduler_->lock_);
+  bool started_ GUARDED_BY(scheduler_->lock_) = false;
+  // True if there is an input that is not being processed.
+  bool pending_ GUARDED_BY(scheduler_->lock_) = false;
+  bool running_ GUARDED_BY(scheduler_->lock_) = false;
+  // The deadline of the oldest pending input.
+  Scheduler::Clock::time_point deadline_ GUARDED_BY(scheduler_->lock_);
+  // Set if the action is in the queues of the scheduler.
+  std::optional<std::uint64_t> sequence_ GUARDED_BY(scheduler_->lock_);
+  // Set while the action is running.
+  std::optional<stop_source> stop_source_ GUARDED_BY(scheduler_->lock_);
+
+  friend class Scheduler;
+};
+
+// A template for an action that returns a value.
+template<typename Input, typename Output = void>
+class ScheduledAction : public BaseScheduledAction {
+ public:
+  // If an action returns an error, no output in written to the output channel.
+  using Action = std::function<absl::StatusOr<Output>(Input)>;
+
+  ScheduledAction(not_null<Scheduler*> scheduler,
+                  Action action,
+                  Scheduler::Priority priority,
+                  std::chrono::milliseconds latency);
+
+  ~ScheduledAction() override;
+
+  // Overwrites the contents of the input channel.  The |input| data will be
+  // either picked by the next execution of |action|, or overwritten by the next
+  // call to |Put|.
+  void Put(Input input);
+
+  // Extracts data from the output channel, if there is any.
+  std::optional<Output> Get();
+
+ private:
+  absl::Status RunAction() override;
+
+  Action const action_;
+
+  absl::Mutex input_output_lock_;
+  std::optional<Input> input_ GUARDED_BY(input_output_lock_);
+  std::optional<Output> output_ GUARDED_BY(input_output_lock_);
+};
+
+// A template for an action that returns no value.
+template<typename Input>
+class ScheduledAction<Input, void> : public BaseScheduledAction {
+ public:
+  using Action = std::function<absl::Status(Input)>;
+
+  ScheduledAction(not_null<Scheduler*> scheduler,
+                  Action action,
+                  Scheduler::Priority priority,
+                  std::chrono::milliseconds latency);
+
+  ~ScheduledAction() override;
+
+  // Overwrites the contents of the input channel.  The |input| data will be
+  // either picked by the next execution of |action|, or overwritten by the next
+  // call to |Put|.
+  void Put(Input input);
+
+ private:
+  absl::Status RunAction() override;
+
+  Action const action_;
+
+  absl::Mutex input_lock_;
+  std::optional<Input> input_ GUARDED_BY(input_lock_);
+};
+
+}  // namespace internal
+
+using internal::ScheduledAction;
+using internal::Scheduler;
+
+}  // namespace _scheduler
+}  // namespace base
+}  // namespace principia
+
+#include "base/scheduler_body.hpp"
@@ -0,0 +1,309 @@
+#pragma once
+
+#include "base/scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _scheduler {
+namespace internal {
+
+inline Scheduler::Scheduler(std::int64_t const number_of_workers)
+    : max_background_workers_(
+          std::max<std::int64_t>(1, number_of_workers - 1)) {
+  CHECK_LE(1, number_of_workers);
+  for (std::int64_t i = 0; i < number_of_workers; ++i) {
+    workers_.emplace_back(&Scheduler::RunActions, this);
+  }
+}
+
+inline Scheduler::~Scheduler() {
+  {
+    absl::MutexLock l(&lock_);
+    CHECK(priority_queue_.empty());
+    shutdown_ = true;
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+inline void Scheduler::EnqueueLocked(
+    not_null<BaseScheduledAction*> const action) {
+  CHECK(!action->sequence_.has_value());
+  std::uint64_t const sequence = next_sequence_++;
+  action->sequence_ = sequence;
+  priority_queue_.emplace(
+      action->priority_, action->deadline_, sequence, action);
+  deadline_queue_.emplace(action->deadline_, sequence, action);
+}
+
+inline void Scheduler::DequeueLocked(
+    not_null<BaseScheduledAction*> const action) {
+  std::uint64_t const sequence = action->sequence_.value();
+  action->sequence_.reset();
+  CHECK_EQ(1,
+           priority_queue_.erase(
+               {action->priority_, action->deadline_, sequence, action}));
+  CHECK_EQ(1, deadline_queue_.erase({action->deadline_, sequence, action}));
+}
+
+inline bool Scheduler::MayRunLocked(BaseScheduledAction const& action) const {
+  return action.priority_ != Priority::Background ||
+         background_workers_ < max_background_workers_;
+}
+
+inline bool Scheduler::HasRunnableActionLocked() const {
+  // If the highest-priority action is a background action, all the actions
+  // are.
+  return !priority_queue_.empty() &&
+         MayRunLocked(*std::get<BaseScheduledAction*>(*priority_queue_.begin()));
+}
+
+inline not_null<BaseScheduledAction*> Scheduler::PopLocked() {
+  BaseScheduledAction* action =
+      std::get<BaseScheduledAction*>(*priority_queue_.begin());
+  // Look for an overdue action that is at most one level below |action|.  The
+  // overdue actions of the level of |action| are already ordered by deadline in
+  // the priority queue, but there is no harm in finding them here.
+  auto const now = Clock::now();
+  for (auto const& [deadline, _, overdue_action] : deadline_queue_) {
+    if (deadline > now) {
+      break;
+    }
+    if (static_cast<int>(overdue_action->priority_) <=
+            static_cast<int>(action->priority_) + 1 &&
+        MayRunLocked(*overdue_action)) {
+      action = overdue_action;
+      break;
+    }
+  }
+  DequeueLocked(action);
+  return action;
+}
+
+inline void Scheduler::RunActions() {
+  for (;;) {
+    BaseScheduledAction* action;
+    bool background;
+    std::optional<stop_source> source;
+    {
+      absl::MutexLock l(&lock_);
+      auto const has_work_or_shutdown = [this]() {
+        lock_.AssertReaderHeld();
+        return shutdown_ || HasRunnableActionLocked();
+      };
+      lock_.Await(absl::Condition(&has_work_or_shutdown));
+      if (shutdown_) {
+        return;
+      }
+      action = PopLocked();
+      // The priority of the action may change while it runs, so we remember
+      // how it was counted.
+      background = action->priority_ == Priority::Background;
+      if (background) {
+        ++background_workers_;
+      }
+      action->pending_ = false;
+      action->running_ = true;
+      action->stop_source_.emplace();
+      source.emplace(*action->stop_source_);
+    }
+
+    {
+      this_stoppable_thread::StopTokenSetter setter(source->get_token());
+      action->RunAction().IgnoreError();
+    }
+
+    {
+      absl::MutexLock l(&lock_);
+      if (background) {
+        --background_workers_;
+      }
+      action->running_ = false;
+      action->stop_source_.reset();
+      // An input may have been put while the action was running.
+      if (action->started_ && action->pending_) {
+        EnqueueLocked(action);
+      }
+    }
+  }
+}
+
+inline BaseScheduledAction::~BaseScheduledAction() {
+  Stop();
+}
+
+inline void BaseScheduledAction::Start() {
+  absl::MutexLock l(&scheduler_->lock_);
+  started_ = true;
+  if (pending_ && !running_ && !sequence_.has_value()) {
+    scheduler_->EnqueueLocked(this);
+  }
+}
+
+inline void BaseScheduledAction::Stop() {
+  absl::MutexLock l(&scheduler_->lock_);
+  started_ = false;
+  if (sequence_.has_value()) {
+    scheduler_->DequeueLocked(this);
+  }
+  if (running_) {
+    stop_source_->request_stop();
+    scheduler_->lock_.Await(absl::Condition(this, &BaseScheduledAction::idle));
+  }
+}
+
+inline void BaseScheduledAction::Restart() {
+  Stop();
+  Start();
+}
+
+inline void BaseScheduledAction::set_priority(
+    Scheduler::Priority const priority) {
+  absl::MutexLock l(&scheduler_->lock_);
+  if (priority == priority_) {
+    return;
+  }
+  if (sequence_.has_value()) {
+    scheduler_->DequeueLocked(this);
+    priority_ = priority;
+    scheduler_->EnqueueLocked(this);
+  } else {
+    priority_ = priority;
+  }
+}
+
+inline BaseScheduledAction::BaseScheduledAction(
+    not_null<Scheduler*> const scheduler,
+    Scheduler::Priority const priority,
+    std::chrono::milliseconds const latency)
+    : scheduler_(scheduler),
+      latency_(latency),
+      priority_(priority) {}
+
+inline void BaseScheduledAction::Schedule() {
+  absl::MutexLock l(&scheduler_->lock_);
+  // A superseded input keeps its deadline, otherwise an action whose input
+  // changes frequently could be postponed indefinitely.
+  if (!pending_) {
+    pending_ = true;
+    deadline_ = Scheduler::Clock::now() + latency_;
+  }
+  if (started_ && !running_ && !sequence_.has_value()) {
+    scheduler_->EnqueueLocked(this);
+  }
+}
+
+inline bool BaseScheduledAction::idle() const {
+  return !running_;
+}
+
+template<typename Input, typename Output>
+ScheduledAction<Input, Output>::ScheduledAction(
+    not_null<Scheduler*> const scheduler,
+    Action action,
+    Scheduler::Priority const priority,
+    std::chrono::milliseconds const latency)
+    : BaseScheduledAction(scheduler, priority, latency),
+      action_(std::move(action)) {}
+
+template<typename Input, typename Output>
+ScheduledAction<Input, Output>::~ScheduledAction() {
+  // Make sure that the action doesn't run once the members of this class have
+  // been destroyed.
+  Stop();
+}
+
+template<typename Input, typename Output>
+void ScheduledAction<Input, Output>::Put(Input input) {
+  {
+    absl::MutexLock l(&input_output_lock_);
+    input_ = std::move(input);
+  }
+  Schedule();
+}
+
+template<typename Input, typename Output>
+std::optional<Output> ScheduledAction<Input, Output>::Get() {
+  absl::MutexLock l(&input_output_lock_);
+  std::optional<Output> result;
+  if (output_.has_value()) {
+    std::swap(result, output_);
+  }
+  return result;
+}
+
+template<typename Input, typename Output>
+absl::Status ScheduledAction<Input, Output>::RunAction() {
+  std::optional<Input> input;
+  {
+    absl::MutexLock l(&input_output_lock_);
+    if (!input_.has_value()) {
+      // The input was consumed by a previous execution.
+      return absl::OkStatus();
+    }
+    std::swap(input, input_);
+  }
+  RETURN_IF_STOPPED;
+
+  absl::StatusOr<Output> status_or_output = action_(input.value());
+  RETURN_IF_STOPPED;
+
+  if (status_or_output.ok()) {
+    absl::MutexLock l(&input_output_lock_);
+    output_ = std::move(status_or_output.value());
+  }
+
+  return status_or_output.status();
+}
+
+template<typename Input>
+ScheduledAction<Input, void>::ScheduledAction(
+    not_null<Scheduler*> const scheduler,
+    Action action,
+    Scheduler::Priority const priority,
+    std::chrono::milliseconds const latency)
+    : BaseScheduledAction(scheduler, priority, latency),
+      action_(std::move(action)) {}
+
+template<typename Input>
+ScheduledAction<Input, void>::~ScheduledAction() {
+  // Make sure that the action doesn't run once the members of this class have
+  // been destroyed.
+  Stop();
+}
+
+template<typename Input>
+void ScheduledAction<Input, void>::Put(Input input) {
+  {
+    absl::MutexLock l(&input_lock_);
+    input_ = std::move(input);
+  }
+  Schedule();
+}
+
+template<typename Input>
+absl::Status ScheduledAction<Input, void>::RunAction() {
+  std::optional<Input> input;
+  {
+    absl::MutexLock l(&input_lock_);
+    if (!input_.has_value()) {
+      // The input was consumed by a previous execution.
+      return absl::OkStatus();
+    }
+    std::swap(input, input_);
+  }
+  RETURN_IF_STOPPED;
+
+  return action_(input.value());
+}
+
+}  // namespace internal
+}  // namespace _scheduler
+}  // namespace base
+}  // namespace principia
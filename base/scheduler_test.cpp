@@ -0,0 +1,284 @@
+#include "base/scheduler.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include "absl/synchronization/notification.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::ElementsAre;
+using namespace principia::base::_jthread;
+using namespace principia::base::_scheduler;
+using namespace std::chrono_literals;
+
+class SchedulerTest : public ::testing::Test {
+ protected:
+  using ToyScheduledAction1 = ScheduledAction<int>;
+  using ToyScheduledAction2 = ScheduledAction<int, double>;
+
+  static double PollingGet(ToyScheduledAction2& action) {
+    std::optional<double> output;
+    do {
+      output = action.Get();
+      std::this_thread::sleep_for(50us);
+    } while (!output.has_value());
+    return output.value();
+  }
+};
+
+TEST_F(SchedulerTest, Result) {
+  Scheduler scheduler(/*number_of_workers=*/2);
+  auto add_one_half = [](int const input) {
+    return static_cast<double>(input) + 0.5;
+  };
+
+  ToyScheduledAction2 action(
+      &scheduler, std::move(add_one_half), Scheduler::Priority::Visible, 1ms);
+  action.Start();
+
+  action.Put(3);
+  {
+    double const output = PollingGet(action);
+    EXPECT_EQ(3.5, output);
+  }
+
+  EXPECT_FALSE(action.Get().has_value());
+
+  action.Put(4);
+  {
+    double const output = PollingGet(action);
+    EXPECT_EQ(4.5, output);
+  }
+}
+
+TEST_F(SchedulerTest, NoResult) {
+  Scheduler scheduler(/*number_of_workers=*/1);
+  std::atomic<double> value = 0.0;
+
+  auto add_one_half = [&value](int const input) {
+    value = static_cast<double>(input) + 0.5;
+    return absl::OkStatus();
+  };
+
+  ToyScheduledAction1 action(
+      &scheduler, std::move(add_one_half), Scheduler::Priority::Visible, 1ms);
+  action.Start();
+
+  action.Put(3);
+  do {
+    std::this_thread::sleep_for(50us);
+  } while (value != 3.5);
+}
+
+// An input put before the action is started is processed once it starts, and
+// the inputs put while the action is stopped supersede each other.
+TEST_F(SchedulerTest, Coalescing) {
+  Scheduler scheduler(/*number_of_workers=*/1);
+  absl::Mutex lock;
+  std::vector<int> inputs;
+
+  auto record = [&lock, &inputs](int const input) {
+    absl::MutexLock l(&lock);
+    inputs.push_back(input);
+    return absl::OkStatus();
+  };
+
+  ToyScheduledAction1 action(
+      &scheduler, std::move(record), Scheduler::Priority::Visible, 1ms);
+  action.Put(1);
+  action.Put(2);
+  action.Put(3);
+  action.Start();
+  {
+    absl::MutexLock l(&lock);
+    lock.Await(absl::Condition(
+        +[](std::vector<int>* const inputs) { return !inputs->empty(); },
+        &inputs));
+    EXPECT_THAT(inputs, ElementsAre(3));
+  }
+}
+
+// With a single worker, the pending actions run by decreasing priority as long
+// as their deadlines are not reached.
+TEST_F(SchedulerTest, Priority) {
+  Scheduler scheduler(/*number_of_workers=*/1);
+  absl::Mutex lock;
+  std::vector<int> inputs;
+  absl::Notification blocker_started;
+  absl::Notification unblock;
+
+  auto block = [&blocker_started, &unblock](int const input) {
+    blocker_started.Notify();
+    unblock.WaitForNotification();
+    return absl::OkStatus();
+  };
+  auto record = [&lock, &inputs](int const input) {
+    absl::MutexLock l(&lock);
+    inputs.push_back(input);
+    return absl::OkStatus();
+  };
+
+  ToyScheduledAction1 blocker(
+      &scheduler, std::move(block), Scheduler::Priority::Urgent, 0ms);
+  ToyScheduledAction1 background(
+      &scheduler, record, Scheduler::Priority::Background, 1h);
+  ToyScheduledAction1 visible(
+      &scheduler, record, Scheduler::Priority::Visible, 1h);
+  ToyScheduledAction1 urgent(
+      &scheduler, record, Scheduler::Priority::Visible, 1h);
+  blocker.Start();
+  background.Start();
+  visible.Start();
+  urgent.Start();
+
+  // Occupy the worker while the other actions are queued.
+  blocker.Put(0);
+  blocker_started.WaitForNotification();
+  background.Put(3);
+  visible.Put(2);
+  urgent.Put(1);
+  urgent.set_priority(Scheduler::Priority::Urgent);
+  unblock.Notify();
+
+  {
+    absl::MutexLock l(&lock);
+    lock.Await(absl::Condition(
+        +[](std::vector<int>* const inputs) { return inputs->size() == 3; },
+        &inputs));
+    EXPECT_THAT(inputs, ElementsAre(1, 2, 3));
+  }
+}
+
+// An overdue action is promoted by one priority level only: an overdue visible
+// action runs before an urgent one, but an overdue background action doesn't.
+TEST_F(SchedulerTest, Overdue) {
+  Scheduler scheduler(/*number_of_workers=*/1);
+  absl::Mutex lock;
+  std::vector<int> inputs;
+  absl::Notification blocker_started;
+  absl::Notification unblock;
+
+  auto block = [&blocker_started, &unblock](int const input) {
+    blocker_started.Notify();
+    unblock.WaitForNotification();
+    return absl::OkStatus();
+  };
+  auto record = [&lock, &inputs](int const input) {
+    absl::MutexLock l(&lock);
+    inputs.push_back(input);
+    return absl::OkStatus();
+  };
+
+  ToyScheduledAction1 blocker(
+      &scheduler, std::move(block), Scheduler::Priority::Urgent, 0ms);
+  ToyScheduledAction1 background(
+      &scheduler, record, Scheduler::Priority::Background, 0ms);
+  ToyScheduledAction1 visible(
+      &scheduler, record, Scheduler::Priority::Visible, 1ms);
+  ToyScheduledAction1 urgent(
+      &scheduler, record, Scheduler::Priority::Urgent, 1h);
+  blocker.Start();
+  background.Start();
+  visible.Start();
+  urgent.Start();
+
+  // Occupy the worker until the background and visible actions are overdue.
+  blocker.Put(0);
+  blocker_started.WaitForNotification();
+  background.Put(3);
+  visible.Put(2);
+  urgent.Put(1);
+  std::this_thread::sleep_for(10ms);
+  unblock.Notify();
+
+  {
+    absl::MutexLock l(&lock);
+    lock.Await(absl::Condition(
+        +[](std::vector<int>* const inputs) { return inputs->size() == 3; },
+        &inputs));
+    EXPECT_THAT(inputs, ElementsAre(2, 1, 3));
+  }
+}
+
+// Background actions don't occupy all the workers, so an urgent action runs
+// even if background actions are blocked.
+TEST_F(SchedulerTest, ReservedWorker) {
+  Scheduler scheduler(/*number_of_workers=*/2);
+  absl::Notification blocker_started;
+  absl::Notification unblock;
+  absl::Notification urgent_done;
+  std::atomic<bool> background_ran = false;
+
+  auto block = [&blocker_started, &unblock](int const input) {
+    blocker_started.Notify();
+    unblock.WaitForNotification();
+    return absl::OkStatus();
+  };
+
+  ToyScheduledAction1 blocker(
+      &scheduler, std::move(block), Scheduler::Priority::Background, 0ms);
+  ToyScheduledAction1 background(
+      &scheduler,
+      [&background_ran](int const input) {
+        background_ran = true;
+        return absl::OkStatus();
+      },
+      Scheduler::Priority::Background,
+      0ms);
+  ToyScheduledAction1 urgent(
+      &scheduler,
+      [&urgent_done](int const input) {
+        urgent_done.Notify();
+        return absl::OkStatus();
+      },
+      Scheduler::Priority::Urgent,
+      1h);
+  blocker.Start();
+  background.Start();
+  urgent.Start();
+
+  blocker.Put(0);
+  blocker_started.WaitForNotification();
+  background.Put(1);
+  urgent.Put(2);
+  urgent_done.WaitForNotification();
+  // The second worker is reserved for non-background actions.
+  std::this_thread::sleep_for(10ms);
+  EXPECT_FALSE(background_ran);
+  unblock.Notify();
+
+  while (!background_ran) {
+    std::this_thread::sleep_for(50us);
+  }
+}
+
+// Stopping an action cancels its execution and waits for it to return.
+TEST_F(SchedulerTest, Stop) {
+  Scheduler scheduler(/*number_of_workers=*/1);
+  absl::Notification started;
+  std::atomic<bool> cancelled = false;
+
+  auto wait_for_stop = [&started, &cancelled](int const input) {
+    started.Notify();
+    while (!this_stoppable_thread::get_stop_token().stop_requested()) {
+      std::this_thread::sleep_for(50us);
+    }
+    cancelled = true;
+    return absl::CancelledError();
+  };
+
+  ToyScheduledAction1 action(
+      &scheduler, std::move(wait_for_stop), Scheduler::Priority::Visible, 1ms);
+  action.Start();
+  action.Put(1);
+  started.WaitForNotification();
+  action.Stop();
+  EXPECT_TRUE(cancelled);
+}
+
+}  // namespace base
+}  // namespace principia
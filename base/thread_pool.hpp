@@ -1,10 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <future>
 #include <list>
+#include <memory>
+#include <optional>
 #include <thread>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
@@ -16,6 +21,10 @@ namespace internal {
 
 // A pool of threads that are created at construction and to which functions can
 // be added for asynchronous execution.  This class is thread-safe.
+// Each thread has its own queue of calls, protected by its own lock, so that
+// adding many short calls doesn't serialize all the threads on a single lock.
+// A thread whose queue is empty steals calls from the queues of the other
+// threads.
 template<typename T>
 class ThreadPool final {
  public:
@@ -26,7 +35,10 @@ class ThreadPool final {
 
   // Adds a call to the execution queue, and returns a future that the client
   // may use to wait until execution of |function| has completed and to extract
-  // the result.
+  // the result.  If called from one of the threads of this pool, the call is
+  // added to the queue of that thread, otherwise the queues are filled in a
+  // round-robin manner.  The calls added from outside the pool are executed in
+  // the order in which they were added to a given queue.
   std::future<T> Add(std::function<T()> function);
 
  private:
@@ -37,15 +49,55 @@ class ThreadPool final {
     std::promise<T> promise;
   };
 
-  // The loop executed on each thread to extract an element from the queue,
+  // The calls to be executed by one thread.  The calls added by the owning
+  // thread are in |local_calls|: the owning thread takes them from the back,
+  // the other threads steal them from the front.  The calls added from outside
+  // the pool are in |injected_calls| and are always taken from the front, so
+  // that they are executed first-in, first-out.
+  struct Queue {
+    absl::Mutex lock;
+    std::deque<Call> local_calls GUARDED_BY(lock);
+    std::deque<Call> injected_calls GUARDED_BY(lock);
+  };
+
+  // Returns a call from the queue of the thread with index |index| if there is
+  // one, otherwise a call stolen from the queue of another thread.  Returns
+  // nullopt if all the queues are empty.  The local calls of a queue are
+  // preferred over its injected calls.
+  std::optional<Call> TakeCall(std::int64_t index);
+
+  // The loop executed on each thread to extract an element from the queues,
   // execute it, and set its result in the promise.
-  void DequeueCallAndExecute();
+  void DequeueCallAndExecute(std::int64_t index);
+
+  // The queues, indexed by thread.  Never empty.
+  std::vector<std::unique_ptr<Queue>> queues_;
 
+  // The total number of calls in |queues_|.  Incremented after a call has been
+  // inserted in a queue and decremented after a call has been removed.  May
+  // transiently be smaller than the actual number of calls (or even negative,
+  // if a call is taken before its insertion has been counted); this is benign
+  // because |Add| wakes the sleeping threads after the increment.
+  std::atomic<std::int64_t> number_of_calls_ = 0;
+
+  // The number of threads that are, or are about to be, waiting on |lock_|.
+  std::atomic<std::int64_t> number_of_sleepers_ = 0;
+
+  // The index of the queue to which the next call from outside the pool will be
+  // added.
+  std::atomic<std::uint64_t> next_queue_ = 0;
+
+  // Used to put idle threads to sleep.  |shutdown_| is atomic so that busy
+  // threads may check it without locking.
   absl::Mutex lock_;
-  bool shutdown_ GUARDED_BY(lock_) = false;
-  std::deque<Call> calls_ GUARDED_BY(lock_);
+  std::atomic<bool> shutdown_ = false;
 
   std::list<std::thread> threads_;
+
+  // The pool and the index of the queue owned by the current thread, if it is
+  // a thread of a pool.
+  inline static thread_local ThreadPool const* current_pool_ = nullptr;
+  inline static thread_local std::int64_t current_index_ = -1;
 };
 
 }  // namespace internal
@@ -2,6 +2,9 @@
 
 #include "base/thread_pool.hpp"
 
+#include <algorithm>
+#include <utility>
+
 namespace principia {
 namespace base {
 namespace _thread_pool {
@@ -24,8 +27,13 @@ inline void ExecuteAndSetValue<void>(std::function<void()> const& function,
 
 template<typename T>
 ThreadPool<T>::ThreadPool(std::int64_t const pool_size) {
+  // Even a pool without threads needs a queue to accept calls.
+  for (std::int64_t i = 0; i < std::max<std::int64_t>(pool_size, 1); ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
   for (std::int64_t i = 0; i < pool_size; ++i) {
-    threads_.emplace_back(std::bind(&ThreadPool::DequeueCallAndExecute, this));
+    threads_.emplace_back(
+        std::bind(&ThreadPool::DequeueCallAndExecute, this, i));
   }
 }
 
@@ -42,40 +50,89 @@ ThreadPool<T>::~ThreadPool() {
 
 template<typename T>
 std::future<T> ThreadPool<T>::Add(std::function<T()> function) {
+  bool const is_local = current_pool_ == this;
+  std::int64_t const index =
+      is_local ? current_index_
+               : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                     queues_.size();
   std::future<T> result;
   {
+    auto& queue = *queues_[index];
+    absl::MutexLock l(&queue.lock);
+    auto& calls = is_local ? queue.local_calls : queue.injected_calls;
+    calls.push_back({std::move(function), std::promise<T>()});
+    result = calls.back().promise.get_future();
+  }
+
+  // The sequential consistency of the atomics ensures that either a thread
+  // going to sleep sees the new call, or we see that thread.  In the latter
+  // case, releasing |lock_| causes the sleeping threads to reevaluate their
+  // condition.
+  ++number_of_calls_;
+  if (number_of_sleepers_ > 0) {
     absl::MutexLock l(&lock_);
-    calls_.push_back({std::move(function), std::promise<T>()});
-    result = calls_.back().promise.get_future();
   }
   return result;
 }
 
 template<typename T>
-void ThreadPool<T>::DequeueCallAndExecute() {
-  for (;;) {
-    Call this_call;
+std::optional<typename ThreadPool<T>::Call> ThreadPool<T>::TakeCall(
+    std::int64_t const index) {
+  {
+    auto& queue = *queues_[index];
+    absl::MutexLock l(&queue.lock);
+    if (!queue.local_calls.empty()) {
+      std::optional<Call> call = std::move(queue.local_calls.back());
+      queue.local_calls.pop_back();
+      --number_of_calls_;
+      return call;
+    }
+    if (!queue.injected_calls.empty()) {
+      std::optional<Call> call = std::move(queue.injected_calls.front());
+      queue.injected_calls.pop_front();
+      --number_of_calls_;
+      return call;
+    }
+  }
+  for (std::int64_t i = 1; i < queues_.size(); ++i) {
+    auto& queue = *queues_[(index + i) % queues_.size()];
+    absl::MutexLock l(&queue.lock);
+    for (auto* const calls : {&queue.injected_calls, &queue.local_calls}) {
+      if (!calls->empty()) {
+        std::optional<Call> call = std::move(calls->front());
+        calls->pop_front();
+        --number_of_calls_;
+        return call;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+template<typename T>
+void ThreadPool<T>::DequeueCallAndExecute(std::int64_t const index) {
+  current_pool_ = this;
+  current_index_ = index;
+  while (!shutdown_) {
+    // Execute the function without holding any lock as it might take some
+    // time.
+    if (std::optional<Call> this_call = TakeCall(index);
+        this_call.has_value()) {
+      ExecuteAndSetValue(this_call->function, this_call->promise);
+      continue;
+    }
 
-    // Wait until either the queue contains an element or this class is shutting
-    // down.
+    // Wait until either some queue contains an element or this class is
+    // shutting down.
+    ++number_of_sleepers_;
     {
       absl::MutexLock l(&lock_);
-
       auto const has_calls_or_shutdown = [this] {
-        return shutdown_ || !calls_.empty();
+        return shutdown_ || number_of_calls_ > 0;
       };
       lock_.Await(absl::Condition(&has_calls_or_shutdown));
-
-      if (shutdown_) {
-        break;
-      }
-      this_call = std::move(calls_.front());
-      calls_.pop_front();
     }
-
-    // Execute the function without holding the |lock_| as it might take some
-    // time.
-    ExecuteAndSetValue(this_call.function, this_call.promise);
+    --number_of_sleepers_;
   }
 }
 
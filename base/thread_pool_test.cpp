@@ -1,8 +1,11 @@
 #include "base/thread_pool.hpp"
 
+#include <set>
 #include <vector>
 
 #include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
 #include "glog/logging.h"
 #include "gmock/gmock.h"
 
@@ -52,5 +55,61 @@ TEST_F(ThreadPoolTest, ParallelExecution) {
   EXPECT_FALSE(monotonically_increasing);
 }
 
+// Check that calls added by a thread of the pool to its own queue are stolen by
+// the other threads.
+TEST_F(ThreadPoolTest, WorkStealing) {
+  constexpr int number_of_calls = 1000;
+  ThreadPool<void> pool(/*pool_size=*/4);
+
+  absl::Mutex lock;
+  std::set<std::thread::id> thread_ids;
+  std::vector<std::future<void>> futures;
+  pool.Add([&futures, &lock, &pool, &thread_ids]() {
+    for (int i = 0; i < number_of_calls; ++i) {
+      futures.push_back(pool.Add([&lock, &thread_ids]() {
+        // Make the calls long enough for the other threads to get a chance to
+        // steal some.
+        absl::SleepFor(absl::Microseconds(100));
+        absl::MutexLock l(&lock);
+        thread_ids.insert(std::this_thread::get_id());
+      }));
+    }
+  }).wait();
+
+  for (auto const& future : futures) {
+    future.wait();
+  }
+
+  EXPECT_LT(1, thread_ids.size());
+}
+
+// Check that calls added from outside the pool are executed in the order in
+// which they were added.
+TEST_F(ThreadPoolTest, FirstInFirstOut) {
+  constexpr int number_of_calls = 1000;
+  ThreadPool<void> pool(/*pool_size=*/1);
+
+  // Block the thread of the pool so that all the calls are queued before any of
+  // them is executed.
+  absl::Notification start;
+  std::vector<std::future<void>> futures;
+  futures.push_back(pool.Add([&start]() { start.WaitForNotification(); }));
+
+  std::vector<int> numbers;
+  for (int i = 0; i < number_of_calls; ++i) {
+    futures.push_back(pool.Add([i, &numbers]() { numbers.push_back(i); }));
+  }
+  start.Notify();
+
+  for (auto const& future : futures) {
+    future.wait();
+  }
+
+  ASSERT_EQ(number_of_calls, numbers.size());
+  for (int i = 0; i < number_of_calls; ++i) {
+    EXPECT_EQ(i, numbers[i]);
+  }
+}
+
 }  // namespace base
 }  // namespace principia
@@ -2,6 +2,7 @@
 
 #include "physics/checkpointer.hpp"
 
+#include <cstdint>
 #include <memory>
 
 #include "absl/status/status.h"
@@ -137,6 +138,48 @@ void BM_CheckpointerAllCheckpointsBetween(benchmark::State& state) {
   }
 }
 
+// Writes |state.range(0)| checkpoints with contents that vary slowly, as is
+// the case for an ephemeris, storing one keyframe every |state.range(1)|
+// checkpoints.  Reports the size of the serialized checkpoints.
+void BM_CheckpointerWriteToCheckpoint(benchmark::State& state) {
+  int const size = state.range(0);
+  int const keyframe_interval = state.range(1);
+  int i = 0;
+  auto const writer = [&i](not_null<Ephemeris::Checkpoint*> const checkpoint) {
+    State* const state =
+        checkpoint->mutable_instance()->mutable_current_state();
+    state->mutable_time()->mutable_value()->mutable_point()->mutable_scalar()
+        ->set_magnitude(i);
+    for (int b = 0; b < 20; ++b) {
+      for (auto* const position : {state->add_position(),
+                                   state->add_velocity()}) {
+        R3Element* const raw = position->mutable_value()
+                                   ->mutable_point()
+                                   ->mutable_multivector()
+                                   ->mutable_vector();
+        raw->mutable_x()->mutable_quantity()->set_magnitude(1e9 * b + i);
+        raw->mutable_y()->mutable_quantity()->set_magnitude(1e9 * b - i);
+        raw->mutable_z()->mutable_quantity()->set_magnitude(1e6 * b);
+      }
+    }
+  };
+
+  std::int64_t bytes = 0;
+  for (auto _ : state) {
+    Checkpointer<Ephemeris> checkpointer(
+        writer, &ReadFromCheckpoint, keyframe_interval);
+    for (i = 0; i < size; ++i) {
+      checkpointer.WriteToCheckpoint(Instant() + i * Second);
+    }
+    state.PauseTiming();
+    Ephemeris message;
+    checkpointer.WriteToMessage(message.mutable_checkpoint());
+    bytes = message.ByteSizeLong();
+    state.ResumeTiming();
+  }
+  state.counters["bytes_per_checkpoint"] = static_cast<double>(bytes) / size;
+}
+
 BENCHMARK(BM_CheckpointerOldestCheckpoint)->Range(1, 512);
 BENCHMARK(BM_CheckpointerNewestCheckpoint)->Range(1, 512);
 BENCHMARK(BM_CheckpointerCheckpointAtOrAfter)->Range(1, 512);
@@ -144,6 +187,8 @@ BENCHMARK(BM_CheckpointerCheckpointAtOrBefore)->Range(1, 512);
 BENCHMARK(BM_CheckpointerAllCheckpoints)->Range(1, 512);
 BENCHMARK(BM_CheckpointerAllCheckpointsAtOrBefore)->Range(1, 512);
 BENCHMARK(BM_CheckpointerAllCheckpointsBetween)->Range(1, 512);
+BENCHMARK(BM_CheckpointerWriteToCheckpoint)
+    ->ArgsProduct({{512}, {1, 4, 16}});
 
 }  // namespace physics
 }  // namespace principia
@@ -1,14 +1,141 @@
 // .\Release\x64\benchmarks.exe --benchmark_min_time=2 --benchmark_repetitions=10 --benchmark_filter=Base32768  // NOLINT(whitespace/line_length)
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=10 --benchmark_filter=Compress  // NOLINT(whitespace/line_length)
 
 #include "base/encoder.hpp"
 
+#include <cstdint>
+#include <memory>
 #include <random>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "base/array.hpp"
 #include "base/base64.hpp"
 #include "base/base32768.hpp"
+#include "base/compressor_registry.hpp"
 #include "base/hexadecimal.hpp"
 #include "benchmark/benchmark.h"
+#include "testing_utilities/serialization.hpp"
+
+namespace principia {
+namespace base {
+
+using namespace principia::base::_array;
+using namespace principia::base::_base64;
+using namespace principia::base::_compressor_registry;
+using namespace principia::base::_encoder;
+using namespace principia::base::_hexadecimal;
+using namespace principia::testing_utilities::_serialization;
+
+using PluginEncoder = Encoder<char, /*null_terminated=*/false>;
+
+Array<std::uint8_t const> AsBytes(std::string const& s) {
+  return Array<std::uint8_t const>(
+      reinterpret_cast<std::uint8_t const*>(s.data()), s.size());
+}
+
+// Compresses and encodes a real serialized |Plugin|, as is done when saving a
+// game.  The counter |ratio| is the size of the compressed and encoded data
+// divided by the size of the serialized plugin.
+void BM_CompressAndEncodePlugin(benchmark::State& state,
+                                PluginEncoder& encoder,
+                                std::string_view const compressor_name) {
+  std::vector<std::uint8_t> const serialized_plugin = ReadFromBinaryFile(
+      SOLUTION_DIR / "ksp_plugin_test" / "simple_plugin.proto.bin");
+  std::string const uncompressed(serialized_plugin.begin(),
+                                 serialized_plugin.end());
+  std::unique_ptr<google::compression::Compressor> const compressor =
+      NewCompressor(compressor_name);
+
+  std::int64_t bytes_processed = 0;
+  std::int64_t encoded_size = 0;
+  std::string compressed;
+  for (auto _ : state) {
+    Array<std::uint8_t const> binary = AsBytes(uncompressed);
+    if (compressor != nullptr) {
+      compressed.clear();
+      compressor->Compress(uncompressed, &compressed);
+      binary = AsBytes(compressed);
+    }
+    UniqueArray<char> const encoded = encoder.Encode(binary);
+    benchmark::DoNotOptimize(encoded);
+    bytes_processed += uncompressed.size();
+    encoded_size = encoded.size;
+  }
+  state.SetBytesProcessed(bytes_processed);
+  state.counters["ratio"] =
+      static_cast<double>(encoded_size) / uncompressed.size();
+}
+
+// The inverse of |BM_CompressAndEncodePlugin|, as is done when loading a game.
+void BM_DecodeAndDecompressPlugin(benchmark::State& state,
+                                  PluginEncoder& encoder,
+                                  std::string_view const compressor_name) {
+  std::vector<std::uint8_t> const serialized_plugin = ReadFromBinaryFile(
+      SOLUTION_DIR / "ksp_plugin_test" / "simple_plugin.proto.bin");
+  std::string const uncompressed(serialized_plugin.begin(),
+                                 serialized_plugin.end());
+  std::unique_ptr<google::compression::Compressor> const compressor =
+      NewCompressor(compressor_name);
+
+  std::string compressed = uncompressed;
+  if (compressor != nullptr) {
+    compressed.clear();
+    compressor->Compress(uncompressed, &compressed);
+  }
+  UniqueArray<char> const encoded = encoder.Encode(AsBytes(compressed));
+
+  std::int64_t bytes_processed = 0;
+  std::string decompressed;
+  for (auto _ : state) {
+    UniqueArray<std::uint8_t> const binary = encoder.Decode(encoded.get());
+    if (compressor != nullptr) {
+      decompressed.clear();
+      CHECK(compressor->Uncompress(
+          std::string(reinterpret_cast<char const*>(binary.data.get()),
+                      binary.size),
+          &decompressed));
+      benchmark::DoNotOptimize(decompressed);
+    }
+    benchmark::DoNotOptimize(binary);
+    bytes_processed += uncompressed.size();
+  }
+  state.SetBytesProcessed(bytes_processed);
+}
+
+HexadecimalEncoder</*null_terminated=*/false> hexadecimal_encoder;
+Base64Encoder</*null_terminated=*/false> base64_encoder;
+
+// Registers the benchmarks for each encoder and each registered compressor,
+// including no compression at all.
+bool const compress_and_decode_benchmarks_registered = []() {
+  std::vector<std::string> compressor_names = RegisteredCompressors();
+  compressor_names.insert(compressor_names.begin(), "");
+  for (auto const& [encoder_name, encoder] :
+       {std::pair<std::string, PluginEncoder*>{"Hexadecimal",
+                                               &hexadecimal_encoder},
+        std::pair<std::string, PluginEncoder*>{"Base64", &base64_encoder}}) {
+    for (std::string const& compressor_name : compressor_names) {
+      std::string const suffix =
+          encoder_name + (compressor_name.empty() ? "" : "/" + compressor_name);
+      benchmark::RegisterBenchmark(
+          ("BM_CompressAndEncodePlugin/" + suffix).c_str(),
+          [encoder, compressor_name](benchmark::State& state) {
+            BM_CompressAndEncodePlugin(state, *encoder, compressor_name);
+          });
+      benchmark::RegisterBenchmark(
+          ("BM_DecodeAndDecompressPlugin/" + suffix).c_str(),
+          [encoder, compressor_name](benchmark::State& state) {
+            BM_DecodeAndDecompressPlugin(state, *encoder, compressor_name);
+          });
+    }
+  }
+  return true;
+}();
+
+}  // namespace base
+}  // namespace principia
 
 // Clang doesn't have a correct |std::array| yet, and we don't actually use this
 // code, so let's get rid of the entire body.
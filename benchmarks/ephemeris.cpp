@@ -27,7 +27,9 @@
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
+#include "physics/massive_body.hpp"
 #include "physics/massless_body.hpp"
+#include "physics/point_mass_accelerations.hpp"
 #include "quantities/astronomy.hpp"
 #include "quantities/bipm.hpp"
 #include "quantities/elementary_functions.hpp"
@@ -60,7 +62,9 @@ using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_kepler_orbit;
+using namespace principia::physics::_massive_body;
 using namespace principia::physics::_massless_body;
+using namespace principia::physics::_point_mass_accelerations;
 using namespace principia::physics::_solar_system;
 using namespace principia::quantities::_astronomy;
 using namespace principia::quantities::_bipm;
@@ -166,6 +170,73 @@ void BM_EphemerisSolarSystem(benchmark::State& state) {
                  Norm();
     state.ResumeTiming();
   }
+  std::string const instruction_set = UseAVX512 ? "AVX-512"
+                                      : UseAVX  ? "AVX"
+                                                : "scalar";
+  state.SetLabel(quantities::DebugString(error / AstronomicalUnit) + " ua, " +
+                 instruction_set);
+}
+
+// Integrates a system made of the Sun and |state.range(0)| massive asteroids
+// on circular orbits in the main belt.  The mutual accelerations of the
+// asteroids are computed concurrently if there are at least |state.range(1)|
+// of them, and are approximated with an opening angle of |state.range(2)|
+// hundredths if it is positive.
+void BM_EphemerisManyMassiveBodies(benchmark::State& state) {
+  int const number_of_asteroids = state.range(0);
+  int const concurrency_threshold = state.range(1);
+  double const opening_angle = state.range(2) / 100.0;
+  GravitationalParameter const asteroid_μ = 1e-12 * SolarGravitationalParameter;
+
+  Length error;
+  for (auto _ : state) {
+    state.PauseTiming();
+
+    std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+    std::vector<DegreesOfFreedom<Barycentric>> initial_state;
+    bodies.push_back(make_not_null_unique<MassiveBody>(
+        MassiveBody::Parameters(SolarGravitationalParameter)));
+    initial_state.emplace_back(Barycentric::origin, Barycentric::unmoving);
+    for (int i = 0; i < number_of_asteroids; ++i) {
+      // Spread the asteroids using the golden angle, at radii between 2.2 and
+      // 3.2 ua.
+      Angle const θ = i * π * (3 - std::sqrt(5.0)) * Radian;
+      Length const r =
+          (2.2 + static_cast<double>(i) / number_of_asteroids) *
+          AstronomicalUnit;
+      Speed const v = Sqrt(SolarGravitationalParameter / r);
+      bodies.push_back(
+          make_not_null_unique<MassiveBody>(MassiveBody::Parameters(asteroid_μ)));
+      initial_state.emplace_back(
+          Barycentric::origin +
+              Displacement<Barycentric>({r * Cos(θ), r * Sin(θ), 0 * Metre}),
+          Velocity<Barycentric>({-v * Sin(θ), v * Cos(θ), 0 * Metre / Second}));
+    }
+    Instant const t0;
+    Instant const final_time = t0 + JulianYear;
+    Ephemeris<Barycentric> ephemeris(
+        std::move(bodies),
+        initial_state,
+        t0,
+        Ephemeris<Barycentric>::AccuracyParameters(
+            FittingTolerance(-3),
+            /*geopotential_tolerance=*/0x1p-24,
+            opening_angle),
+        Ephemeris<Barycentric>::FixedStepParameters(
+            SymmetricLinearMultistepIntegrator<
+                QuinlanTremaine1990Order12,
+                Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+            /*step=*/1 * Day));
+    ephemeris.SetConcurrencyThreshold(concurrency_threshold);
+
+    state.ResumeTiming();
+    CHECK_OK(ephemeris.Prolong(final_time));
+    state.PauseTiming();
+    error = (ephemeris.trajectory(ephemeris.bodies().back())
+                 ->EvaluatePosition(final_time) -
+             Barycentric::origin).Norm();
+    state.ResumeTiming();
+  }
   state.SetLabel(quantities::DebugString(error / AstronomicalUnit) + " ua");
 }
 
@@ -238,6 +309,74 @@ void BM_EphemerisLEOProbe(benchmark::State& state) {
                  " nmi");
 }
 
+// Integrates |state.range(1)| probes in low earth orbit together, to measure
+// the benefit of computing the accelerations on many massless bodies at once.
+template<SolarSystemFactory::Accuracy accuracy>
+void BM_EphemerisLEOProbes(benchmark::State& state) {
+  std::int64_t const number_of_probes = state.range(1);
+
+  auto const at_спутник_1_launch = SolarSystemAtСпутник1Launch(accuracy);
+  Instant const final_time = at_спутник_1_launch->epoch() + 1 * Day;
+
+  auto const ephemeris =
+      at_спутник_1_launch->MakeEphemeris(
+          SolarSystemFactory::MakeAccuracyParameters<Barycentric>(
+              FittingTolerance(state.range(0)),
+              accuracy),
+          EphemerisParameters());
+
+  CHECK_OK(ephemeris->Prolong(final_time));
+
+  DegreesOfFreedom<Barycentric> const earth_degrees_of_freedom =
+      at_спутник_1_launch->degrees_of_freedom(
+          SolarSystemFactory::name(SolarSystemFactory::Earth));
+  GravitationalParameter const earth_μ =
+      at_спутник_1_launch->gravitational_parameter(
+          SolarSystemFactory::name(SolarSystemFactory::Earth));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    // Probes on circular equatorial orbits with various altitudes and phases.
+    std::vector<DiscreteTrajectory<Barycentric>> trajectories(
+        number_of_probes);
+    std::vector<not_null<DiscreteTrajectory<Barycentric>*>> pointers;
+    for (std::int64_t i = 0; i < number_of_probes; ++i) {
+      Length const r = 6371 * Kilo(Metre) + (100 + i) * NauticalMile;
+      Angle const θ = 2 * π * i / number_of_probes * Radian;
+      Displacement<Barycentric> const earth_probe_displacement(
+          {r * Cos(θ), r * Sin(θ), 0 * Metre});
+      Speed const earth_probe_speed = Sqrt(earth_μ / r);
+      Velocity<Barycentric> const earth_probe_velocity(
+          {-earth_probe_speed * Sin(θ),
+           earth_probe_speed * Cos(θ),
+           0 * Metre / Second});
+      CHECK_OK(trajectories[i].Append(
+          at_спутник_1_launch->epoch(),
+          DegreesOfFreedom<Barycentric>(
+              earth_degrees_of_freedom.position() + earth_probe_displacement,
+              earth_degrees_of_freedom.velocity() + earth_probe_velocity)));
+      pointers.push_back(&trajectories[i]);
+    }
+    auto const instance = ephemeris->NewInstance(
+        pointers,
+        Ephemeris<Barycentric>::NoIntrinsicAccelerations,
+        Ephemeris<Barycentric>::FixedStepParameters(
+            SymmetricLinearMultistepIntegrator<
+                Quinlan1999Order8A,
+                Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+            /*step=*/10 * Second));
+
+    state.ResumeTiming();
+    CHECK_OK(ephemeris->FlowWithFixedStep(final_time, *instance));
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_probes);
+  std::string const instruction_set = UseAVX512 ? "AVX-512"
+                                      : UseAVX  ? "AVX"
+                                                : "scalar";
+  state.SetLabel(std::to_string(number_of_probes) + " probes, " +
+                 instruction_set);
+}
+
 template<SolarSystemFactory::Accuracy accuracy, Flow* flow>
 void BM_EphemerisTranslunarSpaceProbe(benchmark::State& state) {
   Length sun_error;
@@ -387,6 +526,78 @@ void BM_EphemerisMultithreadingBenchmark(benchmark::State& state) {
   state.SetLabel(ss.str());
 }
 
+// Integrates |state.range(0)| probes in lockstep on a pool of
+// |state.range(1)| threads, and reports how often the probes share the
+// evaluation of the body positions.
+void BM_EphemerisConcurrentProbes(benchmark::State& state) {
+  auto const at_спутник_1_launch =
+      SolarSystemAtСпутник1Launch(
+          SolarSystemFactory::Accuracy::AllBodiesAndDampedOblateness);
+  Instant const epoch = at_спутник_1_launch->epoch();
+  auto const ephemeris =
+      at_спутник_1_launch->MakeEphemeris(
+          /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
+                                   /*geopotential_tolerance=*/0x1p-24},
+          EphemerisParameters());
+  std::string const& earth_name =
+      SolarSystemFactory::name(SolarSystemFactory::Earth);
+  auto const earth_massive_body =
+      at_спутник_1_launch->massive_body(*ephemeris, earth_name);
+  auto const earth_degrees_of_freedom =
+      at_спутник_1_launch->degrees_of_freedom(earth_name);
+
+  MasslessBody probe;
+  std::list<DiscreteTrajectory<Barycentric>> trajectories;
+  std::vector<not_null<std::unique_ptr<Integrator<Ephemeris<
+      Barycentric>::NewtonianMotionEquation>::Instance>>>
+      instances;
+  for (int i = 0; i < state.range(0); ++i) {
+    KeplerianElements<Barycentric> elements;
+    elements.eccentricity = 0;
+    elements.semimajor_axis = 7'000 * Kilo(Metre) + i * 100 * Kilo(Metre);
+    elements.inclination = 0 * Radian;
+    elements.longitude_of_ascending_node = 0 * Radian;
+    elements.argument_of_periapsis = 0 * Radian;
+    elements.true_anomaly = i * Radian;
+    KeplerOrbit<Barycentric> const orbit(
+        *earth_massive_body, probe, elements, epoch);
+    trajectories.emplace_back();
+    auto& trajectory = trajectories.back();
+    CHECK_OK(trajectory.Append(
+        epoch, earth_degrees_of_freedom + orbit.StateVectors(epoch)));
+    instances.push_back(ephemeris->NewInstance(
+        {&trajectory},
+        Ephemeris<Barycentric>::NoIntrinsicAccelerations,
+        Ephemeris<Barycentric>::FixedStepParameters(
+            SymmetricLinearMultistepIntegrator<
+                Quinlan1999Order8A,
+                Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+            /*step=*/10 * Second)));
+  }
+
+  ThreadPool<void> pool(/*pool_size=*/state.range(1));
+  auto const initial_statistics = ephemeris->body_positions_cache_statistics();
+  Instant final_time = epoch;
+  for (auto _ : state) {
+    final_time += 10 * Minute;
+    std::vector<std::future<void>> futures;
+    for (auto& instance : instances) {
+      futures.push_back(pool.Add([&ephemeris, &instance, final_time]() {
+        CHECK_OK(ephemeris->FlowWithFixedStep(final_time, *instance));
+      }));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+  }
+
+  auto const statistics = ephemeris->body_positions_cache_statistics();
+  double const hits = statistics.hits - initial_statistics.hits;
+  double const misses = statistics.misses - initial_statistics.misses;
+  state.counters["hit_rate"] = hits / (hits + misses);
+  state.counters["misses_per_probe"] = misses / state.range(0);
+}
+
 template<SolarSystemFactory::Accuracy accuracy, Flow* flow>
 void EphemerisL4ProbeBenchmark(Time const integration_duration,
                                benchmark::State& state) {
@@ -578,6 +789,12 @@ BENCHMARK(BM_EphemerisMultithreadingBenchmark)
     ->ArgPair(3, 4)
     ->ArgPair(3, 5)
     ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_EphemerisConcurrentProbes)
+    ->ArgPair(128, 1)
+    ->ArgPair(128, 4)
+    ->ArgPair(128, 8)
+    ->ArgPair(512, 8)
+    ->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_EphemerisKSPSystem)->Arg(-3)->Unit(benchmark::kSecond);
 BENCHMARK_TEMPLATE(BM_EphemerisSolarSystem,
                    SolarSystemFactory::Accuracy::MajorBodiesOnly)
@@ -591,6 +808,14 @@ BENCHMARK_TEMPLATE(BM_EphemerisSolarSystem,
                    SolarSystemFactory::Accuracy::AllBodiesAndDampedOblateness)
     ->Arg(-3)
     ->Unit(benchmark::kSecond);
+BENCHMARK(BM_EphemerisManyMassiveBodies)
+    ->ArgsProduct({{16, 64, 256, 1024},
+                   {std::numeric_limits<int>::max(), 0},
+                   {0}})
+    ->ArgsProduct({{256, 1024, 4096},
+                   {std::numeric_limits<int>::max()},
+                   {30, 50}})
+    ->Unit(benchmark::kMillisecond);
 BENCHMARK_TEMPLATE(BM_EphemerisL4Probe,
                    SolarSystemFactory::Accuracy::MajorBodiesOnly,
                    &FlowEphemerisWithAdaptiveStep)
@@ -651,6 +876,14 @@ BENCHMARK_TEMPLATE(BM_EphemerisLEOProbe,
                    &FlowEphemerisWithFixedStepSRKN)
     ->Arg(-3)
     ->Unit(benchmark::kSecond);
+BENCHMARK_TEMPLATE(BM_EphemerisLEOProbes,
+                   SolarSystemFactory::Accuracy::MajorBodiesOnly)
+    ->ArgsProduct({{-3}, {1, 4, 16, 64, 256}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_EphemerisLEOProbes,
+                   SolarSystemFactory::Accuracy::AllBodiesAndDampedOblateness)
+    ->ArgsProduct({{-3}, {1, 4, 16, 64, 256}})
+    ->Unit(benchmark::kMillisecond);
 BENCHMARK_TEMPLATE(BM_EphemerisTranslunarSpaceProbe,
                    SolarSystemFactory::Accuracy::MajorBodiesOnly,
                    &FlowEphemerisWithFixedStepSLMS)
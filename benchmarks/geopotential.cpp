@@ -2,22 +2,35 @@
 
 #include "physics/geopotential_body.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
 #include <random>
 #include <vector>
 
 #include "astronomy/fortran_astrodynamics_toolkit.hpp"
 #include "astronomy/frames.hpp"
 #include "base/not_null.hpp"
+#include "base/status_utilities.hpp"
 #include "benchmark/benchmark.h"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/r3_element.hpp"
 #include "geometry/space.hpp"
+#include "integrators/embedded_explicit_runge_kutta_nyström_integrator.hpp"
+#include "integrators/methods.hpp"
+#include "integrators/symmetric_linear_multistep_integrator.hpp"
 #include "numerics/fixed_arrays.hpp"
 #include "numerics/legendre.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/ephemeris.hpp"
+#include "physics/geopotential_grid.hpp"
 #include "physics/solar_system.hpp"
 #include "quantities/named_quantities.hpp"
+#include "quantities/numbers.hpp"
 #include "quantities/parser.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
@@ -32,9 +45,16 @@ using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_space;
+using namespace principia::integrators::_embedded_explicit_runge_kutta_nyström_integrator;  // NOLINT
+using namespace principia::integrators::_methods;
+using namespace principia::integrators::_symmetric_linear_multistep_integrator;
 using namespace principia::numerics::_fixed_arrays;
 using namespace principia::numerics::_legendre_normalization_factor;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_geopotential;
+using namespace principia::physics::_geopotential_grid;
 using namespace principia::physics::_massive_body;
 using namespace principia::physics::_oblate_body;
 using namespace principia::physics::_rotating_body;
@@ -45,10 +65,10 @@ using namespace principia::quantities::_parser;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
-template<typename Frame>
+template<typename Frame, template<typename> typename GeopotentialModel>
 Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
 GeneralSphericalHarmonicsAccelerationCpp(
-    Geopotential<Frame> const& geopotential,
+    GeopotentialModel<Frame> const& geopotential,
     Instant const& t,
     Displacement<Frame> const& r) {
   auto const r² = r.Norm²();
@@ -181,6 +201,163 @@ void BM_ComputeGeopotentialDistance(benchmark::State& state) {
   }
 }
 
+// Compares the exact geopotential with a |GeopotentialGrid| in low orbit.  The
+// second argument is 0 for the exact geopotential and 1 for the grid.
+void BM_ComputeGeopotentialLowOrbit(benchmark::State& state) {
+  int const max_degree = state.range(0);
+  bool const use_grid = state.range(1) != 0;
+  double const tolerance = 0x1.0p-24;
+  Length const inner_radius = 6'500 * Kilo(Metre);
+  Length const outer_radius = 8'000 * Kilo(Metre);
+
+  SolarSystem<ICRS> solar_system_2000(
+            SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+            SOLUTION_DIR / "astronomy" /
+                "sol_initial_state_jd_2451545_000000000.proto.txt");
+
+  auto const earth = MakeEarthBody(solar_system_2000, max_degree);
+  Geopotential<ICRS> const geopotential(&earth, tolerance);
+  std::optional<GeopotentialGrid<ICRS>> grid;
+  if (use_grid) {
+    grid = GeopotentialGrid<ICRS>::ForTolerance(&earth,
+                                                tolerance,
+                                                inner_radius,
+                                                outer_radius,
+                                                /*max_nodes=*/1 << 24);
+    CHECK(grid.has_value());
+  }
+
+  // Generate points in the shell.
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-outer_radius / Metre,
+                                                outer_radius / Metre);
+  std::vector<Displacement<ICRS>> displacements;
+  while (displacements.size() < 1e3) {
+    Displacement<ICRS> const displacement({distribution(random) * Metre,
+                                           distribution(random) * Metre,
+                                           distribution(random) * Metre});
+    if (displacement.Norm() > inner_radius &&
+        displacement.Norm() < outer_radius) {
+      displacements.push_back(displacement);
+    }
+  }
+
+  double max_error = 0;
+  for (auto const& displacement : displacements) {
+    auto const exact = GeneralSphericalHarmonicsAccelerationCpp(
+        geopotential, Instant(), displacement);
+    auto const actual = use_grid ? GeneralSphericalHarmonicsAccelerationCpp(
+                                       *grid, Instant(), displacement)
+                                 : exact;
+    max_error = std::max(
+        max_error, (actual - exact).Norm() * displacement.Norm²());
+  }
+
+  for (auto _ : state) {
+    Vector<Exponentiation<Length, -2>, ICRS> acceleration;
+    for (auto const& displacement : displacements) {
+      acceleration =
+          use_grid ? GeneralSphericalHarmonicsAccelerationCpp(
+                         *grid, Instant(), displacement)
+                   : GeneralSphericalHarmonicsAccelerationCpp(
+                         geopotential, Instant(), displacement);
+    }
+    benchmark::DoNotOptimize(acceleration);
+  }
+  state.counters["max_error"] = max_error;
+  state.counters["nodes"] = use_grid ? grid->number_of_nodes() : 0;
+}
+
+// Compares the predictions of a probe in low orbit with the exact geopotential
+// and with the grids of the |Ephemeris|.  The second argument is 0 for the
+// exact geopotential and 1 for the grids.  The difference with the exact
+// prediction is reported as a counter.
+void BM_ComputeGeopotentialPrediction(benchmark::State& state) {
+  int const max_degree = state.range(0);
+  bool const use_grids = state.range(1) != 0;
+  double const geopotential_tolerance = 0x1.0p-24;
+
+  SolarSystem<ICRS> solar_system_2000(
+            SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+            SOLUTION_DIR / "astronomy" /
+                "sol_initial_state_jd_2451545_000000000.proto.txt");
+  solar_system_2000.LimitOblatenessToDegree("Earth", max_degree);
+  Instant const initial_time = solar_system_2000.epoch();
+  Instant const final_time = initial_time + 1 * Day;
+
+  auto const make_ephemeris = [&solar_system_2000,
+                               geopotential_tolerance](bool const use_grids) {
+    return solar_system_2000.MakeEphemeris(
+        Ephemeris<ICRS>::AccuracyParameters(
+            /*fitting_tolerance=*/1 * Milli(Metre),
+            geopotential_tolerance,
+            /*opening_angle=*/0,
+            use_grids),
+        Ephemeris<ICRS>::FixedStepParameters(
+            SymmetricLinearMultistepIntegrator<
+                QuinlanTremaine1990Order12,
+                Ephemeris<ICRS>::NewtonianMotionEquation>(),
+            /*step=*/10 * Minute));
+  };
+  auto const exact_ephemeris = make_ephemeris(/*use_grids=*/false);
+  auto const ephemeris = make_ephemeris(use_grids);
+  CHECK_OK(exact_ephemeris->Prolong(final_time));
+  CHECK_OK(ephemeris->Prolong(final_time));
+
+  // A probe in an inclined low orbit, so that it sees all the latitudes where
+  // the grid interpolates.
+  DegreesOfFreedom<ICRS> const earth_degrees_of_freedom =
+      solar_system_2000.degrees_of_freedom("Earth");
+  Length const radius = 6'700 * Kilo(Metre);
+  Speed const speed =
+      Sqrt(solar_system_2000.gravitational_parameter("Earth") / radius);
+  Angle const inclination = 51.6 * Degree;
+  DegreesOfFreedom<ICRS> const probe_degrees_of_freedom(
+      earth_degrees_of_freedom.position() +
+          Displacement<ICRS>({radius, 0 * Metre, 0 * Metre}),
+      earth_degrees_of_freedom.velocity() +
+          Velocity<ICRS>({0 * Metre / Second,
+                          speed * Cos(inclination),
+                          speed * Sin(inclination)}));
+
+  auto const predict = [final_time,
+                        initial_time,
+                        &probe_degrees_of_freedom](
+                           Ephemeris<ICRS>& ephemeris,
+                           DiscreteTrajectory<ICRS>& trajectory) {
+    CHECK_OK(trajectory.Append(initial_time, probe_degrees_of_freedom));
+    CHECK_OK(ephemeris.FlowWithAdaptiveStep(
+        &trajectory,
+        Ephemeris<ICRS>::NoIntrinsicAcceleration,
+        final_time,
+        Ephemeris<ICRS>::AdaptiveStepParameters(
+            EmbeddedExplicitRungeKuttaNyströmIntegrator<
+                DormandالمكاوىPrince1986RKN434FM,
+                Ephemeris<ICRS>::NewtonianMotionEquation>(),
+            /*max_steps=*/std::numeric_limits<std::int64_t>::max(),
+            /*length_integration_tolerance=*/1 * Milli(Metre),
+            /*speed_integration_tolerance=*/1 * Milli(Metre) / Second),
+        Ephemeris<ICRS>::unlimited_max_ephemeris_steps));
+  };
+
+  DiscreteTrajectory<ICRS> exact_trajectory;
+  predict(*exact_ephemeris, exact_trajectory);
+
+  Length error;
+  std::int64_t steps;
+  for (auto _ : state) {
+    DiscreteTrajectory<ICRS> trajectory;
+    predict(*ephemeris, trajectory);
+    state.PauseTiming();
+    error = (trajectory.back().degrees_of_freedom.position() -
+             exact_trajectory.back().degrees_of_freedom.position()).Norm();
+    steps = trajectory.size();
+    state.ResumeTiming();
+  }
+  state.counters["error_m"] = error / Metre;
+  state.counters["steps"] = steps;
+}
+
 #define PRINCIPIA_CASE_COMPUTE_GEOPOTENTIAL_F90(d)                         \
   case (d): {                                                              \
     numerics::FixedMatrix<double, (d) + 1, (d) + 1> cnm;                   \
@@ -253,6 +430,18 @@ BENCHMARK(BM_ComputeGeopotentialF90)
     ->Arg(5)
     ->Arg(10)
     ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ComputeGeopotentialLowOrbit)
+    ->ArgPair(10, 0)
+    ->ArgPair(10, 1)
+    ->ArgPair(30, 0)
+    ->ArgPair(30, 1)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ComputeGeopotentialPrediction)
+    ->ArgPair(10, 0)
+    ->ArgPair(10, 1)
+    ->ArgPair(30, 0)
+    ->ArgPair(30, 1)
+    ->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_ComputeGeopotentialDistance)
     ->Arg(150'000)    // C₂₂, S₂₂, J₂.
     ->Arg(500'000)    // J₂.
@@ -1,8 +1,10 @@
-// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=Planetarium  // NOLINT(whitespace/line_length)
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=(Planetarium|Renderer)  // NOLINT(whitespace/line_length)
 
 #include "ksp_plugin/planetarium.hpp"
 
 #include <algorithm>
+#include <iterator>
+#include <memory>
 
 #include "astronomy/time_scales.hpp"
 #include "base/status_utilities.hpp"
@@ -10,6 +12,8 @@
 #include "geometry/instant.hpp"
 #include "geometry/space_transformations.hpp"
 #include "geometry/space.hpp"
+#include "ksp_plugin/celestial.hpp"
+#include "ksp_plugin/renderer.hpp"
 #include "physics/body_centred_non_rotating_reference_frame.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/solar_system.hpp"
@@ -33,8 +37,10 @@ using namespace principia::geometry::_signature;
 using namespace principia::geometry::_space;
 using namespace principia::integrators::_methods;
 using namespace principia::integrators::_symmetric_linear_multistep_integrator;
+using namespace principia::ksp_plugin::_celestial;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_planetarium;
+using namespace principia::ksp_plugin::_renderer;
 using namespace principia::physics::_body_centred_non_rotating_reference_frame;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_discrete_trajectory;
@@ -119,7 +125,11 @@ class Satellites {
             make_not_null_unique<
                 BodyCentredNonRotatingReferenceFrame<Barycentric, Navigation>>(
                 ephemeris_.get(),
-                earth_)) {
+                earth_)),
+        sun_(solar_system_->rotating_body(
+            *ephemeris_,
+            SolarSystemFactory::name(SolarSystemFactory::Sun))) {
+    sun_.set_trajectory(ephemeris_->trajectory(sun_.body()));
     // Two-line elements for GOES-8:
     // 1 23051U 94022A   00004.06628221 -.00000243  00000-0  00000-0 0  9630
     // 2 23051   0.4232  97.7420 0004776 192.8349 121.5613  1.00264613 28364
@@ -151,6 +161,16 @@ class Satellites {
     return goes_8_trajectory_;
   }
 
+  // A renderer that plots in the Earth-centred inertial frame.
+  Renderer MakeRenderer() const {
+    return Renderer(
+        &sun_,
+        make_not_null_unique<
+            BodyCentredNonRotatingReferenceFrame<Barycentric, Navigation>>(
+            ephemeris_.get(),
+            earth_));
+  }
+
   Planetarium MakePlanetarium(
       Perspective<Navigation, Camera> const& perspective) const {
     // No dark area, human visual acuity, wide field of view.
@@ -191,6 +211,7 @@ class Satellites {
   not_null<std::unique_ptr<Ephemeris<Barycentric>>> const ephemeris_;
   not_null<MassiveBody const*> const earth_;
   not_null<std::unique_ptr<NavigationFrame>> const earth_centred_inertial_;
+  Celestial sun_;
   DiscreteTrajectory<Barycentric> goes_8_trajectory_;
 };
 
@@ -252,6 +273,29 @@ void BM_PlanetariumPlotMethod2FarEquatorialPerspective(
   RunBenchmark(state, EquatorialPerspective(far));
 }
 
+// Renders the first |state.range(0)| points of the trajectory of GOES-8 in
+// |World|, as is done for the trajectories shown in the main camera.
+void BM_RendererRenderBarycentricTrajectoryInWorld(benchmark::State& state) {
+  Satellites satellites;
+  Renderer const renderer = satellites.MakeRenderer();
+  auto const& trajectory = satellites.goes_8_trajectory();
+  auto const begin = trajectory.begin();
+  auto const end = std::next(begin, state.range(0));
+  Instant const now = std::prev(end)->time;
+  Position<World> const sun_world_position = World::origin;
+  Rotation<Barycentric, AliceSun> const planetarium_rotation =
+      Rotation<Barycentric, AliceSun>::Identity();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        renderer.RenderBarycentricTrajectoryInWorld(now,
+                                                    begin,
+                                                    end,
+                                                    sun_world_position,
+                                                    planetarium_rotation));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 BENCHMARK(BM_PlanetariumPlotMethod2NearPolarPerspective)
     ->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_PlanetariumPlotMethod2FarPolarPerspective)
@@ -260,6 +304,10 @@ BENCHMARK(BM_PlanetariumPlotMethod2NearEquatorialPerspective)
     ->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_PlanetariumPlotMethod2FarEquatorialPerspective)
     ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RendererRenderBarycentricTrajectoryInWorld)
+    ->Arg(1'000)
+    ->Arg(10'000)
+    ->Unit(benchmark::kMillisecond);
 
 }  // namespace geometry
 }  // namespace principia
@@ -98,6 +98,52 @@ void BM_ThreadPoolExclusiveLock(benchmark::State& state) {
   }
 }
 
+// Measures the overhead of adding a call and waiting for its result, using calls
+// that do nothing.
+void BM_ThreadPoolOverhead(benchmark::State& state) {
+  constexpr int number_of_calls = 10'000;
+  ThreadPool<void> pool(/*pool_size=*/state.range(0));
+  for (auto _ : state) {
+    std::vector<std::future<void>> futures;
+    futures.reserve(number_of_calls);
+    for (int i = 0; i < number_of_calls; ++i) {
+      futures.push_back(pool.Add([]() {}));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_calls);
+}
+
+// Same as above, but the calls are added by a thread of the pool, as happens
+// when a call spawns more work.
+void BM_ThreadPoolNestedOverhead(benchmark::State& state) {
+  constexpr int number_of_calls = 10'000;
+  ThreadPool<void> pool(/*pool_size=*/state.range(0));
+  for (auto _ : state) {
+    std::vector<std::future<void>> futures;
+    futures.reserve(number_of_calls);
+    pool.Add([&futures, &pool]() {
+      for (int i = 0; i < number_of_calls; ++i) {
+        futures.push_back(pool.Add([]() {}));
+      }
+    }).wait();
+    for (auto const& future : futures) {
+      future.wait();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_calls);
+}
+
+BENCHMARK(BM_ThreadPoolOverhead)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ThreadPoolNestedOverhead)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_ThreadPoolNoLock)
     ->Arg(1)
     ->Arg(2)
@@ -2,6 +2,7 @@
 
 #include <utility>
 
+#include "geometry/bulk_linear_map.hpp"
 #include "geometry/point.hpp"
 #include "geometry/grassmann.hpp"
 #include "affine_map.hpp"
@@ -11,6 +12,8 @@ namespace geometry {
 namespace _affine_map {
 namespace internal {
 
+using namespace principia::geometry::_bulk_linear_map;
+
 // The map is represented as x ↦ linear_map(x - from_origin) + to_origin.  This
 // numerically better behaved than x ↦ linear_map(x) + translation with
 // translation = to_origin - linear_map(from_origin).
@@ -44,6 +47,19 @@ AffineMap<FromFrame, ToFrame, Scalar, LinearMap_>::operator()(
           linear_map_(point - from_origin_) + to_origin_);
 }
 
+template<typename FromFrame, typename ToFrame, typename Scalar,
+         template<typename, typename> class LinearMap_>
+void AffineMap<FromFrame, ToFrame, Scalar, LinearMap_>::Apply(
+    std::vector<Point<FromVector>> const& points,
+    std::vector<Point<ToVector>>& images) const {
+  BulkLinearMap<FromFrame, ToFrame> const bulk_linear_map(linear_map_);
+  images.clear();
+  images.reserve(points.size());
+  for (auto const& point : points) {
+    images.push_back(bulk_linear_map(point - from_origin_) + to_origin_);
+  }
+}
+
 template<typename FromFrame, typename ToFrame, typename Scalar,
          template<typename, typename> class LinearMap_>
 template<template<typename, typename> typename OtherAffineMap>
@@ -117,6 +117,27 @@ TEST_F(AffineMapTest, Cube) {
   }
 }
 
+TEST_F(AffineMapTest, Apply) {
+  Rot const rotate_left(π / 2 * Radian,
+                        Bivector<Length, World>(upward_.coordinates()));
+  Orth const permute_and_rotate =
+      Perm(Perm::CoordinatePermutation::ZXY).Forget<OrthogonalMap>() *
+      rotate_left.Forget<OrthogonalMap>();
+  AffineMap<World, World, Length, OrthogonalMap> const map(
+      back_right_bottom_, front_left_top_, permute_and_rotate);
+  std::vector<Position<World>> images;
+  map.Apply(vertices_, images);
+  ASSERT_EQ(vertices_.size(), images.size());
+  for (std::size_t i = 0; i < vertices_.size(); ++i) {
+    EXPECT_THAT(images[i] - origin_,
+                AlmostEquals(map(vertices_[i]) - origin_, 0, 2));
+  }
+  // The output vector is overwritten.
+  map.Apply(std::vector<Position<World>>{origin_}, images);
+  ASSERT_EQ(1, images.size());
+  EXPECT_THAT(images[0] - origin_, AlmostEquals(map(origin_) - origin_, 0, 2));
+}
+
 TEST_F(AffineMapTest, Serialization) {
   serialization::AffineMap message;
   Rot const rotate_left(π / 2 * Radian,
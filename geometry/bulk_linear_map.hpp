@@ -0,0 +1,49 @@
+#pragma once
+
+#include "geometry/grassmann.hpp"
+#include "geometry/r3_element.hpp"
+
+namespace principia {
+namespace geometry {
+namespace _bulk_linear_map {
+namespace internal {
+
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_r3_element;
+
+// The matrix of a linear map from |FromFrame| to |ToFrame|, used to apply that
+// map to many vectors.  The linear maps of this library are represented in
+// forms (e.g., quaternions) which are compact and numerically well-behaved, but
+// which are comparatively costly to apply; this class computes the matrix once
+// and then applies it using SSE2 multiply-adds.  The results agree with those
+// of the linear map up to rounding.
+template<typename FromFrame, typename ToFrame>
+class BulkLinearMap final {
+ public:
+  // |LinearMap| must be a linear map from |FromFrame| to |ToFrame| which is
+  // applicable to a |Vector<double, FromFrame>| and returns a
+  // |Vector<double, ToFrame>|.
+  template<typename LinearMap>
+  explicit BulkLinearMap(LinearMap const& linear_map);
+
+  template<typename Scalar>
+  Vector<Scalar, ToFrame> operator()(
+      Vector<Scalar, FromFrame> const& vector) const;
+
+ private:
+  // The images of the vectors of the canonical basis of |FromFrame|, i.e., the
+  // columns of the matrix.
+  R3Element<double> column_x_;
+  R3Element<double> column_y_;
+  R3Element<double> column_z_;
+};
+
+}  // namespace internal
+
+using internal::BulkLinearMap;
+
+}  // namespace _bulk_linear_map
+}  // namespace geometry
+}  // namespace principia
+
+#include "geometry/bulk_linear_map_body.hpp"
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "geometry/bulk_linear_map.hpp"
+
+#include <pmmintrin.h>
+
+namespace principia {
+namespace geometry {
+namespace _bulk_linear_map {
+namespace internal {
+
+template<typename FromFrame, typename ToFrame>
+template<typename LinearMap>
+BulkLinearMap<FromFrame, ToFrame>::BulkLinearMap(LinearMap const& linear_map)
+    : column_x_(linear_map(Vector<double, FromFrame>({1, 0, 0})).coordinates()),
+      column_y_(linear_map(Vector<double, FromFrame>({0, 1, 0})).coordinates()),
+      column_z_(
+          linear_map(Vector<double, FromFrame>({0, 0, 1})).coordinates()) {}
+
+template<typename FromFrame, typename ToFrame>
+template<typename Scalar>
+Vector<Scalar, ToFrame> BulkLinearMap<FromFrame, ToFrame>::operator()(
+    Vector<Scalar, FromFrame> const& vector) const {
+  R3Element<Scalar> const& coordinates = vector.coordinates();
+  // Broadcast each coordinate to both lanes of a register.
+  __m128d const x = _mm_unpacklo_pd(coordinates.xy, coordinates.xy);
+  __m128d const y = _mm_unpackhi_pd(coordinates.xy, coordinates.xy);
+  __m128d const z = _mm_unpacklo_pd(coordinates.zt, coordinates.zt);
+  __m128d const xy = _mm_add_pd(
+      _mm_add_pd(_mm_mul_pd(x, column_x_.xy), _mm_mul_pd(y, column_y_.xy)),
+      _mm_mul_pd(z, column_z_.xy));
+  __m128d const zt = _mm_add_sd(
+      _mm_add_sd(_mm_mul_sd(x, column_x_.zt), _mm_mul_sd(y, column_y_.zt)),
+      _mm_mul_sd(z, column_z_.zt));
+  return Vector<Scalar, ToFrame>(R3Element<Scalar>(xy, zt));
+}
+
+}  // namespace internal
+}  // namespace _bulk_linear_map
+}  // namespace geometry
+}  // namespace principia
@@ -63,4 +63,24 @@ for repo in protobuf glog googletest gipfeli abseil-cpp benchmark zfp; do
   popd
 done
 
+# The compression libraries are built from their upstream repositories, with
+# the flags of the other dependencies.
+for repo in lz4/lz4 facebook/zstd; do
+  if [ ! -d "${repo#*/}" ]; then
+    git clone "https://github.com/$repo.git"
+  fi
+  pushd "${repo#*/}"
+  git checkout release
+  git pull
+
+  if [ "$(uname -s)" == "Darwin" ]; then
+    C_FLAGS="-fPIC -O3 -g -DNDEBUG -mmacosx-version-min=10.12 -arch x86_64"
+  else
+    C_FLAGS="-fPIC -O3 -g -DNDEBUG -m64"
+  fi
+  make -C lib CC=clang CFLAGS="${C_FLAGS?}" "lib${repo#*/}.a"
+
+  popd
+done
+
 popd
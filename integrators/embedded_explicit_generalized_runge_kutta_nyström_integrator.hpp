@@ -9,6 +9,7 @@
 #define PRINCIPIA_INTEGRATORS_EMBEDDED_EXPLICIT_GENERALIZED_RUNGE_KUTTA_NYSTRÖM_INTEGRATOR_HPP_  // NOLINT(whitespace/line_length)
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "absl/status/status.h"
@@ -127,6 +128,37 @@ class EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator
              EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator const&
                  integrator);
 
+    // Scratch storage for |Solve|.  The workspaces are kept in a per-thread
+    // pool and lent to an instance for the duration of |Solve|, so that the
+    // integration doesn't allocate once the vectors have the dimension of the
+    // problem, even if the instance was created just before calling |Solve|.
+    // This is not part of the state of the instance and is not serialized.
+    struct Workspace final {
+      std::vector<typename ODE::DependentVariableDifference> Δq̂;
+      std::vector<typename ODE::DependentVariableDerivative> Δv̂;
+      typename ODE::State::Error error_estimate;
+      std::vector<typename ODE::DependentVariable> q_stage;
+      std::vector<typename ODE::DependentVariableDerivative> v_stage;
+      std::vector<std::vector<typename ODE::DependentVariableDerivative2>> g;
+      typename ODE::State final_state;
+    };
+
+    // Takes a workspace from the pool of the current thread, or creates one if
+    // the pool is empty, and returns it to the pool on destruction.  Nested
+    // calls to |Solve| on the same thread get distinct workspaces.
+    class PooledWorkspace final {
+     public:
+      PooledWorkspace();
+      ~PooledWorkspace();
+
+      Workspace& operator*() const;
+
+     private:
+      std::unique_ptr<Workspace> workspace_;
+
+      inline static thread_local std::vector<std::unique_ptr<Workspace>> pool_;
+    };
+
     EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator const& integrator_;
     friend class EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator;
   };
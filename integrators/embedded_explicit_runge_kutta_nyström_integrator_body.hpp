@@ -5,7 +5,7 @@
 #include <algorithm>
 #include <cmath>
 #include <ctime>
-#include <optional>
+#include <memory>
 #include <vector>
 
 #include "base/jthread.hpp"
@@ -64,8 +64,12 @@ Instance::Solve(Instant const& t_final) {
   // |current_state| gets updated as the integration progresses to allow
   // restartability.
 
+  PooledWorkspace const pooled_workspace;
+  Workspace& workspace = *pooled_workspace;
+
   // State before the last, truncated step.
-  std::optional<typename ODE::State> final_state;
+  typename ODE::State& final_state = workspace.final_state;
+  bool has_final_state = false;
 
   // Argument checks.
   int const dimension = current_state.positions.size();
@@ -88,9 +92,11 @@ Instance::Solve(Instant const& t_final) {
   DoublePrecision<Instant>& t = current_state.time;
 
   // Position increment (high-order).
-  std::vector<Displacement> Δq̂(dimension);
+  std::vector<Displacement>& Δq̂ = workspace.Δq̂;
+  Δq̂.resize(dimension);
   // Velocity increment (high-order).
-  std::vector<Velocity> Δv̂(dimension);
+  std::vector<Velocity>& Δv̂ = workspace.Δv̂;
+  Δv̂.resize(dimension);
   // Current position.  This is a non-const reference whose purpose is to make
   // the equations more readable.
   std::vector<DoublePrecision<Position>>& q̂ = current_state.positions;
@@ -99,15 +105,17 @@ Instance::Solve(Instant const& t_final) {
   std::vector<DoublePrecision<Velocity>>& v̂ = current_state.velocities;
 
   // Difference between the low- and high-order approximations.
-  typename ODE::State::Error error_estimate;
+  typename ODE::State::Error& error_estimate = workspace.error_estimate;
   error_estimate.position_error.resize(dimension);
   error_estimate.velocity_error.resize(dimension);
 
   // Current Runge-Kutta-Nyström stage.
-  std::vector<Position> q_stage(dimension);
+  std::vector<Position>& q_stage = workspace.q_stage;
+  q_stage.resize(dimension);
   // Accelerations at each stage.
   // TODO(egg): this is a rectangular container, use something more appropriate.
-  std::vector<std::vector<Acceleration>> g(stages_);
+  std::vector<std::vector<Acceleration>>& g = workspace.g;
+  g.resize(stages_);
   for (auto& g_stage : g) {
     g_stage.resize(dimension);
   }
@@ -169,6 +177,7 @@ Instance::Solve(Instant const& t_final) {
           // last stage below.
           h = time_to_end;
           final_state = current_state;
+          has_final_state = true;
         }
       }
 
@@ -223,6 +232,7 @@ Instance::Solve(Instant const& t_final) {
     if (!parameters.last_step_is_exact && t.value + (t.error + h) > t_final) {
       // We did overshoot.  Drop the point that we just computed and exit.
       final_state = current_state;
+      has_final_state = true;
       break;
     }
 
@@ -230,6 +240,9 @@ Instance::Solve(Instant const& t_final) {
       using std::swap;
       swap(g.front(), g.back());
       first_stage = 1;
+      // The accelerations at the end of the step are free, pass them to
+      // |append_state|.
+      current_state.accelerations = g.front();
     }
 
     // Increment the solution with the high-order approximation.
@@ -251,8 +264,8 @@ Instance::Solve(Instant const& t_final) {
     }
   }
   // The resolution is restartable from the last non-truncated state.
-  CHECK(final_state);
-  current_state = *final_state;
+  CHECK(has_final_state);
+  current_state = final_state;
   return status;
 }
 
@@ -263,6 +276,31 @@ Instance::integrator() const {
   return integrator_;
 }
 
+template<typename Method, typename ODE_>
+EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_>::Instance::
+PooledWorkspace::PooledWorkspace() {
+  if (pool_.empty()) {
+    workspace_ = std::make_unique<Workspace>();
+  } else {
+    workspace_ = std::move(pool_.back());
+    pool_.pop_back();
+  }
+}
+
+template<typename Method, typename ODE_>
+EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_>::Instance::
+PooledWorkspace::~PooledWorkspace() {
+  pool_.push_back(std::move(workspace_));
+}
+
+template<typename Method, typename ODE_>
+typename EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_>::Instance::
+Workspace&
+EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_>::Instance::
+PooledWorkspace::operator*() const {
+  return *workspace_;
+}
+
 template<typename Method, typename ODE_>
 not_null<std::unique_ptr<typename Integrator<ODE_>::Instance>>
 EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_>::
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <set>
 #include <vector>
 
 #include "base/macros.hpp"
@@ -478,6 +479,60 @@ TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, Serialization) {
 }
 
 
+// A new instance solved after another one has finished on the same thread
+// reuses its workspace, so it doesn't allocate its stage vectors.
+TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, WorkspaceReuse) {
+  AdaptiveStepSizeIntegrator<ODE> const& integrator =
+      EmbeddedExplicitRungeKuttaNyströmIntegrator<
+          methods::DormandالمكاوىPrince1986RKN434FM, ODE>();
+  Instant const t_initial;
+  Instant const t_final = t_initial + 1 * Second;
+
+  // The addresses of the positions and accelerations passed to the right-hand
+  // side, which are the stage vectors of the workspace.
+  std::set<Length const*> positions;
+  std::set<Acceleration const*> accelerations;
+  ODE harmonic_oscillator;
+  harmonic_oscillator.compute_acceleration =
+      [&accelerations, &positions](Instant const& t,
+                                   std::vector<Length> const& q,
+                                   std::vector<Acceleration>& result) {
+        positions.insert(q.data());
+        accelerations.insert(result.data());
+        return ComputeHarmonicOscillatorAcceleration1D(
+            t, q, result, /*evaluations=*/nullptr);
+      };
+  InitialValueProblem<ODE> problem;
+  problem.equation = harmonic_oscillator;
+  problem.initial_state = {t_initial, {1 * Metre}, {0 * Metre / Second}};
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t_final - t_initial,
+      /*safety_factor=*/0.9);
+  auto const tolerance_to_error_ratio =
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2, _3,
+                /*q_tolerance=*/1 * Milli(Metre),
+                /*v_tolerance=*/1 * Milli(Metre) / Second,
+                /*callback=*/[](bool) {});
+
+  auto solve = [&]() {
+    auto const instance = integrator.NewInstance(problem,
+                                                 /*append_state=*/[](auto&&) {},
+                                                 tolerance_to_error_ratio,
+                                                 parameters);
+    EXPECT_THAT(instance->Solve(t_final),
+                StatusIs(termination_condition::Done));
+  };
+
+  solve();
+  auto const first_positions = positions;
+  auto const first_accelerations = accelerations;
+  solve();
+  EXPECT_EQ(first_positions, positions);
+  EXPECT_EQ(first_accelerations, accelerations);
+}
+
+
 // Reopen this namespace to allow printing out the system state.
 namespace _ordinary_differential_equations {
 namespace internal {
@@ -95,9 +95,11 @@ ExplicitLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
           });
     }
 
-    // Create a new step in the instance.
+    // Create a new step in the instance.  The oldest step has been used above
+    // and is no longer needed, so its storage is reused.
     s.Increment(h);
-    Step current_step{.s = s};
+    Step& current_step = starter_.RecycleOldestStep();
+    current_step.s = s;
 
     // Fill the new step.  We skip the division by αₖ as it is equal to 1.0.
     double const αₖ = α[0];
@@ -121,7 +123,6 @@ ExplicitLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
     termination_condition::UpdateWithAbort(
         equation.compute_derivative(s.value, y_stage, current_step.yʹ),
         status);
-    starter_.Push(std::move(current_step));
 
     // Inform the caller of the new state.
     RETURN_IF_STOPPED;
@@ -170,6 +170,12 @@ struct ExplicitSecondOrderOrdinaryDifferentialEquation final {
     std::vector<
         DoublePrecision<Derivative<DependentVariable, IndependentVariable>>>
         velocities;
+    // The accelerations at |time|, if the integrator obtained them as part of
+    // the step that led to this state (e.g., because its method is first same
+    // as last); empty otherwise.  They allow a continuous extension of higher
+    // order without additional evaluations of the right-hand side.  Not
+    // serialized, and ignored by comparisons.
+    std::vector<DependentVariableDerivative2> accelerations;
 
     friend bool operator==(State const& lhs, State const& rhs) {
       return lhs.positions == rhs.positions &&
@@ -35,9 +35,10 @@ class Starter {
   // updated more frequently than once every |instance.step_|.
   void Solve(typename ODE::IndependentVariable const& s_final);
 
-  // Appends a new step to |previous_steps_| and drops the oldest one if needed.
-  // This object must be |started()|.
-  void Push(Step step);
+  // Moves the oldest step to the end of |previous_steps_| and returns it.  The
+  // caller must overwrite it with the new step; this avoids allocating memory
+  // for each step.  This object must be |started()|.
+  Step& RecycleOldestStep();
 
   // Returns the startup steps.  This object must be |started()|.
   std::list<Step> const& previous_steps() const;
@@ -73,10 +73,12 @@ void Starter<ODE, Step, steps>::Solve(
 }
 
 template<typename ODE, typename Step, int steps>
-void Starter<ODE, Step, steps>::Push(Step step) {
+Step& Starter<ODE, Step, steps>::RecycleOldestStep() {
   CHECK(started());
-  previous_steps_.push_back(std::move(step));
-  previous_steps_.pop_front();
+  previous_steps_.splice(previous_steps_.end(),
+                         previous_steps_,
+                         previous_steps_.begin());
+  return previous_steps_.back();
 }
 
 template<typename ODE, typename Step, int steps>
@@ -105,6 +105,17 @@ class SymmetricLinearMultistepIntegrator
     // method based on the accelerations computed by the main integrator.
     void ComputeVelocityUsingCohenHubbardOesterwinter();
 
+    // Scratch storage for |Solve|, kept across calls so that the integration
+    // doesn't allocate once the vectors have the dimension of the problem.
+    // This is not part of the state of the instance and is not serialized.
+    struct Workspace final {
+      std::vector<typename ODE::DependentVariable> positions;
+      std::vector<DoublePrecision<typename ODE::DependentVariableDifference>>
+          Σⱼ_minus_αⱼ_qⱼ;
+      typename ODE::DependentVariableDerivatives2 Σⱼ_βⱼ_numerator_aⱼ;
+    };
+
+    Workspace workspace_;
     Starter starter_;
     SymmetricLinearMultistepIntegrator const& integrator_;
     friend class SymmetricLinearMultistepIntegrator;
@@ -65,10 +65,14 @@ SymmetricLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
   int const k = order;
 
   absl::Status status;
-  std::vector<Position> positions(dimension);
-
-  DoubleDisplacements Σⱼ_minus_αⱼ_qⱼ(dimension);
-  std::vector<Acceleration> Σⱼ_βⱼ_numerator_aⱼ(dimension);
+  std::vector<Position>& positions = workspace_.positions;
+  positions.resize(dimension);
+
+  DoubleDisplacements& Σⱼ_minus_αⱼ_qⱼ = workspace_.Σⱼ_minus_αⱼ_qⱼ;
+  Σⱼ_minus_αⱼ_qⱼ.resize(dimension);
+  std::vector<Acceleration>& Σⱼ_βⱼ_numerator_aⱼ =
+      workspace_.Σⱼ_βⱼ_numerator_aⱼ;
+  Σⱼ_βⱼ_numerator_aⱼ.resize(dimension);
   while (h <= (t_final - t.value) - t.error) {
     // We take advantage of the symmetry to iterate on the list of previous
     // steps from both ends.
@@ -115,11 +119,13 @@ SymmetricLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
       }
     }
 
-    // Create a new step in the instance.
+    // Create a new step in the instance.  The oldest step has been used above
+    // and is no longer needed, so its storage is reused.
     t.Increment(h);
-    Step current_step{.time = t};
+    Step& current_step = starter_.RecycleOldestStep();
+    current_step.time = t;
     current_step.accelerations.resize(dimension);
-    current_step.displacements.reserve(dimension);
+    current_step.displacements.resize(dimension);
 
     // Fill the new step.  We skip the division by αₖ as it is equal to 1.0.
     double const αₖ = α[0];
@@ -128,7 +134,7 @@ SymmetricLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
       DoubleDisplacement& current_displacement = Σⱼ_minus_αⱼ_qⱼ[d];
       current_displacement.Increment(h * h *
                                      Σⱼ_βⱼ_numerator_aⱼ[d] / β_denominator);
-      current_step.displacements.push_back(current_displacement);
+      current_step.displacements[d] = current_displacement;
       DoublePosition const current_position =
           DoublePosition() + current_displacement;
       positions[d] = current_position.value;
@@ -139,7 +145,6 @@ SymmetricLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
                                       positions,
                                       current_step.accelerations),
         status);
-    starter_.Push(std::move(current_step));
 
     ComputeVelocityUsingCohenHubbardOesterwinter();
 
@@ -8,6 +8,8 @@
 #ifndef PRINCIPIA_INTEGRATORS_SYMPLECTIC_RUNGE_KUTTA_NYSTRÖM_INTEGRATOR_HPP_
 #define PRINCIPIA_INTEGRATORS_SYMPLECTIC_RUNGE_KUTTA_NYSTRÖM_INTEGRATOR_HPP_
 
+#include <vector>
+
 #include "absl/status/status.h"
 #include "base/not_null.hpp"
 #include "base/traits.hpp"
@@ -104,6 +106,17 @@ class SymplecticRungeKuttaNyströmIntegrator
              Time const& step,
              SymplecticRungeKuttaNyströmIntegrator const& integrator);
 
+    // Scratch storage for |Solve|, kept across calls so that the integration
+    // doesn't allocate once the vectors have the dimension of the problem.
+    // This is not part of the state of the instance and is not serialized.
+    struct Workspace final {
+      std::vector<typename ODE::DependentVariableDifference> Δq;
+      std::vector<typename ODE::DependentVariableDerivative> Δv;
+      std::vector<typename ODE::DependentVariable> q_stage;
+      std::vector<typename ODE::DependentVariableDerivative2> g;
+    };
+
+    Workspace workspace_;
     SymplecticRungeKuttaNyströmIntegrator const& integrator_;
     friend class SymplecticRungeKuttaNyströmIntegrator;
   };
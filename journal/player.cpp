@@ -1,15 +1,19 @@
 #include "journal/player.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <string>
+#include <string_view>
 
 #include "absl/strings/match.h"
 #include "base/array.hpp"
+#include "base/compressor_registry.hpp"
 #include "base/get_line.hpp"
 #include "base/hexadecimal.hpp"
 #include "base/version.hpp"
 #include "journal/profiles.hpp"
+#include "journal/recorder.hpp"
 #include "glog/logging.h"
 
 #define PRINCIPIA_PLAYER_ALLOW_VERSION_MISMATCH 0
@@ -21,16 +25,42 @@ namespace internal {
 
 using interface::principia__ActivatePlayer;
 using namespace principia::base::_array;
+using namespace principia::base::_compressor_registry;
 using namespace principia::base::_get_line;
 using namespace principia::base::_hexadecimal;
 using namespace principia::base::_version;
+using namespace principia::journal::_recorder;
 
 using namespace std::chrono_literals;
 
 Player::Player(std::filesystem::path const& path)
-    : stream_(path, std::ios::in) {
+    : stream_(path, std::ios::in | std::ios::binary) {
   principia__ActivatePlayer();
-  CHECK(!stream_.fail());
+  CHECK(!stream_.fail()) << path;
+
+  // Look for the header of a binary journal.  If it's not there, we have a
+  // hexadecimal journal, which must be reopened in text mode.
+  std::string header(binary_journal_header.size() + 1, '\0');
+  stream_.read(header.data(), header.size());
+  if (stream_.gcount() == header.size() &&
+      std::string_view(header).substr(0, binary_journal_header.size()) ==
+          binary_journal_header) {
+    binary_ = true;
+    switch (static_cast<Compression>(header.back())) {
+      case Compression::None:
+        break;
+      case Compression::Gipfeli:
+        decompressor_ = NewCompressor(gipfeli_compressor);
+        break;
+      default:
+        LOG(FATAL) << "Unknown compression " << static_cast<int>(header.back())
+                   << " in " << path;
+    }
+  } else {
+    stream_.close();
+    stream_.open(path, std::ios::in);
+    CHECK(!stream_.fail()) << path;
+  }
 }
 
 bool Player::Play(int const index) {
@@ -50,6 +80,38 @@ serialization::Method const& Player::last_method_out_return() const {
 }
 
 std::unique_ptr<serialization::Method> Player::Read() {
+  if (binary_) {
+    unsigned char length[4];
+    stream_.read(reinterpret_cast<char*>(length), sizeof(length));
+    if (stream_.gcount() == 0) {
+      return nullptr;
+    }
+    // The last frame may be truncated if the process that recorded the journal
+    // crashed.
+    if (stream_.gcount() != sizeof(length)) {
+      LOG(ERROR) << "Truncated frame length";
+      return nullptr;
+    }
+    std::uint32_t const size = static_cast<std::uint32_t>(length[0]) |
+                               static_cast<std::uint32_t>(length[1]) << 8 |
+                               static_cast<std::uint32_t>(length[2]) << 16 |
+                               static_cast<std::uint32_t>(length[3]) << 24;
+    std::string frame(size, '\0');
+    stream_.read(frame.data(), size);
+    if (stream_.gcount() != size) {
+      LOG(ERROR) << "Truncated frame of size " << size;
+      return nullptr;
+    }
+    if (decompressor_ != nullptr) {
+      std::string uncompressed_frame;
+      CHECK(decompressor_->Uncompress(frame, &uncompressed_frame));
+      frame.swap(uncompressed_frame);
+    }
+    auto method = std::make_unique<serialization::Method>();
+    CHECK(method->ParseFromString(frame));
+    return method;
+  }
+
   std::string const line = GetLine(stream_);
   if (line.empty()) {
     return nullptr;
@@ -5,6 +5,7 @@
 #include <map>
 #include <memory>
 
+#include "gipfeli/compression.h"
 #include "serialization/journal.pb.h"
 
 namespace principia {
@@ -20,6 +21,7 @@ class Player final {
  public:
   using PointerMap = std::map<std::uint64_t, void*>;
 
+  // The journal at |path| may be in any of the formats written by |Recorder|.
   explicit Player(std::filesystem::path const& path);
 
   // Replays the next message in the journal.  Returns false at end of journal.
@@ -48,6 +50,11 @@ class Player final {
   PointerMap pointer_map_;
   std::ifstream stream_;
 
+  // True for a binary journal, in which case |decompressor_| is null if the
+  // frames are not compressed.
+  bool binary_ = false;
+  std::unique_ptr<google::compression::Compressor> decompressor_;
+
   std::unique_ptr<serialization::Method> last_method_in_;
   std::unique_ptr<serialization::Method> last_method_out_return_;
 
@@ -47,6 +47,7 @@ using namespace principia::journal::_player;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_pile_up;
 using namespace principia::ksp_plugin::_planetarium;
+using namespace principia::ksp_plugin::_plot_batch;
 using namespace principia::ksp_plugin::_plugin;
 using namespace principia::ksp_plugin::_vessel;
 
@@ -1,8 +1,18 @@
 #include "journal/recorder.hpp"
 
+#include <chrono>
 #include <filesystem>
+#include <utility>
+
+#include "base/macros.hpp"
+#if OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "base/array.hpp"
+#include "base/compressor_registry.hpp"
 #include "base/hexadecimal.hpp"
 #include "base/serialization.hpp"
 #include "base/version.hpp"
@@ -15,13 +25,68 @@ namespace _recorder {
 namespace internal {
 
 using namespace principia::base::_array;
+using namespace principia::base::_compressor_registry;
 using namespace principia::base::_hexadecimal;
 using namespace principia::base::_serialization;
 using namespace principia::base::_version;
 
-Recorder::Recorder(std::filesystem::path const& path)
-    : stream_(path, std::ios::out) {
-  CHECK(!stream_.fail()) << path;
+using namespace std::chrono_literals;
+
+// The period at which the binary journals are synced to disk.  The flush after
+// each batch of frames ensures that the data is handed to the operating system,
+// which protects against a crash of the process but not of the machine.
+constexpr std::chrono::steady_clock::duration sync_period = 1s;
+
+namespace {
+
+// Ensures that the data written to |file| is on disk.
+void Sync(std::FILE* const file) {
+#if OS_WIN
+  CHECK_EQ(0, _commit(_fileno(file)));
+#else
+  CHECK_EQ(0, fsync(fileno(file)));
+#endif
+}
+
+}  // namespace
+
+Recorder::Recorder(std::filesystem::path const& path, Format const format)
+    : format_(format) {
+  if (format_ == Format::Hexadecimal) {
+    stream_.open(path, std::ios::out);
+    CHECK(!stream_.fail()) << path;
+    return;
+  }
+
+  Compression compression = Compression::None;
+  if (format_ == Format::GipfeliBinary) {
+    compressor_ = NewCompressor(gipfeli_compressor);
+    compression = Compression::Gipfeli;
+  }
+#if OS_WIN
+  file_ = _wfopen(path.c_str(), L"wb");
+#else
+  file_ = std::fopen(path.c_str(), "wb");
+#endif
+  CHECK_NOTNULL(file_);
+  CHECK_EQ(binary_journal_header.size(),
+           std::fwrite(binary_journal_header.data(),
+                       1,
+                       binary_journal_header.size(),
+                       file_)) << path;
+  CHECK_NE(EOF, std::fputc(static_cast<int>(compression), file_)) << path;
+  writer_ = std::thread(&Recorder::WriteFramesAndSync, this);
+}
+
+Recorder::~Recorder() {
+  if (format_ != Format::Hexadecimal) {
+    {
+      absl::MutexLock l(&frames_lock_);
+      shutdown_ = true;
+    }
+    writer_.join();
+    CHECK_EQ(0, std::fclose(file_));
+  }
 }
 
 void Recorder::WriteAtConstruction(serialization::Method const& method) {
@@ -63,13 +128,64 @@ bool Recorder::IsActivated() {
 }
 
 void Recorder::WriteLocked(serialization::Method const& method) {
-  static auto* const encoder = new HexadecimalEncoder</*null_terminated=*/true>;
   CHECK_LT(0, method.ByteSize()) << method.DebugString();
+  if (format_ != Format::Hexadecimal) {
+    std::string frame = method.SerializeAsString();
+    absl::MutexLock l(&frames_lock_);
+    frames_.push_back(std::move(frame));
+    return;
+  }
+  static auto* const encoder = new HexadecimalEncoder</*null_terminated=*/true>;
   auto const hexadecimal = encoder->Encode(SerializeAsBytes(method).get());
   stream_ << hexadecimal.data.get() << "\n";
   stream_.flush();
 }
 
+void Recorder::WriteFramesAndSync() {
+  std::vector<std::string> frames;
+  std::string compressed_frame;
+  auto last_sync = std::chrono::steady_clock::now();
+  for (;;) {
+    bool shutdown;
+    {
+      absl::MutexLock l(&frames_lock_);
+      auto const has_frames_or_shutdown = [this]() {
+        return shutdown_ || !frames_.empty();
+      };
+      frames_lock_.Await(absl::Condition(&has_frames_or_shutdown));
+      frames.swap(frames_);
+      shutdown = shutdown_;
+    }
+
+    for (std::string const& frame : frames) {
+      std::string const* data = &frame;
+      if (compressor_ != nullptr) {
+        compressed_frame.clear();
+        compressor_->Compress(frame, &compressed_frame);
+        data = &compressed_frame;
+      }
+      std::uint32_t const size = data->size();
+      char const length[4] = {static_cast<char>(size),
+                              static_cast<char>(size >> 8),
+                              static_cast<char>(size >> 16),
+                              static_cast<char>(size >> 24)};
+      CHECK_EQ(sizeof(length), std::fwrite(length, 1, sizeof(length), file_));
+      CHECK_EQ(data->size(), std::fwrite(data->data(), 1, data->size(), file_));
+    }
+    frames.clear();
+    CHECK_EQ(0, std::fflush(file_));
+
+    auto const now = std::chrono::steady_clock::now();
+    if (shutdown || now - last_sync >= sync_period) {
+      Sync(file_);
+      last_sync = now;
+    }
+    if (shutdown) {
+      break;
+    }
+  }
+}
+
 Recorder* Recorder::active_recorder_ = nullptr;
 
 }  // namespace internal
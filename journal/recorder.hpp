@@ -1,10 +1,18 @@
 #pragma once
 
+#include <cstdint>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "absl/synchronization/mutex.h"
 #include "base/not_null.hpp"
+#include "gipfeli/compression.h"
 #include "serialization/journal.pb.h"
 
 namespace principia {
@@ -19,9 +27,40 @@ namespace internal {
 
 using namespace principia::base::_not_null;
 
+// A binary journal starts with this string, followed by one byte giving the
+// |Compression| of the frames.  Then comes a sequence of frames, each of which
+// is a 32-bit little-endian length followed by that many bytes containing a
+// serialized (and possibly compressed) |serialization::Method|.  Note that the
+// first character of the header is not a hexadecimal digit, which makes it
+// possible to distinguish binary and hexadecimal journals.
+constexpr std::string_view binary_journal_header = "PRINCIPIA JOURNAL\n";
+
+enum class Compression : std::uint8_t {
+  None = 0,
+  Gipfeli = 1,
+};
+
 class Recorder final {
  public:
-  explicit Recorder(std::filesystem::path const& path);
+  enum class Format {
+    // One hexadecimal-encoded message per line, written and flushed
+    // synchronously by the thread that makes the interface call.  The journal
+    // is complete even if the process crashes, but the interface calls are
+    // serialized behind the I/O.
+    Hexadecimal,
+    // Length-prefixed binary frames, written by a background thread and
+    // synced to disk periodically.  Much cheaper for the caller, but the last
+    // frames may be lost if the process crashes.
+    Binary,
+    // Same as |Binary|, but the frames are compressed using gipfeli.
+    GipfeliBinary,
+  };
+
+  explicit Recorder(std::filesystem::path const& path,
+                    Format format = Format::Hexadecimal);
+
+  // Writes all the pending frames to disk before returning.
+  ~Recorder();
 
   // Locking is used to ensure that the pairs of writes don't get intermixed.
   void WriteAtConstruction(serialization::Method const& method);
@@ -34,9 +73,25 @@ class Recorder final {
  private:
   void WriteLocked(serialization::Method const& method);
 
+  // The loop executed by |writer_| for binary formats.
+  void WriteFramesAndSync();
+
+  Format const format_;
+
   absl::Mutex lock_;
   std::ofstream stream_;
 
+  // Used for binary formats only.  The frames are serialized under |lock_| and
+  // handed over to |writer_| which compresses them, writes them to |file_| and
+  // syncs |file_| periodically.  |frames_lock_| is only held for the duration
+  // of a push or a swap.
+  std::unique_ptr<google::compression::Compressor> compressor_;
+  std::FILE* file_ = nullptr;
+  absl::Mutex frames_lock_;
+  std::vector<std::string> frames_ GUARDED_BY(frames_lock_);
+  bool shutdown_ GUARDED_BY(frames_lock_) = false;
+  std::thread writer_;
+
   static Recorder* active_recorder_;
 
   template<typename>
@@ -45,6 +100,8 @@ class Recorder final {
 
 }  // namespace internal
 
+using internal::binary_journal_header;
+using internal::Compression;
 using internal::Recorder;
 
 }  // namespace _recorder
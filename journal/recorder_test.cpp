@@ -146,5 +146,43 @@ TEST_F(RecorderTest, Recording) {
   }
 }
 
+TEST_F(RecorderTest, Binary) {
+  for (auto const format : {Recorder::Format::Binary,
+                            Recorder::Format::GipfeliBinary}) {
+    std::string const path = test_name_ + ".journal.bin";
+    {
+      Recorder recorder(path, format);
+      for (int i = 0; i < 1000; ++i) {
+        serialization::Method method_in;
+        auto* const in = method_in.MutableExtension(
+            serialization::NewPlugin::extension)->mutable_in();
+        in->set_game_epoch("1 s");
+        in->set_solar_system_epoch("2 s");
+        in->set_planetarium_rotation_in_degrees(i);
+        recorder.WriteAtConstruction(method_in);
+        serialization::Method method_out_return;
+        method_out_return.MutableExtension(
+            serialization::NewPlugin::extension)->mutable_return_()->
+                set_result(i + 1);
+        recorder.WriteAtDestruction(method_out_return);
+      }
+    }
+
+    std::vector<serialization::Method> const methods = ReadAll(path);
+    ASSERT_EQ(2000, methods.size());
+    for (int i = 0; i < 1000; ++i) {
+      auto const& extension_in =
+          methods[2 * i].GetExtension(serialization::NewPlugin::extension);
+      EXPECT_EQ("1 s", extension_in.in().game_epoch());
+      EXPECT_EQ("2 s", extension_in.in().solar_system_epoch());
+      EXPECT_EQ(i, extension_in.in().planetarium_rotation_in_degrees());
+      auto const& extension_out_return =
+          methods[2 * i + 1].GetExtension(serialization::NewPlugin::extension);
+      EXPECT_FALSE(extension_out_return.has_in());
+      EXPECT_EQ(i + 1, extension_out_return.return_().result());
+    }
+  }
+}
+
 }  // namespace journal
 }  // namespace principia
@@ -22,6 +22,7 @@
 #include "astronomy/time_scales.hpp"
 #include "base/array.hpp"
 #include "base/base64.hpp"
+#include "base/compressor_registry.hpp"
 #include "base/encoder.hpp"
 #include "base/fingerprint2011.hpp"
 #include "base/flags.hpp"
@@ -33,7 +34,6 @@
 #include "base/push_deserializer.hpp"
 #include "base/serialization.hpp"
 #include "base/version.hpp"
-#include "gipfeli/gipfeli.h"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/quaternion.hpp"
@@ -69,6 +69,7 @@ using namespace principia::astronomy::_epoch;
 using namespace principia::astronomy::_time_scales;
 using namespace principia::base::_array;
 using namespace principia::base::_base64;
+using namespace principia::base::_compressor_registry;
 using namespace principia::base::_encoder;
 using namespace principia::base::_fingerprint2011;
 using namespace principia::base::_flags;
@@ -111,8 +112,6 @@ using namespace principia::quantities::_si;
 
 namespace {
 
-constexpr char gipfeli_compressor[] = "gipfeli";
-
 constexpr char base64_encoder[] = "base64";
 constexpr char hexadecimal_encoder[] = "hexadecimal";
 
@@ -268,17 +267,6 @@ serialization::GravityModel::Body MakeGravityModel(
   return gravity_model;
 }
 
-std::unique_ptr<google::compression::Compressor> NewCompressor(
-    std::string_view const compressor) {
-  if (compressor.empty()) {
-    return nullptr;
-  } else if (compressor == gipfeli_compressor) {
-    return google::compression::NewGipfeliCompressor();
-  } else {
-    LOG(FATAL) << "Unknown compressor " << compressor;
-  }
-}
-
 Encoder<char, /*null_terminated=*/true>*
 NewEncoder(std::string_view const encoder) {
   if (encoder == hexadecimal_encoder) {
@@ -294,6 +282,41 @@ NewEncoder(std::string_view const encoder) {
   }
 }
 
+// Returns a started deserializer which fills |*plugin| when the deserialization
+// is complete.
+not_null<PushDeserializer*> NewPluginDeserializer(
+    Plugin const** const plugin,
+    std::string_view const compressor) {
+  LOG(INFO) << "Begin plugin deserialization";
+  auto* const deserializer = new PushDeserializer(chunk_size,
+                                                  number_of_chunks,
+                                                  NewCompressor(compressor));
+  not_null<serialization::Plugin*> const message =
+      Arena::CreateMessage<serialization::Plugin>(arena);
+  deserializer->Start(
+      message,
+      [plugin](google::protobuf::Message const& message) {
+        *plugin = Plugin::ReadFromMessage(
+            static_cast<serialization::Plugin const&>(message)).release();
+      });
+  return deserializer;
+}
+
+// Returns a started serializer for |plugin|.
+not_null<PullSerializer*> NewPluginSerializer(
+    Plugin const& plugin,
+    std::string_view const compressor) {
+  LOG(INFO) << "Begin plugin serialization";
+  auto* const serializer = new PullSerializer(chunk_size,
+                                              number_of_chunks,
+                                              NewCompressor(compressor));
+  not_null<serialization::Plugin*> const message =
+      Arena::CreateMessage<serialization::Plugin>(arena);
+  plugin.WriteToMessage(message);
+  serializer->Start(message);
+  return serializer;
+}
+
 }  // namespace
 
 void __cdecl principia__ActivatePlayer() {
@@ -304,7 +327,9 @@ void __cdecl principia__ActivatePlayer() {
 // activate it.  If |activate| is false and there is an active journal,
 // deactivate it.  Does nothing if there is already a journal in the desired
 // state.  |verbose| causes methods to be output in the INFO log before being
-// executed.
+// executed.  The journal is hexadecimal unless the flag |journal| is set to
+// |binary| or |gipfeli|, in which case it is written asynchronously in a binary
+// format, possibly compressed.
 void __cdecl principia__ActivateRecorder(bool const activate) {
   // NOTE: Do not journal!  You'd end up with half a message in the journal and
   // that would cause trouble.
@@ -315,8 +340,14 @@ void __cdecl principia__ActivateRecorder(bool const activate) {
     std::tm* const localtime = std::localtime(&time);
     std::stringstream name;
     name << std::put_time(localtime, "JOURNAL.%Y%m%d-%H%M%S");
+    Recorder::Format format = Recorder::Format::Hexadecimal;
+    if (Flags::IsPresent("journal", "binary")) {
+      format = Recorder::Format::Binary;
+    } else if (Flags::IsPresent("journal", "gipfeli")) {
+      format = Recorder::Format::GipfeliBinary;
+    }
     Recorder* const recorder = new Recorder(
-        std::filesystem::path("glog") / "Principia" / name.str());
+        std::filesystem::path("glog") / "Principia" / name.str(), format);
     Vessel::MakeSynchronous();
     Recorder::Activate(recorder);
   } else if (!activate && Recorder::IsActivated()) {
@@ -536,19 +567,7 @@ void __cdecl principia__DeserializePlugin(
 
   // Create and start a deserializer if the caller didn't provide one.
   if (*deserializer == nullptr) {
-    LOG(INFO) << "Begin plugin deserialization";
-    *deserializer = new PushDeserializer(chunk_size,
-                                         number_of_chunks,
-                                         NewCompressor(compressor));
-    CHECK_NOTNULL(arena);
-    not_null<serialization::Plugin*> const message =
-        Arena::CreateMessage<serialization::Plugin>(arena);
-    (*deserializer)->Start(
-        message,
-        [plugin](google::protobuf::Message const& message) {
-          *plugin = Plugin::ReadFromMessage(
-              static_cast<serialization::Plugin const&>(message)).release();
-        });
+    *deserializer = NewPluginDeserializer(plugin, compressor);
   }
 
   // Decode the representation.
@@ -567,6 +586,43 @@ void __cdecl principia__DeserializePlugin(
   return m.Return();
 }
 
+// Same as |principia__DeserializePlugin|, but for the chunks of bytes produced
+// by |principia__SerializePluginBytes|: there is no decoding and no copy.  The
+// chunks must be passed with the boundaries they had when they were produced.
+// No transfer of ownership of |*bytes|, which must remain valid until the last
+// call (with |size| set to 0) returns.  Not journalled, because the journal
+// would have to copy the bytes; this is meant for callers that store binary
+// data, not for the adapter.  Since a replay could not create the plugin, this
+// function must not be called while the recorder is active.
+void __cdecl principia__DeserializePluginBytes(
+    std::uint8_t const* const bytes,
+    int const size,
+    PushDeserializer** const deserializer,
+    Plugin const** const plugin,
+    char const* const compressor) {
+  CHECK(!Recorder::IsActivated())
+      << "Plugin deserialization from bytes cannot be journalled";
+  CHECK_NOTNULL(deserializer);
+  CHECK_NOTNULL(plugin);
+  CHECK_LE(0, size);
+  CHECK(size == 0 || bytes != nullptr);
+
+  if (*deserializer == nullptr) {
+    *deserializer = NewPluginDeserializer(plugin, compressor);
+  }
+
+  // The deserializer doesn't write to the bytes that it is given.
+  (*deserializer)->Push(Array<std::uint8_t>(const_cast<std::uint8_t*>(bytes),
+                                            size),
+                        /*done=*/nullptr);
+
+  if (size == 0) {
+    LOG(INFO) << "End plugin deserialization";
+    TakeOwnership(deserializer);
+    arena->Reset();
+  }
+}
+
 // Calls |plugin->EndInitialization|.
 // |plugin| must not be null.  No transfer of ownership.
 void __cdecl principia__EndInitialization(Plugin* const plugin) {
@@ -1064,14 +1120,7 @@ char const* __cdecl principia__SerializePlugin(
 
   // Create and start a serializer if the caller didn't provide one.
   if (*serializer == nullptr) {
-    LOG(INFO) << "Begin plugin serialization";
-    *serializer = new PullSerializer(chunk_size,
-                                     number_of_chunks,
-                                     NewCompressor(compressor));
-    not_null<serialization::Plugin*> const message =
-        Arena::CreateMessage<serialization::Plugin>(arena);
-    plugin->WriteToMessage(message);
-    (*serializer)->Start(message);
+    *serializer = NewPluginSerializer(*plugin, compressor);
   }
 
   // Pull a chunk.
@@ -1111,6 +1160,38 @@ char const* __cdecl principia__SerializePlugin(
   return m.Return(hexadecimal.data.release());
 }
 
+// Same as |principia__SerializePlugin|, but returns the chunks of bytes
+// produced by the serializer without encoding them.  The result points into
+// the buffers of |*serializer| and is only valid until the next call; its
+// size is stored in |*size|.  No transfer of ownership.  Returns null and sets
+// |*size| to 0 at the end of the stream.  Not journalled and must not be called
+// while the recorder is active, see |principia__DeserializePluginBytes|.
+std::uint8_t const* __cdecl principia__SerializePluginBytes(
+    Plugin const* const plugin,
+    PullSerializer** const serializer,
+    char const* const compressor,
+    int* const size) {
+  CHECK(!Recorder::IsActivated())
+      << "Plugin serialization to bytes cannot be journalled";
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(serializer);
+  CHECK_NOTNULL(size);
+
+  if (*serializer == nullptr) {
+    *serializer = NewPluginSerializer(*plugin, compressor);
+  }
+
+  Array<std::uint8_t> const bytes = (*serializer)->Pull();
+  *size = static_cast<int>(bytes.size);
+  if (bytes.size == 0) {
+    LOG(INFO) << "End plugin serialization";
+    TakeOwnership(serializer);
+    arena->Reset();
+    return nullptr;
+  }
+  return bytes.data;
+}
+
 // Sets the maximum number of seconds which logs may be buffered for.
 void __cdecl principia__SetBufferDuration(int const seconds) {
   journal::Method<journal::SetBufferDuration> m({seconds});
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <typeindex>
 #include <type_traits>
@@ -19,6 +20,7 @@
 #include "ksp_plugin/iterators.hpp"
 #include "ksp_plugin/pile_up.hpp"
 #include "ksp_plugin/planetarium.hpp"
+#include "ksp_plugin/plot_batch.hpp"
 #include "ksp_plugin/plugin.hpp"
 #include "ksp_plugin/vessel.hpp"
 #include "physics/degrees_of_freedom.hpp"
@@ -46,6 +48,7 @@ using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_iterators;
 using namespace principia::ksp_plugin::_pile_up;
 using namespace principia::ksp_plugin::_planetarium;
+using namespace principia::ksp_plugin::_plot_batch;
 using namespace principia::ksp_plugin::_plugin;
 using namespace principia::ksp_plugin::_vessel;
 using namespace principia::physics::_degrees_of_freedom;
@@ -72,9 +75,26 @@ void __cdecl principia__ActivatePlayer();
 extern "C" PRINCIPIA_DLL
 void __cdecl principia__ActivateRecorder(bool activate);
 
+// The functions that (de)serialize the plugin to (from) bytes are not
+// journalled, so they must not be called while the recorder is active.
+extern "C" PRINCIPIA_DLL
+void __cdecl principia__DeserializePluginBytes(
+    std::uint8_t const* bytes,
+    int size,
+    PushDeserializer** deserializer,
+    Plugin const** plugin,
+    char const* compressor);
+
 extern "C" PRINCIPIA_DLL
 void __cdecl principia__InitGoogleLogging();
 
+extern "C" PRINCIPIA_DLL
+std::uint8_t const* __cdecl principia__SerializePluginBytes(
+    Plugin const* plugin,
+    PullSerializer** serializer,
+    char const* compressor,
+    int* size);
+
 bool operator==(AdaptiveStepParameters const& left,
                 AdaptiveStepParameters const& right);
 bool operator==(Burn const& left, Burn const& right);
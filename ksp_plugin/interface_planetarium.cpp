@@ -1,7 +1,6 @@
 #include "ksp_plugin/interface.hpp"
 
 #include <algorithm>
-#include <limits>
 
 #include "geometry/affine_map.hpp"
 #include "geometry/grassmann.hpp"
@@ -15,6 +14,7 @@
 #include "journal/profiles.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/iterators.hpp"
+#include "ksp_plugin/plot_batch.hpp"
 #include "ksp_plugin/renderer.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/rigid_motion.hpp"
@@ -34,11 +34,29 @@ using namespace principia::geometry::_space_transformations;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_iterators;
 using namespace principia::ksp_plugin::_planetarium;
+using namespace principia::ksp_plugin::_plot_batch;
 using namespace principia::ksp_plugin::_renderer;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
+namespace {
+
+// Copies the vertices computed for |request| into the array of size
+// |vertices_size| at |vertices|.
+void GetVertices(PlotBatch const& batch,
+                 int const request,
+                 ScaledSpacePoint* const vertices,
+                 int const vertices_size,
+                 int* const vertex_count) {
+  auto const& batch_vertices = batch.vertices(request);
+  CHECK_LE(batch_vertices.size(), vertices_size);
+  std::copy(batch_vertices.begin(), batch_vertices.end(), vertices);
+  *vertex_count = batch_vertices.size();
+}
+
+}  // namespace
+
 Planetarium* __cdecl principia__PlanetariumCreate(
     Plugin const* const plugin,
     XYZ const sun_world_position,
@@ -136,27 +154,12 @@ void __cdecl principia__PlanetariumPlotFlightPlanSegment(
       {vertex_count});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
-
-  Vessel const& vessel = *plugin->GetVessel(vessel_guid);
-  CHECK(vessel.has_flight_plan()) << vessel_guid;
-  auto const segment = vessel.flight_plan().GetSegment(index);
-  // TODO(egg): this is ugly; we should centralize rendering.
-  // If this is a burn and we cannot render the beginning of the burn, we
-  // render none of it, otherwise we try to render the Frenet trihedron at the
-  // start and we fail.
-  if (index % 2 == 0 ||
-      segment->empty() ||
-      segment->front().time >= plugin->renderer().GetPlottingFrame()->t_min()) {
-    planetarium->PlotMethod3(
-        *segment, segment->begin(), segment->end(),
-        plugin->CurrentTime(),
-        /*reverse=*/false,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size);
-  }
+
+  PlotBatch batch(planetarium, plugin);
+  int const request =
+      batch.AddFlightPlanSegment(vessel_guid, index, vertices_size);
+  batch.Run();
+  GetVertices(batch, request, vertices, vertices_size, vertex_count);
   return m.Return();
 }
 
@@ -174,17 +177,11 @@ void __cdecl principia__PlanetariumPlotPrediction(
       {vertex_count});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
-
-  auto const prediction = plugin->GetVessel(vessel_guid)->prediction();
-  planetarium->PlotMethod3(
-      *prediction, prediction->begin(), prediction->end(),
-      plugin->CurrentTime(),
-      /*reverse=*/false,
-      [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-        vertices[(*vertex_count)++] = vertex;
-      },
-      vertices_size);
+
+  PlotBatch batch(planetarium, plugin);
+  int const request = batch.AddPrediction(vessel_guid, vertices_size);
+  batch.Run();
+  GetVertices(batch, request, vertices, vertices_size, vertex_count);
   return m.Return();
 }
 
@@ -210,37 +207,13 @@ void __cdecl principia__PlanetariumPlotPsychohistory(
       {vertex_count});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
-
-  // Do not plot the psychohistory when there is a target vessel as it is
-  // misleading.
-  if (plugin->renderer().HasTargetVessel()) {
-    return m.Return();
-  } else {
-    auto const vessel = plugin->GetVessel(vessel_guid);
-    auto const& trajectory = vessel->trajectory();
-    auto const& psychohistory = vessel->psychohistory();
-
-    Instant const desired_first_time =
-        plugin->CurrentTime() - max_history_length * Second;
-
-    // Since we would want to plot starting from |desired_first_time|, ask the
-    // reanimator to reconstruct the past.  That may take a while, during which
-    // time the history will be shorter than desired.
-    vessel->RequestReanimation(desired_first_time);
-
-    planetarium->PlotMethod3(
-        trajectory,
-        trajectory.lower_bound(desired_first_time),
-        psychohistory->end(),
-        /*now=*/plugin->CurrentTime(),
-        /*reverse=*/true,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size);
-    return m.Return();
-  }
+
+  PlotBatch batch(planetarium, plugin);
+  int const request = batch.AddPsychohistory(
+      vessel_guid, max_history_length * Second, vertices_size);
+  batch.Run();
+  GetVertices(batch, request, vertices, vertices_size, vertex_count);
+  return m.Return();
 }
 
 // Fills the array of size |vertices_size| at |vertices| with vertices for the
@@ -266,40 +239,15 @@ void __cdecl principia__PlanetariumPlotCelestialPastTrajectory(
       {minimal_distance_from_camera, vertex_count});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
-
-  // Do not plot the past when there is a target vessel as it is misleading.
-  if (plugin->renderer().HasTargetVessel()) {
-    *minimal_distance_from_camera = std::numeric_limits<double>::infinity();
-    return m.Return();
-  } else {
-    auto const& celestial_trajectory =
-        plugin->GetCelestial(celestial_index).trajectory();
-    Instant const desired_first_time =
-        plugin->CurrentTime() - max_history_length * Second;
-
-    // Since we would want to plot starting from |desired_first_time|, ask the
-    // reanimator to reconstruct the past.  That may take a while, during which
-    // time the history will be shorter than desired.
-    plugin->RequestReanimation(desired_first_time);
-
-    Instant const first_time =
-        std::max(desired_first_time, celestial_trajectory.t_min());
-    Length minimal_distance;
-    planetarium->PlotMethod3(
-        celestial_trajectory,
-        first_time,
-        /*last_time=*/plugin->CurrentTime(),
-        /*now=*/plugin->CurrentTime(),
-        /*reverse=*/true,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size,
-        &minimal_distance);
-    *minimal_distance_from_camera = minimal_distance / Metre;
-    return m.Return();
-  }
+
+  PlotBatch batch(planetarium, plugin);
+  int const request = batch.AddCelestialPastTrajectory(
+      celestial_index, max_history_length * Second, vertices_size);
+  batch.Run();
+  GetVertices(batch, request, vertices, vertices_size, vertex_count);
+  *minimal_distance_from_camera =
+      batch.minimal_distance_from_camera(request) / Metre;
+  return m.Return();
 }
 
 // Fills the array of size |vertices_size| at |vertices| with vertices for the
@@ -325,40 +273,127 @@ void __cdecl principia__PlanetariumPlotCelestialFutureTrajectory(
       {minimal_distance_from_camera, vertex_count});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
-
-  // Do not plot the past when there is a target vessel as it is misleading.
-  // TODO(egg): This is the future, not the past!
-  if (plugin->renderer().HasTargetVessel()) {
-    *minimal_distance_from_camera = std::numeric_limits<double>::infinity();
-    return m.Return();
-  } else {
-    auto const& vessel = *plugin->GetVessel(vessel_guid);
-    Instant const prediction_final_time = vessel.prediction()->t_max();
-    Instant const final_time =
-        vessel.has_flight_plan()
-            ? std::max(vessel.flight_plan().actual_final_time(),
-                       prediction_final_time)
-            : prediction_final_time;
-    auto const& celestial_trajectory =
-        plugin->GetCelestial(celestial_index).trajectory();
-    // No need to request reanimation here because the current time of the
-    // plugin is necessarily covered.
-    Length minimal_distance;
-    planetarium->PlotMethod3(
-        celestial_trajectory,
-        /*first_time=*/plugin->CurrentTime(),
-        /*last_time=*/final_time,
-        /*now=*/plugin->CurrentTime(),
-        /*reverse=*/false,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size,
-        &minimal_distance);
-    *minimal_distance_from_camera = minimal_distance / Metre;
-    return m.Return();
-  }
+
+  PlotBatch batch(planetarium, plugin);
+  int const request = batch.AddCelestialFutureTrajectory(
+      celestial_index, vessel_guid, vertices_size);
+  batch.Run();
+  GetVertices(batch, request, vertices, vertices_size, vertex_count);
+  *minimal_distance_from_camera =
+      batch.minimal_distance_from_camera(request) / Metre;
+  return m.Return();
+}
+
+// The following functions make it possible to plot many trajectories
+// concurrently: the requests are added to a batch, which is then run, and the
+// vertices are retrieved afterwards.  The results of a request are identical
+// to those of the corresponding |principia__PlanetariumPlot*| function above.
+// The batch must be deleted before the planetarium.
+
+PlotBatch* __cdecl principia__PlanetariumPlotBatchCreate(
+    Planetarium const* const planetarium,
+    Plugin const* const plugin) {
+  journal::Method<journal::PlanetariumPlotBatchCreate> m({planetarium, plugin});
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(planetarium);
+  return m.Return(new PlotBatch(planetarium, plugin));
+}
+
+void __cdecl principia__PlanetariumPlotBatchDelete(PlotBatch** const batch) {
+  journal::Method<journal::PlanetariumPlotBatchDelete> m({batch}, {batch});
+  CHECK_NOTNULL(batch);
+  TakeOwnership(batch);
+  return m.Return();
+}
+
+// Each of these functions adds a request to plot at most |max_vertices|
+// vertices to the batch, and returns the index of the request.
+int __cdecl principia__PlanetariumPlotBatchAddCelestialFutureTrajectory(
+    PlotBatch* const batch,
+    int const celestial_index,
+    char const* const vessel_guid,
+    int const max_vertices) {
+  journal::Method<journal::PlanetariumPlotBatchAddCelestialFutureTrajectory> m(
+      {batch, celestial_index, vessel_guid, max_vertices});
+  CHECK_NOTNULL(batch);
+  return m.Return(batch->AddCelestialFutureTrajectory(
+      celestial_index, vessel_guid, max_vertices));
+}
+
+int __cdecl principia__PlanetariumPlotBatchAddCelestialPastTrajectory(
+    PlotBatch* const batch,
+    int const celestial_index,
+    double const max_history_length,
+    int const max_vertices) {
+  journal::Method<journal::PlanetariumPlotBatchAddCelestialPastTrajectory> m(
+      {batch, celestial_index, max_history_length, max_vertices});
+  CHECK_NOTNULL(batch);
+  return m.Return(batch->AddCelestialPastTrajectory(
+      celestial_index, max_history_length * Second, max_vertices));
+}
+
+int __cdecl principia__PlanetariumPlotBatchAddFlightPlanSegment(
+    PlotBatch* const batch,
+    char const* const vessel_guid,
+    int const index,
+    int const max_vertices) {
+  journal::Method<journal::PlanetariumPlotBatchAddFlightPlanSegment> m(
+      {batch, vessel_guid, index, max_vertices});
+  CHECK_NOTNULL(batch);
+  return m.Return(
+      batch->AddFlightPlanSegment(vessel_guid, index, max_vertices));
+}
+
+int __cdecl principia__PlanetariumPlotBatchAddPrediction(
+    PlotBatch* const batch,
+    char const* const vessel_guid,
+    int const max_vertices) {
+  journal::Method<journal::PlanetariumPlotBatchAddPrediction> m(
+      {batch, vessel_guid, max_vertices});
+  CHECK_NOTNULL(batch);
+  return m.Return(batch->AddPrediction(vessel_guid, max_vertices));
+}
+
+int __cdecl principia__PlanetariumPlotBatchAddPsychohistory(
+    PlotBatch* const batch,
+    char const* const vessel_guid,
+    double const max_history_length,
+    int const max_vertices) {
+  journal::Method<journal::PlanetariumPlotBatchAddPsychohistory> m(
+      {batch, vessel_guid, max_history_length, max_vertices});
+  CHECK_NOTNULL(batch);
+  return m.Return(batch->AddPsychohistory(
+      vessel_guid, max_history_length * Second, max_vertices));
+}
+
+// Plots the trajectories of all the requests added since the last call, using
+// multiple threads.  Returns when all the vertices have been computed.
+void __cdecl principia__PlanetariumPlotBatchRun(PlotBatch* const batch) {
+  journal::Method<journal::PlanetariumPlotBatchRun> m({batch});
+  CHECK_NOTNULL(batch);
+  batch->Run();
+  return m.Return();
+}
+
+// Fills the array of size |vertices_size| at |vertices| with the vertices
+// computed for the given request, which must have been run.  The minimal
+// distance from the camera is only computed for the celestial trajectories,
+// and is infinite otherwise.
+void __cdecl principia__PlanetariumPlotBatchGetVertices(
+    PlotBatch const* const batch,
+    int const request,
+    ScaledSpacePoint* const vertices,
+    int const vertices_size,
+    double* const minimal_distance_from_camera,
+    int* const vertex_count) {
+  journal::Method<journal::PlanetariumPlotBatchGetVertices> m(
+      {batch, request, vertices, vertices_size},
+      {minimal_distance_from_camera, vertex_count});
+  CHECK_NOTNULL(batch);
+  GetVertices(*batch, request, vertices, vertices_size, vertex_count);
+  *minimal_distance_from_camera =
+      batch->minimal_distance_from_camera(request) / Metre;
+  return m.Return();
 }
 
 }  // namespace interface
@@ -28,8 +28,37 @@ using namespace principia::quantities::_quantities;
 
 namespace {
 constexpr int max_plot_method_2_steps = 10'000;
+// A plot that is not used by this number of consecutive planetaria is
+// forgotten.
+constexpr std::int64_t max_unused_plot_generations = 16;
+// A plot is recomputed if the distance from the camera to some of its points
+// changed by more than this factor since they were computed.
+constexpr double max_squared_distance_ratio = 4;
 }  // namespace
 
+void PlotCache::Clear() {
+  absl::MutexLock l(&lock_);
+  plots_.clear();
+}
+
+void PlotCache::NewGeneration() {
+  absl::MutexLock l(&lock_);
+  ++generation_;
+  std::erase_if(plots_, [this](auto const& key_and_plot) {
+    lock_.AssertHeld();
+    return key_and_plot.second.last_generation <
+           generation_ - max_unused_plot_generations;
+  });
+}
+
+PlotCache::Plot& PlotCache::GetPlot(Trajectory<Barycentric> const& trajectory,
+                                    bool const reverse) {
+  absl::MutexLock l(&lock_);
+  auto& plot = plots_[{&trajectory, reverse}];
+  plot.last_generation = generation_;
+  return plot;
+}
+
 Planetarium::Parameters::Parameters(double const sphere_radius_multiplier,
                                     Angle const& angular_resolution,
                                     Angle const& field_of_view)
@@ -43,12 +72,18 @@ Planetarium::Planetarium(
     Perspective<Navigation, Camera> perspective,
     not_null<Ephemeris<Barycentric> const*> const ephemeris,
     not_null<PlottingFrame const*> const plotting_frame,
-    PlottingToScaledSpaceConversion plotting_to_scaled_space)
+    PlottingToScaledSpaceConversion plotting_to_scaled_space,
+    PlotCache* const plot_cache)
     : parameters_(parameters),
       perspective_(std::move(perspective)),
       ephemeris_(ephemeris),
       plotting_frame_(plotting_frame),
-      plotting_to_scaled_space_(std::move(plotting_to_scaled_space)) {}
+      plotting_to_scaled_space_(std::move(plotting_to_scaled_space)),
+      plot_cache_(plot_cache) {
+  if (plot_cache_ != nullptr) {
+    plot_cache_->NewGeneration();
+  }
+}
 
 RP2Lines<Length, Camera> Planetarium::PlotMethod0(
     DiscreteTrajectory<Barycentric> const& trajectory,
@@ -299,87 +334,264 @@ void Planetarium::PlotMethod3(
   double const tan²_angular_resolution =
       Pow<2>(parameters_.tan_angular_resolution_);
   auto const final_time = reverse ? first_time : last_time;
-  auto previous_time = reverse ? last_time : first_time;
+  auto const initial_time = reverse ? last_time : first_time;
 
   if (minimal_distance != nullptr) {
     *minimal_distance = Infinity<Length>;
   }
 
   Sign const direction = reverse ? Sign::Negative() : Sign::Positive();
-  if (direction * (final_time - previous_time) <= Time{}) {
+  if (direction * (final_time - initial_time) <= Time{}) {
     return;
   }
-  SimilarMotion<Barycentric, Navigation> to_plotting_frame_at_t =
-      plotting_frame_->ToThisFrameAtTimeSimilarly(previous_time);
-  DegreesOfFreedom<Navigation> const initial_degrees_of_freedom =
-      to_plotting_frame_at_t(
-          trajectory.EvaluateDegreesOfFreedom(previous_time));
-  Position<Navigation> previous_position =
-      initial_degrees_of_freedom.position();
-  Velocity<Navigation> previous_velocity =
-      initial_degrees_of_freedom.velocity();
-  Time Δt = final_time - previous_time;
+  Square<Length> minimal_squared_distance = Infinity<Square<Length>>;
 
-  add_point(plotting_to_scaled_space_(previous_position));
-  int points_added = 1;
+  if (plot_cache_ != nullptr) {
+    auto& plot = plot_cache_->GetPlot(trajectory, reverse);
+    UpdatePlot(trajectory, first_time, last_time, reverse, max_points, plot);
+    auto const& points = plot.points;
+    int const size = std::min<int>(points.size(), max_points);
+    for (int i = 0; i < size; ++i) {
+      auto const& position =
+          points[reverse ? points.size() - 1 - i : i].position;
+      add_point(plotting_to_scaled_space_(position));
+      if (minimal_distance != nullptr && i > 0) {
+        minimal_squared_distance =
+            std::min(minimal_squared_distance,
+                     perspective_.SquaredDistanceFromCamera(position));
+      }
+    }
+  } else {
+    PlotPoint previous = ComputePlotPoint(trajectory, initial_time);
+    Time Δt = final_time - initial_time;
+    std::optional<double> estimated_tan²_error;
+
+    add_point(plotting_to_scaled_space_(previous.position));
+    int points_added = 1;
+
+    while (points_added < max_points &&
+           direction * (previous.time - final_time) < Time{}) {
+      previous = ComputeNextPlotPoint(trajectory,
+                                      previous,
+                                      final_time,
+                                      tan²_angular_resolution,
+                                      Δt,
+                                      estimated_tan²_error);
+
+      add_point(plotting_to_scaled_space_(previous.position));
+      ++points_added;
+
+      if (minimal_distance != nullptr) {
+        minimal_squared_distance =
+            std::min(minimal_squared_distance,
+                     perspective_.SquaredDistanceFromCamera(previous.position));
+      }
+    }
+  }
+  if (minimal_distance != nullptr) {
+    *minimal_distance = Sqrt(minimal_squared_distance);
+  }
+}
+
+Planetarium::PlotPoint Planetarium::ComputePlotPoint(
+    Trajectory<Barycentric> const& trajectory,
+    Instant const& t) const {
+  SimilarMotion<Barycentric, Navigation> const to_plotting_frame_at_t =
+      plotting_frame_->ToThisFrameAtTimeSimilarly(t);
+  DegreesOfFreedom<Barycentric> const degrees_of_freedom_in_barycentric =
+      trajectory.EvaluateDegreesOfFreedom(t);
+  DegreesOfFreedom<Navigation> const degrees_of_freedom =
+      to_plotting_frame_at_t(degrees_of_freedom_in_barycentric);
+  return {t,
+          degrees_of_freedom_in_barycentric.position(),
+          degrees_of_freedom.position(),
+          degrees_of_freedom.velocity()};
+}
 
+Planetarium::PlotPoint Planetarium::ComputeNextPlotPoint(
+    Trajectory<Barycentric> const& trajectory,
+    PlotPoint const& previous,
+    Instant const& final_time,
+    double const tan²_angular_resolution,
+    Time& Δt,
+    std::optional<double>& estimated_tan²_error) const {
+  Sign const direction(final_time - previous.time);
   Instant t;
-  double estimated_tan²_error;
+  std::optional<SimilarMotion<Barycentric, Navigation>> to_plotting_frame_at_t;
   std::optional<DegreesOfFreedom<Barycentric>>
       degrees_of_freedom_in_barycentric;
   Position<Navigation> position;
-  Square<Length> minimal_squared_distance = Infinity<Square<Length>>;
+  do {
+    if (estimated_tan²_error.has_value()) {
+      // One square root because we have squared errors, another one because
+      // the errors are quadratic in time (in other words, two square roots
+      // because the squared errors are quartic in time).
+      // A safety factor prevents catastrophic retries.
+      Δt *= 0.9 * Sqrt(Sqrt(tan²_angular_resolution / *estimated_tan²_error));
+    }
+    t = previous.time + Δt;
+    if (direction * (t - final_time) > Time{}) {
+      t = final_time;
+      Δt = t - previous.time;
+    }
+    Position<Navigation> const extrapolated_position =
+        previous.position + previous.velocity * Δt;
+    to_plotting_frame_at_t = plotting_frame_->ToThisFrameAtTimeSimilarly(t);
+    degrees_of_freedom_in_barycentric = trajectory.EvaluateDegreesOfFreedom(t);
+    position = to_plotting_frame_at_t->similarity()(
+                   degrees_of_freedom_in_barycentric->position());
+
+    // The quadratic term of the error between the linear interpolation and the
+    // actual function is maximized halfway through the segment, so it is
+    // 1/2 (Δt/2)² f″(t-Δt) = (1/2 Δt² f″(t-Δt)) / 4; the squared error is thus
+    // (1/2 Δt² f″(t-Δt))² / 16.
+    estimated_tan²_error =
+        perspective_.Tan²AngularDistance(extrapolated_position, position) / 16;
+  } while (*estimated_tan²_error > tan²_angular_resolution);
+
+  return {t,
+          degrees_of_freedom_in_barycentric->position(),
+          position,
+          (*to_plotting_frame_at_t)(*degrees_of_freedom_in_barycentric)
+              .velocity()};
+}
 
-  goto estimate_tan²_error;
+void Planetarium::UpdatePlot(Trajectory<Barycentric> const& trajectory,
+                             Instant const& first_time,
+                             Instant const& last_time,
+                             bool const reverse,
+                             int const max_points,
+                             PlotCache::Plot& plot) const {
+  double const tan²_angular_resolution =
+      Pow<2>(parameters_.tan_angular_resolution_);
+  auto& points = plot.points;
+  auto const clear = [&plot, tan²_angular_resolution]() {
+    plot.points.clear();
+    plot.tan²_angular_resolution = tan²_angular_resolution;
+    plot.truncated = false;
+  };
+
+  if (plot.tan²_angular_resolution != tan²_angular_resolution) {
+    clear();
+  }
 
-  while (points_added < max_points &&
-         direction * (previous_time - final_time) < Time{}) {
-    do {
-      // One square root because we have squared errors, another one because the
-      // errors are quadratic in time (in other words, two square roots because
-      // the squared errors are quartic in time).
-      // A safety factor prevents catastrophic retries.
-      Δt *= 0.9 * Sqrt(Sqrt(tan²_angular_resolution / estimated_tan²_error));
-    estimate_tan²_error:
-      t = previous_time + Δt;
-      if (direction * (t - final_time) > Time{}) {
-        t = final_time;
-        Δt = t - previous_time;
-      }
-      Position<Navigation> const extrapolated_position =
-          previous_position + previous_velocity * Δt;
-      to_plotting_frame_at_t = plotting_frame_->ToThisFrameAtTimeSimilarly(t);
-      degrees_of_freedom_in_barycentric =
-          trajectory.EvaluateDegreesOfFreedom(t);
-      position = to_plotting_frame_at_t.similarity()(
-                     degrees_of_freedom_in_barycentric->position());
+  // Recompute the plot if the camera moved too much.
+  for (auto const& point : points) {
+    double const squared_distance_ratio =
+        perspective_.SquaredDistanceFromCamera(point.position) /
+        point.squared_distance_from_camera;
+    if (squared_distance_ratio > max_squared_distance_ratio ||
+        squared_distance_ratio < 1 / max_squared_distance_ratio) {
+      clear();
+      break;
+    }
+  }
 
-      // The quadratic term of the error between the linear interpolation and
-      // the actual function is maximized halfway through the segment, so it is
-      // 1/2 (Δt/2)² f″(t-Δt) = (1/2 Δt² f″(t-Δt)) / 4; the squared error is
-      // thus (1/2 Δt² f″(t-Δt))² / 16.
-      estimated_tan²_error =
-          perspective_.Tan²AngularDistance(extrapolated_position, position) /
-          16;
-    } while (estimated_tan²_error > tan²_angular_resolution);
+  // Forget the points beyond |last_time|, e.g., because the end of the
+  // trajectory was forgotten, or that have changed, e.g., because the end of
+  // the trajectory was recomputed.
+  bool popped_back = false;
+  while (!points.empty() &&
+         (points.back().time > last_time ||
+          !IsValid(trajectory, points.back(), tan²_angular_resolution))) {
+    points.pop_back();
+    popped_back = true;
+  }
+  // If the middle of the trajectory changed, start afresh.
+  if (!points.empty() &&
+      !IsValid(trajectory,
+               points[points.size() / 2],
+               tan²_angular_resolution)) {
+    clear();
+  }
 
-    previous_time = t;
-    previous_position = position;
-    previous_velocity =
-        to_plotting_frame_at_t(*degrees_of_freedom_in_barycentric).velocity();
+  // Forget the points before |first_time|.  We can't extend the plot
+  // backwards, so if it starts after |first_time| it is recomputed, unless it
+  // was truncated.
+  if (!points.empty() && points.front().time > first_time && !plot.truncated) {
+    clear();
+  }
+  while (points.size() >= 2 && points[1].time <= first_time) {
+    points.pop_front();
+  }
+  if (!points.empty() && points.front().time < first_time) {
+    if (points.size() == 1) {
+      clear();
+    } else {
+      PlotPoint const first = ComputePlotPoint(trajectory, first_time);
+      points.front() = {first.time,
+                        first.position,
+                        first.barycentric_position,
+                        perspective_.SquaredDistanceFromCamera(first.position)};
+    }
+  }
 
-    add_point(plotting_to_scaled_space_(position));
-    ++points_added;
+  PlotPoint previous;
+  if (points.empty()) {
+    previous = ComputePlotPoint(trajectory, first_time);
+    StartPlot(previous, last_time, plot);
+  } else if (popped_back) {
+    // The state of the subdivision was lost with the points.
+    previous = ComputePlotPoint(trajectory, points.back().time);
+    points.pop_back();
+    StartPlot(previous, last_time, plot);
+  } else {
+    auto const& back = points.back();
+    previous = {back.time,
+                back.barycentric_position,
+                back.position,
+                plot.last_velocity};
+  }
 
-    if (minimal_distance != nullptr) {
-      minimal_squared_distance =
-          std::min(minimal_squared_distance,
-                   perspective_.SquaredDistanceFromCamera(position));
+  // Extend the plot.  When plotting forward, there is no point in computing
+  // more than |max_points| points.
+  if (plot.Δt <= Time{}) {
+    // The previous plot ended at the end of the trajectory, which has grown.
+    plot.Δt = last_time - previous.time;
+    plot.estimated_tan²_error.reset();
+  }
+  while (previous.time < last_time &&
+         (reverse || std::ssize(points) < max_points)) {
+    previous = ComputeNextPlotPoint(trajectory,
+                                    previous,
+                                    last_time,
+                                    tan²_angular_resolution,
+                                    plot.Δt,
+                                    plot.estimated_tan²_error);
+    points.push_back(
+        {previous.time,
+         previous.position,
+         previous.barycentric_position,
+         perspective_.SquaredDistanceFromCamera(previous.position)});
+    if (std::ssize(points) > max_points) {
+      points.pop_front();
+      plot.truncated = true;
     }
   }
-  if (minimal_distance != nullptr) {
-    *minimal_distance = Sqrt(minimal_squared_distance);
+  plot.last_velocity = previous.velocity;
+}
+
+void Planetarium::StartPlot(PlotPoint const& point,
+                            Instant const& last_time,
+                            PlotCache::Plot& plot) const {
+  plot.points.push_back(
+      {point.time,
+       point.position,
+       point.barycentric_position,
+       perspective_.SquaredDistanceFromCamera(point.position)});
+  plot.Δt = last_time - point.time;
+  plot.estimated_tan²_error.reset();
+}
+
+bool Planetarium::IsValid(Trajectory<Barycentric> const& trajectory,
+                          PlotCache::Point const& point,
+                          double const tan²_angular_resolution) const {
+  if (point.time < trajectory.t_min() || point.time > trajectory.t_max()) {
+    return false;
   }
+  return (trajectory.EvaluatePosition(point.time) -
+          point.barycentric_position).Norm²() <=
+         tan²_angular_resolution * point.squared_distance_from_camera;
 }
 
 std::vector<Sphere<Navigation>> Planetarium::ComputePlottableSpheres(
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <utility>
 #include <vector>
 
+#include "absl/synchronization/mutex.h"
 #include "base/not_null.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/orthogonal_map.hpp"
@@ -14,6 +20,8 @@
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
 #include "physics/rigid_motion.hpp"
+#include "physics/trajectory.hpp"
+#include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 
 namespace principia {
@@ -35,6 +43,7 @@ using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_rigid_motion;
 using namespace principia::physics::_trajectory;
+using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 
 // Corresponds to a UnityEngine.Vector3 representing a position in KSP’s
@@ -51,6 +60,63 @@ extern "C" struct ScaledSpacePoint {
 static_assert(std::is_pod<ScaledSpacePoint>::value,
               "NavigationFrameParameters is used for interfacing");
 
+// The geometry of the trajectories plotted by |Planetarium::PlotMethod3|, in
+// the plotting frame, retained from one planetarium to the next.  Since the
+// plotting frame only depends on time, the points of a plot remain valid as
+// long as the trajectory doesn't change: each frame only transforms them to
+// scaled space, extends the plot if the trajectory grew, and forgets the points
+// that fell off its ends.  A plot is recomputed if the trajectory changed (as
+// detected by sampling it), or if the camera moved enough that the plot would
+// be too coarse or too fine.  The plots that are not used by a few consecutive
+// planetaria are forgotten.  Must be cleared when the plotting frame changes.
+// This class is thread-safe, but a plot must not be used concurrently by
+// multiple planetaria.
+class PlotCache final {
+ public:
+  // Forgets all the plots.
+  void Clear();
+
+ private:
+  struct Point {
+    Instant time;
+    Position<Navigation> position;
+    // Used to detect changes to the trajectory.
+    Position<Barycentric> barycentric_position;
+    // When the point was computed.
+    Square<Length> squared_distance_from_camera;
+  };
+
+  // A plot, in increasing order of time, irrespective of the direction of
+  // plotting.
+  struct Plot {
+    std::deque<Point> points;
+    double tan²_angular_resolution;
+    // True if the first points were dropped because there were too many.
+    bool truncated = false;
+    // The state of the adaptive subdivision after the last point.
+    Velocity<Navigation> last_velocity;
+    Time Δt;
+    std::optional<double> estimated_tan²_error;
+    std::int64_t last_generation;
+  };
+
+  // Called when a planetarium is constructed.  Forgets the plots that have not
+  // been used recently.
+  void NewGeneration();
+
+  // Returns the plot for the given trajectory and direction, which may be
+  // empty.  The result remains valid until the next call to |NewGeneration| or
+  // |Clear|.
+  Plot& GetPlot(Trajectory<Barycentric> const& trajectory, bool reverse);
+
+  absl::Mutex lock_;
+  std::int64_t generation_ GUARDED_BY(lock_) = 0;
+  std::map<std::pair<Trajectory<Barycentric> const*, bool>, Plot> plots_
+      GUARDED_BY(lock_);
+
+  friend class Planetarium;
+};
+
 // A planetarium is an ephemeris together with a perspective.  In this setting
 // it is possible to draw trajectories in the projective plane.
 class Planetarium {
@@ -78,11 +144,14 @@ class Planetarium {
 
   // TODO(phl): All this Navigation is weird.  Should it be named Plotting?
   // In particular Navigation vs. NavigationFrame is a mess.
+  // If |plot_cache| is not null, |PlotMethod3| reuses the plots that it
+  // contains, which must have been computed in |plotting_frame|.
   Planetarium(Parameters const& parameters,
               Perspective<Navigation, Camera> perspective,
               not_null<Ephemeris<Barycentric> const*> ephemeris,
               not_null<PlottingFrame const*> plotting_frame,
-              PlottingToScaledSpaceConversion plotting_to_scaled_space);
+              PlottingToScaledSpaceConversion plotting_to_scaled_space,
+              PlotCache* plot_cache = nullptr);
 
   // A no-op method that just returns all the points in the trajectory defined
   // by |begin| and |end|.
@@ -144,6 +213,50 @@ class Planetarium {
       Length* minimal_distance = nullptr) const;
 
  private:
+  // A point of the adaptive subdivision of |PlotMethod3|.
+  struct PlotPoint {
+    Instant time;
+    Position<Barycentric> barycentric_position;
+    Position<Navigation> position;
+    Velocity<Navigation> velocity;
+  };
+
+  // Returns the point of |trajectory| at time |t|.
+  PlotPoint ComputePlotPoint(Trajectory<Barycentric> const& trajectory,
+                             Instant const& t) const;
+
+  // Returns the point following |previous| in the adaptive subdivision of
+  // |trajectory| towards |final_time|.  |Δt| and |estimated_tan²_error| are
+  // the state of the step size control; the latter is null before the first
+  // step.
+  PlotPoint ComputeNextPlotPoint(Trajectory<Barycentric> const& trajectory,
+                                 PlotPoint const& previous,
+                                 Instant const& final_time,
+                                 double tan²_angular_resolution,
+                                 Time& Δt,
+                                 std::optional<double>& estimated_tan²_error)
+      const;
+
+  // Brings the |plot| of |trajectory| up to date so that it covers
+  // [|first_time|, |last_time|] with at most |max_points| points.
+  void UpdatePlot(Trajectory<Barycentric> const& trajectory,
+                  Instant const& first_time,
+                  Instant const& last_time,
+                  bool reverse,
+                  int max_points,
+                  PlotCache::Plot& plot) const;
+
+  // Appends to |plot| the given |point| at which the subdivision starts.
+  void StartPlot(PlotPoint const& point,
+                 Instant const& last_time,
+                 PlotCache::Plot& plot) const;
+
+  // Returns true if the cached |point| is still a point of |trajectory|
+  // within the angular resolution.
+  bool IsValid(Trajectory<Barycentric> const& trajectory,
+               PlotCache::Point const& point,
+               double tan²_angular_resolution) const;
+
   // Computes the coordinates of the spheres that represent the |ephemeris_|
   // bodies.  These coordinates are in the |plotting_frame_| at time |now|.
   std::vector<Sphere<Navigation>> ComputePlottableSpheres(
@@ -161,6 +274,7 @@ class Planetarium {
   not_null<Ephemeris<Barycentric> const*> const ephemeris_;
   not_null<PlottingFrame const*> const plotting_frame_;
   PlottingToScaledSpaceConversion plotting_to_scaled_space_;
+  PlotCache* const plot_cache_;
 };
 
 inline ScaledSpacePoint ScaledSpacePoint::FromCoordinates(
@@ -173,6 +287,7 @@ inline ScaledSpacePoint ScaledSpacePoint::FromCoordinates(
 }  // namespace internal
 
 using internal::Planetarium;
+using internal::PlotCache;
 using internal::ScaledSpacePoint;
 
 }  // namespace _planetarium
@@ -0,0 +1,287 @@
+#include "ksp_plugin/plot_batch.hpp"
+
+#include <algorithm>
+#include <future>
+#include <set>
+#include <thread>
+#include <utility>
+
+#include "base/thread_pool.hpp"
+#include "geometry/instant.hpp"
+#include "glog/logging.h"
+#include "ksp_plugin/renderer.hpp"
+#include "ksp_plugin/vessel.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace _plot_batch {
+namespace internal {
+
+using namespace principia::base::_thread_pool;
+using namespace principia::geometry::_instant;
+using namespace principia::ksp_plugin::_renderer;
+using namespace principia::ksp_plugin::_vessel;
+
+PlotBatch::PlotBatch(not_null<Planetarium const*> const planetarium,
+                     not_null<Plugin const*> const plugin)
+    : planetarium_(planetarium),
+      plugin_(plugin) {}
+
+int PlotBatch::AddFlightPlanSegment(GUID const& vessel_guid,
+                                    int const index,
+                                    int const max_points) {
+  Vessel const& vessel = *plugin_->GetVessel(vessel_guid);
+  CHECK(vessel.has_flight_plan()) << vessel_guid;
+  auto const segment = vessel.flight_plan().GetSegment(index);
+  // TODO(egg): this is ugly; we should centralize rendering.
+  // If this is a burn and we cannot render the beginning of the burn, we
+  // render none of it, otherwise we try to render the Frenet trihedron at the
+  // start and we fail.
+  if (index % 2 == 0 ||
+      segment->empty() ||
+      segment->front().time >=
+          plugin_->renderer().GetPlottingFrame()->t_min()) {
+    return AddRequest(*segment,
+                      /*reverse=*/false,
+                      [planetarium = planetarium_,
+                       segment,
+                       now = plugin_->CurrentTime(),
+                       max_points](Request& request) {
+      planetarium->PlotMethod3(
+          *segment, segment->begin(), segment->end(),
+          now,
+          /*reverse=*/false,
+          [&vertices = request.vertices](ScaledSpacePoint const& vertex) {
+            vertices.push_back(vertex);
+          },
+          max_points);
+    });
+  } else {
+    return AddEmptyRequest();
+  }
+}
+
+int PlotBatch::AddPrediction(GUID const& vessel_guid, int const max_points) {
+  auto const prediction = plugin_->GetVessel(vessel_guid)->prediction();
+  return AddRequest(*prediction,
+                    /*reverse=*/false,
+                    [planetarium = planetarium_,
+                     prediction,
+                     now = plugin_->CurrentTime(),
+                     max_points](Request& request) {
+    planetarium->PlotMethod3(
+        *prediction, prediction->begin(), prediction->end(),
+        now,
+        /*reverse=*/false,
+        [&vertices = request.vertices](ScaledSpacePoint const& vertex) {
+          vertices.push_back(vertex);
+        },
+        max_points);
+  });
+}
+
+int PlotBatch::AddPsychohistory(GUID const& vessel_guid,
+                                Time const& max_history_length,
+                                int const max_points) {
+  // Do not plot the psychohistory when there is a target vessel as it is
+  // misleading.
+  if (plugin_->renderer().HasTargetVessel()) {
+    return AddEmptyRequest();
+  }
+  auto const vessel = plugin_->GetVessel(vessel_guid);
+  auto const& trajectory = vessel->trajectory();
+  auto const& psychohistory = vessel->psychohistory();
+
+  Instant const desired_first_time =
+      plugin_->CurrentTime() - max_history_length;
+
+  // Since we would want to plot starting from |desired_first_time|, ask the
+  // reanimator to reconstruct the past.  That may take a while, during which
+  // time the history will be shorter than desired.
+  vessel->RequestReanimation(desired_first_time);
+
+  return AddRequest(trajectory,
+                    /*reverse=*/true,
+                    [planetarium = planetarium_,
+                     &trajectory,
+                     begin = trajectory.lower_bound(desired_first_time),
+                     end = psychohistory->end(),
+                     now = plugin_->CurrentTime(),
+                     max_points](Request& request) {
+    planetarium->PlotMethod3(
+        trajectory, begin, end,
+        now,
+        /*reverse=*/true,
+        [&vertices = request.vertices](ScaledSpacePoint const& vertex) {
+          vertices.push_back(vertex);
+        },
+        max_points);
+  });
+}
+
+int PlotBatch::AddCelestialPastTrajectory(Index const celestial_index,
+                                          Time const& max_history_length,
+                                          int const max_points) {
+  // Do not plot the past when there is a target vessel as it is misleading.
+  if (plugin_->renderer().HasTargetVessel()) {
+    return AddEmptyRequest();
+  }
+  auto const& celestial_trajectory =
+      plugin_->GetCelestial(celestial_index).trajectory();
+  Instant const desired_first_time =
+      plugin_->CurrentTime() - max_history_length;
+
+  // Since we would want to plot starting from |desired_first_time|, ask the
+  // reanimator to reconstruct the past.  That may take a while, during which
+  // time the history will be shorter than desired.
+  plugin_->RequestReanimation(desired_first_time);
+
+  return AddRequest(
+      celestial_trajectory,
+      /*reverse=*/true,
+      [planetarium = planetarium_,
+       &celestial_trajectory,
+       first_time = std::max(desired_first_time, celestial_trajectory.t_min()),
+       now = plugin_->CurrentTime(),
+       max_points](Request& request) {
+        planetarium->PlotMethod3(
+            celestial_trajectory,
+            first_time,
+            /*last_time=*/now,
+            now,
+            /*reverse=*/true,
+            [&vertices = request.vertices](ScaledSpacePoint const& vertex) {
+              vertices.push_back(vertex);
+            },
+            max_points,
+            &request.minimal_distance_from_camera);
+      });
+}
+
+int PlotBatch::AddCelestialFutureTrajectory(Index const celestial_index,
+                                            GUID const& vessel_guid,
+                                            int const max_points) {
+  // Do not plot the future when there is a target vessel as it is misleading.
+  if (plugin_->renderer().HasTargetVessel()) {
+    return AddEmptyRequest();
+  }
+  auto const& vessel = *plugin_->GetVessel(vessel_guid);
+  Instant const prediction_final_time = vessel.prediction()->t_max();
+  Instant const final_time =
+      vessel.has_flight_plan()
+          ? std::max(vessel.flight_plan().actual_final_time(),
+                     prediction_final_time)
+          : prediction_final_time;
+  auto const& celestial_trajectory =
+      plugin_->GetCelestial(celestial_index).trajectory();
+  // No need to request reanimation here because the current time of the
+  // plugin is necessarily covered.
+  return AddRequest(celestial_trajectory,
+                    /*reverse=*/false,
+                    [planetarium = planetarium_,
+                     &celestial_trajectory,
+                     final_time,
+                     now = plugin_->CurrentTime(),
+                     max_points](Request& request) {
+    planetarium->PlotMethod3(
+        celestial_trajectory,
+        /*first_time=*/now,
+        /*last_time=*/final_time,
+        now,
+        /*reverse=*/false,
+        [&vertices = request.vertices](ScaledSpacePoint const& vertex) {
+          vertices.push_back(vertex);
+        },
+        max_points,
+        &request.minimal_distance_from_camera);
+  });
+}
+
+void PlotBatch::Run() {
+  // The workers are shared by all the batches.  The pool is leaked to avoid
+  // joining its threads at exit.
+  static auto* const pool = new ThreadPool<void>(
+      /*pool_size=*/std::max(1u, std::thread::hardware_concurrency()));
+
+  // The requests that plot the same trajectory in the same direction as an
+  // earlier request are deferred until the others have been processed, because
+  // the plots of the |PlotCache| must not be updated concurrently.
+  std::vector<not_null<Request*>> pending_requests;
+  std::vector<not_null<Request*>> deferred_requests;
+  std::set<std::pair<Trajectory<Barycentric> const*, bool>> plots;
+  for (int i = first_unprocessed_request_; i < requests_.size(); ++i) {
+    Request& request = requests_[i];
+    if (request.plot != nullptr) {
+      bool const inserted =
+          plots.emplace(request.trajectory, request.reverse).second;
+      if (inserted) {
+        pending_requests.push_back(&request);
+      } else {
+        LOG_EVERY_N(WARNING, 100)
+            << "Request " << i << " plots the same trajectory as another "
+            << "request in the same direction";
+        deferred_requests.push_back(&request);
+      }
+    }
+    request.processed = true;
+  }
+  first_unprocessed_request_ = requests_.size();
+  if (pending_requests.empty()) {
+    return;
+  }
+
+  // The first request is processed on this thread, which would otherwise be
+  // idle; in particular, a batch with a single request doesn't use the pool.
+  std::vector<std::future<void>> futures;
+  for (int i = 1; i < pending_requests.size(); ++i) {
+    futures.push_back(pool->Add([request = pending_requests[i]]() {
+      request->plot(*request);
+    }));
+  }
+  pending_requests.front()->plot(*pending_requests.front());
+  for (auto const& future : futures) {
+    future.wait();
+  }
+  for (not_null<Request*> const request : deferred_requests) {
+    request->plot(*request);
+  }
+}
+
+std::vector<ScaledSpacePoint> const& PlotBatch::vertices(
+    int const request) const {
+  return ProcessedRequest(request).vertices;
+}
+
+Length const& PlotBatch::minimal_distance_from_camera(
+    int const request) const {
+  return ProcessedRequest(request).minimal_distance_from_camera;
+}
+
+int PlotBatch::AddRequest(Trajectory<Barycentric> const& trajectory,
+                          bool const reverse,
+                          std::function<void(Request& request)> plot) {
+  Request& request = requests_.emplace_back();
+  request.plot = std::move(plot);
+  request.trajectory = &trajectory;
+  request.reverse = reverse;
+  return requests_.size() - 1;
+}
+
+int PlotBatch::AddEmptyRequest() {
+  requests_.emplace_back();
+  return requests_.size() - 1;
+}
+
+PlotBatch::Request const& PlotBatch::ProcessedRequest(
+    int const request) const {
+  CHECK_LE(0, request);
+  CHECK_LT(request, requests_.size());
+  Request const& result = requests_[request];
+  CHECK(result.processed) << "Request " << request << " was not run";
+  return result;
+}
+
+}  // namespace internal
+}  // namespace _plot_batch
+}  // namespace ksp_plugin
+}  // namespace principia
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "ksp_plugin/identification.hpp"
+#include "ksp_plugin/planetarium.hpp"
+#include "ksp_plugin/plugin.hpp"
+#include "physics/trajectory.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace _plot_batch {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::ksp_plugin::_identification;
+using namespace principia::ksp_plugin::_planetarium;
+using namespace principia::ksp_plugin::_plugin;
+using namespace principia::physics::_trajectory;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+
+// A set of requests to plot trajectories with the same |Planetarium|.  The
+// requests are added one at a time, and then processed concurrently by |Run|,
+// which returns when all the vertices have been computed.  The decisions that
+// depend on the state of the plugin (e.g., whether there is a target vessel)
+// are made when a request is added, so the plugin must not change until |Run|
+// returns.  The requests that plot the same trajectory in the same direction
+// are processed sequentially, because the |PlotCache| of the planetarium is not
+// designed for concurrent updates of the same plot.  This class is not
+// thread-safe.
+class PlotBatch final {
+ public:
+  PlotBatch(not_null<Planetarium const*> planetarium,
+            not_null<Plugin const*> plugin);
+
+  // Each of these functions adds a request to plot a trajectory with at most
+  // |max_points| vertices and returns its index, which is used to retrieve the
+  // results.  The trajectories are the same as those of the corresponding
+  // |principia__PlanetariumPlot*| functions of the interface.
+  int AddFlightPlanSegment(GUID const& vessel_guid, int index, int max_points);
+  int AddPrediction(GUID const& vessel_guid, int max_points);
+  int AddPsychohistory(GUID const& vessel_guid,
+                       Time const& max_history_length,
+                       int max_points);
+  int AddCelestialPastTrajectory(Index celestial_index,
+                                 Time const& max_history_length,
+                                 int max_points);
+  int AddCelestialFutureTrajectory(Index celestial_index,
+                                   GUID const& vessel_guid,
+                                   int max_points);
+
+  // Processes the requests added since the last call to |Run|.  The calling
+  // thread takes part in the processing.
+  void Run();
+
+  // The results of a request which has been processed by |Run|.  The minimal
+  // distance is infinite for the requests that don't compute it or that were
+  // not plotted at all.
+  std::vector<ScaledSpacePoint> const& vertices(int request) const;
+  Length const& minimal_distance_from_camera(int request) const;
+
+ private:
+  struct Request {
+    // Fills the results of the request.  Null if there is nothing to plot.
+    std::function<void(Request& request)> plot;
+    // The trajectory plotted by |plot| and the direction in which it is
+    // plotted, which identify the plot in the |PlotCache|.  Null if there is
+    // nothing to plot.
+    Trajectory<Barycentric> const* trajectory = nullptr;
+    bool reverse = false;
+
+    std::vector<ScaledSpacePoint> vertices;
+    Length minimal_distance_from_camera = Infinity<Length>;
+    bool processed = false;
+  };
+
+  // Adds a request that executes |plot| to plot |trajectory| in the direction
+  // given by |reverse|.
+  int AddRequest(Trajectory<Barycentric> const& trajectory,
+                 bool reverse,
+                 std::function<void(Request& request)> plot);
+  // Adds a request that plots nothing.
+  int AddEmptyRequest();
+
+  Request const& ProcessedRequest(int request) const;
+
+  not_null<Planetarium const*> const planetarium_;
+  not_null<Plugin const*> const plugin_;
+
+  // A deque because the worker threads hold references to the requests.
+  std::deque<Request> requests_;
+  // The index of the first request not processed by |Run|.
+  int first_unprocessed_request_ = 0;
+};
+
+}  // namespace internal
+
+using internal::PlotBatch;
+
+}  // namespace _plot_batch
+}  // namespace ksp_plugin
+}  // namespace principia
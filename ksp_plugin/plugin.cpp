@@ -4,6 +4,7 @@
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <ios>
 #include <limits>
 #include <list>
@@ -25,7 +26,9 @@
 #include "base/map_util.hpp"
 #include "base/not_null.hpp"
 #include "base/optional_logging.hpp"
+#include "base/scheduler.hpp"
 #include "base/serialization.hpp"
+#include "base/status_utilities.hpp"
 #include "base/unique_ptr_logging.hpp"
 #include "geometry/affine_map.hpp"
 #include "geometry/barycentre_calculator.hpp"
@@ -68,6 +71,7 @@ using namespace principia::base::_fingerprint2011;
 using namespace principia::base::_hexadecimal;
 using namespace principia::base::_map_util;
 using namespace principia::base::_not_null;
+using namespace principia::base::_scheduler;
 using namespace principia::base::_serialization;
 using namespace principia::geometry::_affine_map;
 using namespace principia::geometry::_barycentre_calculator;
@@ -919,19 +923,37 @@ void Plugin::UpdatePrediction(std::vector<GUID> const& vessel_guids) const {
   for (auto const& guid : vessel_guids) {
     predicted_vessels.insert(FindOrDie(vessels_, guid).get());
   }
+  Vessel* const active_vessel =
+      vessel_guids.empty() ? nullptr
+                           : FindOrDie(vessels_, vessel_guids.front()).get();
   Vessel* target_vessel = nullptr;
 
+  // The predictions of the active vessel and of the target vessel are the
+  // ones that the user is looking at, so they are urgent; the other predicted
+  // vessels come next.
+  auto const priority = [active_vessel](not_null<Vessel*> const vessel) {
+    return vessel == active_vessel ? Scheduler::Priority::Urgent
+                                   : Scheduler::Priority::Visible;
+  };
+
   // If there is a target vessel, ensure that the prediction of the
   // |predicted_vessels| is not longer than that of the target vessel.  This is
   // necessary to build the targeting frame.
+  // The predictions of the target vessel bound those of the other vessels, so
+  // it goes first.
   if (renderer_->HasTargetVessel()) {
     target_vessel = &renderer_->GetTargetVessel();
+    target_vessel->set_prognostication_priority(Scheduler::Priority::Urgent);
     target_vessel->RefreshPrediction();
     for (auto const vessel : predicted_vessels) {
+      if (vessel != target_vessel) {
+        vessel->set_prognostication_priority(priority(vessel));
+      }
       vessel->RefreshPrediction(target_vessel->prediction()->back().time);
     }
   } else {
     for (auto const vessel : predicted_vessels) {
+      vessel->set_prognostication_priority(priority(vessel));
       vessel->RefreshPrediction();
     }
   }
@@ -939,6 +961,7 @@ void Plugin::UpdatePrediction(std::vector<GUID> const& vessel_guids) const {
     if (!Contains(predicted_vessels, vessel.get()) &&
         vessel.get() != target_vessel) {
       vessel->StopPrognosticator();
+      vessel->set_prognostication_priority(Scheduler::Priority::Visible);
     }
   }
 }
@@ -1122,11 +1145,17 @@ not_null<std::unique_ptr<Planetarium>> Plugin::NewPlanetarium(
     std::function<ScaledSpacePoint(Position<Navigation> const&)>
         plotting_to_scaled_space)
     const {
-  return make_not_null_unique<Planetarium>(parameters,
-                                           perspective,
-                                           ephemeris_.get(),
-                                           renderer_->GetPlottingFrame(),
-                                           std::move(plotting_to_scaled_space));
+  // The target frame depends on the prediction of the target vessel, which
+  // changes from one frame to the next, so its plots cannot be reused.
+  return make_not_null_unique<Planetarium>(
+      parameters,
+      perspective,
+      ephemeris_.get(),
+      renderer_->GetPlottingFrame(),
+      std::move(plotting_to_scaled_space),
+      renderer_->HasTargetVessel()
+          ? nullptr
+          : static_cast<PlotCache*>(renderer_->plot_cache()));
 }
 
 not_null<std::unique_ptr<NavigationFrame>>
@@ -1397,18 +1426,35 @@ void Plugin::WriteToMessage(
         return serialization_index_to_pile_up.at(pile_up);
       };
 
+  // The vessels and the ephemeris are serialized in parallel, as compressing
+  // their trajectories is expensive.  Each task only touches a submessage
+  // which is created here, on this thread, as creating it modifies its parent;
+  // the arena, if any, is thread-safe.
+  std::vector<std::future<absl::Status>> futures;
   std::map<not_null<Vessel const*>, GUID const> vessel_to_guid;
   for (auto const& [guid, vessel] : vessels_) {
     vessel_to_guid.emplace(vessel.get(), guid);
     auto* const vessel_message = message->add_vessel();
     vessel_message->set_guid(guid);
-    vessel->WriteToMessage(vessel_message->mutable_vessel(),
-                           serialization_index_for_pile_up);
+    futures.push_back(vessel_thread_pool_.Add(
+        [vessel = vessel.get(),
+         serialized_vessel = vessel_message->mutable_vessel(),
+         &serialization_index_for_pile_up]() {
+          vessel->WriteToMessage(serialized_vessel,
+                                 serialization_index_for_pile_up);
+          return absl::OkStatus();
+        }));
     Index const parent_index = FindOrDie(celestial_to_index, vessel->parent());
     vessel_message->set_parent_index(parent_index);
     vessel_message->set_loaded(Contains(loaded_vessels_, vessel.get()));
     vessel_message->set_kept(Contains(kept_vessels_, vessel.get()));
   }
+  futures.push_back(vessel_thread_pool_.Add(
+      [this, serialized_ephemeris = message->mutable_ephemeris()]() {
+        ephemeris_->WriteToMessage(serialized_ephemeris);
+        return absl::OkStatus();
+      }));
+
   for (auto const& [part_id, vessel] : part_id_to_vessel_) {
     (*message->mutable_part_id_to_vessel())[part_id] = vessel_to_guid[vessel];
   }
@@ -1419,8 +1465,6 @@ void Plugin::WriteToMessage(
     parameters.WriteToMessage(zombie_message->mutable_prediction_parameters());
   }
 
-  ephemeris_->WriteToMessage(message->mutable_ephemeris());
-
   // |history_downsampling_parameters_| is not persisted.
   history_fixed_step_parameters_.WriteToMessage(
       message->mutable_history_parameters());
@@ -1437,6 +1481,11 @@ void Plugin::WriteToMessage(
   for (auto* const pile_up : pile_ups_) {
     pile_up->WriteToMessage(message->add_pile_up());
   }
+
+  for (auto& future : futures) {
+    future.wait();
+    CHECK_OK(future.get());
+  }
 }
 
 not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
@@ -1495,17 +1544,42 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
                              plugin->celestials_,
                              plugin->name_to_index_);
 
-  for (auto const& vessel_message : message.vessel()) {
+  // The vessels are independent of each other, and decompressing their
+  // trajectories is expensive, so they are deserialized in parallel.  The
+  // cross-references between vessels, parts and pile-ups are resolved
+  // sequentially below.
+  std::vector<std::unique_ptr<Vessel>> deserialized_vessels(
+      message.vessel_size());
+  std::vector<std::future<absl::Status>> futures;
+  for (int i = 0; i < message.vessel_size(); ++i) {
+    auto const& vessel_message = message.vessel(i);
     not_null<Celestial const*> const parent =
         FindOrDie(plugin->celestials_, vessel_message.parent_index()).get();
-    not_null<std::unique_ptr<Vessel>> vessel = Vessel::ReadFromMessage(
-        vessel_message.vessel(),
-        parent,
-        plugin->ephemeris_.get(),
-        [&part_id_to_vessel = plugin->part_id_to_vessel_](
-            PartId const part_id) {
-          CHECK_NE(part_id_to_vessel.erase(part_id), 0) << part_id;
-        });
+    futures.push_back(plugin->vessel_thread_pool_.Add(
+        [&deserialized_vessel = deserialized_vessels[i],
+         &vessel_message,
+         parent,
+         ephemeris = plugin->ephemeris_.get(),
+         &part_id_to_vessel = plugin->part_id_to_vessel_]() {
+          deserialized_vessel = Vessel::ReadFromMessage(
+              vessel_message.vessel(),
+              parent,
+              ephemeris,
+              [&part_id_to_vessel](PartId const part_id) {
+                CHECK_NE(part_id_to_vessel.erase(part_id), 0) << part_id;
+              });
+          return absl::OkStatus();
+        }));
+  }
+  for (auto& future : futures) {
+    future.wait();
+    CHECK_OK(future.get());
+  }
+
+  for (int i = 0; i < message.vessel_size(); ++i) {
+    auto const& vessel_message = message.vessel(i);
+    not_null<std::unique_ptr<Vessel>> vessel =
+        check_not_null(std::move(deserialized_vessels[i]));
 
     if (vessel_message.loaded()) {
       plugin->loaded_vessels_.insert(vessel.get());
@@ -337,7 +337,9 @@ class Plugin {
       Ephemeris<Barycentric>::AdaptiveStepParameters const&
           prediction_adaptive_step_parameters) const;
 
-  // Updates the prediction for the vessels with guids in |vessel_guids|.
+  // Updates the prediction for the vessels with guids in |vessel_guids|.  The
+  // first guid, if any, is that of the active vessel, whose prediction is
+  // computed with the same priority as that of the target vessel.
   void UpdatePrediction(std::vector<GUID> const& vessel_guids) const;
 
   virtual void CreateFlightPlan(GUID const& vessel_guid,
@@ -537,8 +539,9 @@ class Plugin {
   Ephemeris<Barycentric>::FixedStepParameters history_fixed_step_parameters_;
   Ephemeris<Barycentric>::AdaptiveStepParameters psychohistory_parameters_;
 
-  // The thread pool for advancing vessels.
-  ThreadPool<absl::Status> vessel_thread_pool_;
+  // The thread pool for advancing vessels.  Also used to serialize vessels in
+  // parallel, hence mutable.
+  mutable ThreadPool<absl::Status> vessel_thread_pool_;
 
   Angle planetarium_rotation_;
   std::optional<Rotation<Barycentric, AliceSun>> cached_planetarium_rotation_;
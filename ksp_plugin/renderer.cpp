@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <vector>
 
 #include "geometry/grassmann.hpp"
 #include "physics/apsides.hpp"
@@ -20,6 +21,92 @@ using namespace principia::geometry::_permutation;
 using namespace principia::physics::_body_centred_body_direction_reference_frame;  // NOLINT
 using namespace principia::physics::_degrees_of_freedom;
 
+namespace {
+
+// The points of a trajectory in the plotting frame, in a form suitable for
+// transforming all their positions at once.  |scales| are the scales of the
+// maps from the plotting frame to |Barycentric| at |times|.
+struct PlottingPoints {
+  void Append(Instant const& t,
+              DegreesOfFreedom<Navigation> const& degrees_of_freedom,
+              double scale);
+  void clear();
+
+  std::vector<Instant> times;
+  std::vector<Position<Navigation>> positions;
+  std::vector<Velocity<Navigation>> velocities;
+  std::vector<double> scales;
+};
+
+void PlottingPoints::Append(
+    Instant const& t,
+    DegreesOfFreedom<Navigation> const& degrees_of_freedom,
+    double const scale) {
+  times.push_back(t);
+  positions.push_back(degrees_of_freedom.position());
+  velocities.push_back(degrees_of_freedom.velocity());
+  scales.push_back(scale);
+}
+
+void PlottingPoints::clear() {
+  times.clear();
+  positions.clear();
+  velocities.clear();
+  scales.clear();
+}
+
+DiscreteTrajectory<World> RenderPlottingPointsInWorld(
+    Similarity<Navigation, World> const&
+        from_plotting_frame_to_world_at_current_time,
+    PlottingPoints const& points) {
+  //   Dinanzi a me non fuor cose create
+  //   se non etterne, e io etterno duro.
+  //   Lasciate ogne speranza, voi ch’intrate.
+  //
+  // This function does unnatural things.
+  // - It identifies positions in the plotting frame with those of world using
+  // the rigid transformation at the current time, instead of transforming each
+  // position according to the transformation at its time.  This hides the fact
+  // that we are considering an observer fixed in the plotting frame.
+  // - Instead of applying the full rigid motion and consistently transforming
+  // the velocities, or even just applying the orthogonal map, it simply
+  // identifies the axes of |World| with those of the plotting frame. This is
+  // because we are interested in the magnitude of the velocity (the speed) in
+  // the plotting frame, as well as the coordinates (in frames with a physically
+  // significant plane, the z coordinate becomes the out-of-plane velocity).
+  // We apply the scaling at the time of the velocity, instead of the scaling at
+  // |time| or no scaling, because we want speeds in current metres per second,
+  // not in constant metres (at |time|) per second, nor in constant lunar
+  // distances (masquerading as metres) per second.
+  // The resulting |DegreesOfFreedom| should be seen as no more than a
+  // convenient hack to send a plottable position together with a velocity in
+  // the coordinates we want.  In fact, it needs an articial permutation to
+  // avoid a violation of handedness.
+  // TODO(phl): This will no longer be needed once we have support for
+  // projections; instead of these convenient lies we can simply say that the
+  // camera is fixed in the plotting frame and project there; additional data
+  // can be gathered from the velocities in the plotting frame as needed and
+  // sent directly to be shown in markers.
+
+  // All the positions are transformed by the same map, so we do it in bulk.
+  thread_local std::vector<Position<World>> world_positions;
+  from_plotting_frame_to_world_at_current_time.Apply(points.positions,
+                                                     world_positions);
+
+  Permutation<Navigation, World> const permutation(
+      Permutation<Navigation, World>::CoordinatePermutation::YXZ);
+  DiscreteTrajectory<World> trajectory;
+  for (int i = 0; i < points.times.size(); ++i) {
+    DegreesOfFreedom<World> const world_degrees_of_freedom = {
+        world_positions[i],
+        permutation(points.scales[i] * points.velocities[i])};
+    trajectory.Append(points.times[i], world_degrees_of_freedom).IgnoreError();
+  }
+  return trajectory;
+}
+
+}  // namespace
+
 Renderer::Renderer(not_null<Celestial const*> const sun,
                    not_null<std::unique_ptr<PlottingFrame>> plotting_frame)
     : sun_(sun),
@@ -28,6 +115,7 @@ Renderer::Renderer(not_null<Celestial const*> const sun,
 void Renderer::SetPlottingFrame(
     not_null<std::unique_ptr<PlottingFrame>> plotting_frame) {
   plotting_frame_ = std::move(plotting_frame);
+  plot_cache_.Clear();
 }
 
 not_null<PlottingFrame const*> Renderer::GetPlottingFrame() const {
@@ -43,16 +131,19 @@ void Renderer::SetTargetVessel(
       target_->vessel != vessel ||
       target_->celestial != celestial) {
     target_.emplace(vessel, celestial, ephemeris);
+    plot_cache_.Clear();
   }
 }
 
 void Renderer::ClearTargetVessel() {
   target_ = std::nullopt;
+  plot_cache_.Clear();
 }
 
 void Renderer::ClearTargetVesselIf(not_null<Vessel*> const vessel) {
   if (target_ && target_->vessel == vessel) {
     target_ = std::nullopt;
+    plot_cache_.Clear();
   }
 }
 
@@ -70,6 +161,10 @@ Vessel const& Renderer::GetTargetVessel() const {
   return *target_->vessel;
 }
 
+not_null<PlotCache*> Renderer::plot_cache() {
+  return &plot_cache_;
+}
+
 DiscreteTrajectory<World>
 Renderer::RenderBarycentricTrajectoryInWorld(
     Instant const& time,
@@ -77,15 +172,30 @@ Renderer::RenderBarycentricTrajectoryInWorld(
     DiscreteTrajectory<Barycentric>::iterator const& end,
     Position<World> const& sun_world_position,
     Rotation<Barycentric, AliceSun> const& planetarium_rotation) const {
-  auto const trajectory_in_plotting_frame =
-      RenderBarycentricTrajectoryInPlotting(begin, end);
-  auto trajectory_in_world =
-      RenderPlottingTrajectoryInWorld(time,
-                                      trajectory_in_plotting_frame.begin(),
-                                      trajectory_in_plotting_frame.end(),
-                                      sun_world_position,
-                                      planetarium_rotation);
-  return trajectory_in_world;
+  // The motion to the plotting frame is computed once per point, and gives
+  // both the degrees of freedom in the plotting frame and the scale of the
+  // velocity.
+  thread_local PlottingPoints points;
+  points.clear();
+  for (auto it = begin; it != end; ++it) {
+    auto const& [t, degrees_of_freedom] = *it;
+    if (target_) {
+      auto const prediction = target_->vessel->prediction();
+      if (t < prediction->t_min()) {
+        continue;
+      } else if (t > prediction->t_max()) {
+        break;
+      }
+    }
+    SimilarMotion<Barycentric, Navigation> const barycentric_to_plotting =
+        BarycentricToPlotting(t);
+    points.Append(t,
+                  barycentric_to_plotting(degrees_of_freedom),
+                  1 / barycentric_to_plotting.conformal_map().scale());
+  }
+  return RenderPlottingPointsInWorld(
+      PlottingToWorld(time, sun_world_position, planetarium_rotation),
+      points);
 }
 
 DiscreteTrajectory<Navigation>
@@ -117,55 +227,14 @@ Renderer::RenderPlottingTrajectoryInWorld(
     DiscreteTrajectory<Navigation>::iterator const& end,
     Position<World> const& sun_world_position,
     Rotation<Barycentric, AliceSun> const& planetarium_rotation) const {
-  DiscreteTrajectory<World> trajectory;
-
-  //   Dinanzi a me non fuor cose create
-  //   se non etterne, e io etterno duro.
-  //   Lasciate ogne speranza, voi ch’intrate.
-  //
-  // This function does unnatural things.
-  // - It identifies positions in the plotting frame with those of world using
-  // the rigid transformation at the current time, instead of transforming each
-  // position according to the transformation at its time.  This hides the fact
-  // that we are considering an observer fixed in the plotting frame.
-  // - Instead of applying the full rigid motion and consistently transforming
-  // the velocities, or even just applying the orthogonal map, it simply
-  // identifies the axes of |World| with those of the plotting frame. This is
-  // because we are interested in the magnitude of the velocity (the speed) in
-  // the plotting frame, as well as the coordinates (in frames with a physically
-  // significant plane, the z coordinate becomes the out-of-plane velocity).
-  // We apply the scaling at the time of the velocity, instead of the scaling at
-  // |time| or no scaling, because we want speeds in current metres per second,
-  // not in constant metres (at |time|) per second, nor in constant lunar
-  // distances (masquerading as metres) per second.
-  // The resulting |DegreesOfFreedom| should be seen as no more than a
-  // convenient hack to send a plottable position together with a velocity in
-  // the coordinates we want.  In fact, it needs an articial permutation to
-  // avoid a violation of handedness.
-  // TODO(phl): This will no longer be needed once we have support for
-  // projections; instead of these convenient lies we can simply say that the
-  // camera is fixed in the plotting frame and project there; additional data
-  // can be gathered from the velocities in the plotting frame as needed and
-  // sent directly to be shown in markers.
-  Similarity<Navigation, World> const
-      from_plotting_frame_to_world_at_current_time =
-          PlottingToWorld(time, sun_world_position, planetarium_rotation);
+  thread_local PlottingPoints points;
+  points.clear();
   for (auto const& [t, degrees_of_freedom] : Range(begin, end)) {
-    DegreesOfFreedom<Navigation> const& navigation_degrees_of_freedom =
-        degrees_of_freedom;
-    ConformalMap<double, Navigation, World> const
-        from_plotting_frame_to_world_at_t =
-            PlottingToWorld(t, planetarium_rotation);
-    DegreesOfFreedom<World> const world_degrees_of_freedom = {
-        from_plotting_frame_to_world_at_current_time(
-            navigation_degrees_of_freedom.position()),
-        Permutation<Navigation, World>(
-            Permutation<Navigation, World>::CoordinatePermutation::YXZ)(
-            from_plotting_frame_to_world_at_t.scale() *
-            navigation_degrees_of_freedom.velocity())};
-    trajectory.Append(t, world_degrees_of_freedom).IgnoreError();
+    points.Append(t, degrees_of_freedom, PlottingToBarycentric(t).scale());
   }
-  return trajectory;
+  return RenderPlottingPointsInWorld(
+      PlottingToWorld(time, sun_world_position, planetarium_rotation),
+      points);
 }
 
 SimilarMotion<Barycentric, Navigation> Renderer::BarycentricToPlotting(
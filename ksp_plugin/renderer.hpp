@@ -13,6 +13,7 @@
 #include "geometry/space.hpp"
 #include "ksp_plugin/celestial.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/planetarium.hpp"
 #include "ksp_plugin/vessel.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
@@ -36,6 +37,7 @@ using namespace principia::geometry::_space;
 using namespace principia::geometry::_space_transformations;
 using namespace principia::ksp_plugin::_celestial;
 using namespace principia::ksp_plugin::_frames;
+using namespace principia::ksp_plugin::_planetarium;
 using namespace principia::ksp_plugin::_vessel;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_ephemeris;
@@ -77,6 +79,10 @@ class Renderer {
   virtual Vessel& GetTargetVessel();
   virtual Vessel const& GetTargetVessel() const;
 
+  // The plots computed in the current plotting frame.  Cleared when the
+  // plotting frame changes.
+  not_null<PlotCache*> plot_cache();
+
   // Returns a trajectory in |World| corresponding to the trajectory defined by
   // |begin| and |end|, as seen in the current plotting frame.  In this function
   // and others in this class, |sun_world_position| is the current position of
@@ -197,6 +203,8 @@ class Renderer {
   not_null<std::unique_ptr<PlottingFrame>> plotting_frame_;
 
   std::optional<Target> target_;
+
+  PlotCache plot_cache_;
 };
 
 }  // namespace internal
@@ -6,6 +6,7 @@
 #include <list>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "absl/container/btree_set.h"
@@ -39,18 +40,36 @@ using namespace std::chrono_literals;
 // TODO(phl): Move this to some kind of parameters.
 constexpr std::int64_t max_points_to_serialize = 20'000;
 
+// An input of the prognosticator or reanimator should start being processed
+// within these latencies.
+constexpr std::chrono::milliseconds prognosticator_latency = 20ms;  // 50 Hz.
+constexpr std::chrono::milliseconds reanimator_latency = 100ms;
+
+// The prognosticators and reanimators of all the vessels share this scheduler,
+// so that we don't have two threads per vessel.  One core is left for the main
+// thread.  Intentionally leaked, as the vessels may be destroyed late.
+not_null<Scheduler*> VesselScheduler() {
+  static auto* const scheduler = new Scheduler(std::max<std::int64_t>(
+      1, static_cast<std::int64_t>(std::thread::hardware_concurrency()) - 1));
+  return scheduler;
+}
+
+bool operator!=(
+    Ephemeris<Barycentric>::AdaptiveStepParameters const& left,
+    Ephemeris<Barycentric>::AdaptiveStepParameters const& right) {
+  return &left.integrator() != &right.integrator() ||
+         left.max_steps() != right.max_steps() ||
+         left.length_integration_tolerance() !=
+             right.length_integration_tolerance() ||
+         left.speed_integration_tolerance() !=
+             right.speed_integration_tolerance();
+}
+
 bool operator!=(Vessel::PrognosticatorParameters const& left,
                 Vessel::PrognosticatorParameters const& right) {
   return left.first_time != right.first_time ||
          left.first_degrees_of_freedom != right.first_degrees_of_freedom ||
-         &left.adaptive_step_parameters.integrator() !=
-             &right.adaptive_step_parameters.integrator() ||
-         left.adaptive_step_parameters.max_steps() !=
-             right.adaptive_step_parameters.max_steps() ||
-         left.adaptive_step_parameters.length_integration_tolerance() !=
-             right.adaptive_step_parameters.length_integration_tolerance() ||
-         left.adaptive_step_parameters.speed_integration_tolerance() !=
-             right.adaptive_step_parameters.speed_integration_tolerance();
+         left.adaptive_step_parameters != right.adaptive_step_parameters;
 }
 
 Vessel::Vessel(
@@ -74,20 +93,23 @@ Vessel::Vessel(
           MakeCheckpointerWriter(),
           MakeCheckpointerReader())),
       reanimator_(
+          VesselScheduler(),
           [this](Instant const& desired_t_min) {
             return Reanimate(desired_t_min);
           },
-          20ms),  // 50 Hz.
+          Scheduler::Priority::Background,
+          reanimator_latency),
       reanimator_clientele_(/*default_value=*/InfiniteFuture),
       backstory_(trajectory_.segments().begin()),
       psychohistory_(trajectory_.segments().end()),
       prediction_(trajectory_.segments().end()),
       prognosticator_(
+          VesselScheduler(),
           [this](PrognosticatorParameters const& parameters) {
             return FlowPrognostication(parameters);
           },
-          20ms)  // 50 Hz.
-{}
+          Scheduler::Priority::Visible,
+          prognosticator_latency) {}
 
 Vessel::~Vessel() {
   LOG(INFO) << "Destroying vessel " << ShortDebugString();
@@ -589,6 +611,10 @@ void Vessel::StopPrognosticator() {
   prognosticator_.Stop();
 }
 
+void Vessel::set_prognostication_priority(Scheduler::Priority const priority) {
+  prognosticator_.set_priority(priority);
+}
+
 void Vessel::RequestOrbitAnalysis(Time const& mission_duration) {
   if (!orbit_analyser_.has_value()) {
     // TODO(egg): perhaps we should get the history parameters from the plugin;
@@ -901,12 +927,18 @@ Vessel::Vessel()
       checkpointer_(make_not_null_unique<Checkpointer<serialization::Vessel>>(
           /*reader=*/nullptr,
           /*writer=*/nullptr)),
-      reanimator_(/*action=*/nullptr, 0ms),
+      reanimator_(VesselScheduler(),
+                  /*action=*/nullptr,
+                  Scheduler::Priority::Background,
+                  0ms),
       reanimator_clientele_(InfiniteFuture),
       backstory_(trajectory_.segments().begin()),
       psychohistory_(trajectory_.segments().end()),
       prediction_(trajectory_.segments().end()),
-      prognosticator_(nullptr, 20ms) {}
+      prognosticator_(VesselScheduler(),
+                      /*action=*/nullptr,
+                      Scheduler::Priority::Visible,
+                      prognosticator_latency) {}
 
 Checkpointer<serialization::Vessel>::Writer Vessel::MakeCheckpointerWriter() {
   return [this](not_null<serialization::Vessel::Checkpoint*> const message) {
@@ -1057,22 +1089,47 @@ absl::StatusOr<DiscreteTrajectory<Barycentric>> Vessel::FlowPrognostication(
   prognostication.Append(
       prognosticator_parameters.first_time,
       prognosticator_parameters.first_degrees_of_freedom).IgnoreError();
+  auto adaptive_step_parameters =
+      prognosticator_parameters.adaptive_step_parameters;
+
+  // For a coasting vessel, the start point moves along the last
+  // prognostication from one call to the next, so we only need to integrate
+  // past its end.  The steps that are reused count against |max_steps| so that
+  // the prognostication doesn't grow without bound.  Note that the last
+  // prognostication may have up to twice |max_steps| points since it was
+  // computed by two flows.
+  std::int64_t remaining_steps = adaptive_step_parameters.max_steps();
+  if (CanSpliceLastPrognostication(prognosticator_parameters)) {
+    for (auto it = last_prognostication_.upper_bound(
+             prognosticator_parameters.first_time);
+         it != last_prognostication_.end();
+         ++it, --remaining_steps) {
+      prognostication.Append(it->time, it->degrees_of_freedom).IgnoreError();
+    }
+  }
+
   absl::Status status;
-  status = ephemeris_->FlowWithAdaptiveStep(
-      &prognostication,
-      Ephemeris<Barycentric>::NoIntrinsicAcceleration,
-      ephemeris_->t_max(),
-      prognosticator_parameters.adaptive_step_parameters,
-      FlightPlan::max_ephemeris_steps_per_frame);
-  bool const reached_t_max = status.ok();
-  if (reached_t_max) {
-    // This will prolong the ephemeris by |max_ephemeris_steps_per_frame|.
-    status = ephemeris_->FlowWithAdaptiveStep(
-        &prognostication,
-        Ephemeris<Barycentric>::NoIntrinsicAcceleration,
-        InfiniteFuture,
-        prognosticator_parameters.adaptive_step_parameters,
-        FlightPlan::max_ephemeris_steps_per_frame);
+  if (remaining_steps > 0) {
+    adaptive_step_parameters.set_max_steps(remaining_steps);
+    // The reused points may extend beyond |t_max|.
+    if (prognostication.back().time < ephemeris_->t_max()) {
+      status = ephemeris_->FlowWithAdaptiveStep(
+          &prognostication,
+          Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+          ephemeris_->t_max(),
+          adaptive_step_parameters,
+          FlightPlan::max_ephemeris_steps_per_frame);
+    }
+    bool const reached_t_max = status.ok();
+    if (reached_t_max) {
+      // This will prolong the ephemeris by |max_ephemeris_steps_per_frame|.
+      status = ephemeris_->FlowWithAdaptiveStep(
+          &prognostication,
+          Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+          InfiniteFuture,
+          adaptive_step_parameters,
+          FlightPlan::max_ephemeris_steps_per_frame);
+    }
   }
   LOG_IF_EVERY_N(INFO, !status.ok(), 50)
       << "Prognostication from " << prognosticator_parameters.first_time
@@ -1082,11 +1139,43 @@ absl::StatusOr<DiscreteTrajectory<Barycentric>> Vessel::FlowPrognostication(
     return status;
   } else {
     // Unless we were stopped, ignore the status, which indicates a failure to
-    // reach |t_max|, and provide a short prognostication.
+    // reach |t_max|, and provide a short prognostication.  Keep a copy for
+    // splicing the next one.
+    last_prognostication_ = DiscreteTrajectory<Barycentric>();
+    for (auto const& [time, degrees_of_freedom] : prognostication) {
+      last_prognostication_.Append(time, degrees_of_freedom).IgnoreError();
+    }
+    last_prognosticator_parameters_ = std::move(prognosticator_parameters);
     return std::move(prognostication);
   }
 }
 
+bool Vessel::CanSpliceLastPrognostication(
+    PrognosticatorParameters const& prognosticator_parameters) const {
+  if (!last_prognosticator_parameters_.has_value() ||
+      last_prognosticator_parameters_->adaptive_step_parameters !=
+          prognosticator_parameters.adaptive_step_parameters) {
+    return false;
+  }
+  Instant const& first_time = prognosticator_parameters.first_time;
+  if (first_time < last_prognostication_.front().time ||
+      first_time > last_prognostication_.back().time) {
+    return false;
+  }
+  auto const& adaptive_step_parameters =
+      prognosticator_parameters.adaptive_step_parameters;
+  DegreesOfFreedom<Barycentric> const last_degrees_of_freedom =
+      last_prognostication_.EvaluateDegreesOfFreedom(first_time);
+  DegreesOfFreedom<Barycentric> const& first_degrees_of_freedom =
+      prognosticator_parameters.first_degrees_of_freedom;
+  return (first_degrees_of_freedom.position() -
+          last_degrees_of_freedom.position()).Norm() <=
+             adaptive_step_parameters.length_integration_tolerance() &&
+         (first_degrees_of_freedom.velocity() -
+          last_degrees_of_freedom.velocity()).Norm() <=
+             adaptive_step_parameters.speed_integration_tolerance();
+}
+
 void Vessel::AppendToVesselTrajectory(
     TrajectoryIterator const part_trajectory_begin,
     TrajectoryIterator const part_trajectory_end,
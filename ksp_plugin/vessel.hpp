@@ -12,7 +12,7 @@
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include "base/jthread.hpp"
-#include "base/recurring_thread.hpp"
+#include "base/scheduler.hpp"
 #include "geometry/instant.hpp"
 #include "ksp_plugin/celestial.hpp"
 #include "ksp_plugin/flight_plan.hpp"
@@ -38,7 +38,7 @@ namespace _vessel {
 namespace internal {
 
 using namespace principia::base::_not_null;
-using namespace principia::base::_recurring_thread;
+using namespace principia::base::_scheduler;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::ksp_plugin::_celestial;
@@ -241,6 +241,10 @@ class Vessel {
   // Stop the asynchronous prognosticator as soon as convenient.
   void StopPrognosticator();
 
+  // The priority of the prognostication of this vessel with respect to the
+  // computations of the other vessels, which share a pool of worker threads.
+  void set_prognostication_priority(Scheduler::Priority priority);
+
   // Stops any analyser running for a different mission duration and triggers a
   // new analysis.
   void RequestOrbitAnalysis(Time const& mission_duration);
@@ -325,10 +329,18 @@ class Vessel {
       SHARED_LOCKS_REQUIRED(lock_);
 
   // Runs the integrator to compute the |prognostication_| based on the given
-  // parameters.
+  // parameters.  If the start point lies on the previous prognostication
+  // within the integration tolerances and the adaptive step parameters are
+  // unchanged, the points of the previous prognostication after the start
+  // point are reused and only the missing tail is integrated.
   absl::StatusOr<DiscreteTrajectory<Barycentric>>
   FlowPrognostication(PrognosticatorParameters prognosticator_parameters);
 
+  // Returns true if the prognostication for |prognosticator_parameters| may
+  // start with the points of |last_prognostication_|.
+  bool CanSpliceLastPrognostication(
+      PrognosticatorParameters const& prognosticator_parameters) const;
+
   // Appends to |trajectory_| the centre of mass of the trajectories of the
   // parts denoted by |part_trajectory_begin| and |part_trajectory_end|.  Only
   // the points that are strictly after the start of the |segment| are used.
@@ -385,7 +397,7 @@ class Vessel {
   Instant oldest_reanimated_checkpoint_ GUARDED_BY(lock_) = InfinitePast;
 
   // The techniques and terminology follow [Lov22].
-  RecurringThread<Instant> reanimator_;
+  ScheduledAction<Instant> reanimator_;
   Clientele<Instant> reanimator_clientele_;
 
   // Parameter passed to the last call to |RequestReanimation|, if any.
@@ -406,9 +418,15 @@ class Vessel {
   DiscreteTrajectorySegmentIterator<Barycentric> psychohistory_;
   DiscreteTrajectorySegmentIterator<Barycentric> prediction_;
 
-  RecurringThread<PrognosticatorParameters,
+  ScheduledAction<PrognosticatorParameters,
                   DiscreteTrajectory<Barycentric>> prognosticator_;
 
+  // A copy of the last prognostication returned by |FlowPrognostication| and
+  // the parameters used to compute it.  Only accessed by |FlowPrognostication|,
+  // which is never executed concurrently with itself.
+  std::optional<PrognosticatorParameters> last_prognosticator_parameters_;
+  DiscreteTrajectory<Barycentric> last_prognostication_;
+
   std::vector<std::variant<not_null<std::unique_ptr<FlightPlan>>,
                            serialization::FlightPlan>> flight_plans_;
   int selected_flight_plan_index_ = -1;
@@ -13,40 +13,49 @@ class Plotter {
   public void PlotTrajectories(DisposablePlanetarium planetarium,
                                string main_vessel_guid,
                                double history_length) {
-    PlotCelestialTrajectories(planetarium, main_vessel_guid, history_length);
-    if (main_vessel_guid == null) {
-      return;
+    // The trajectories are plotted concurrently by the C++ side, in batches.
+    // The requests for the vessels are run with the first batch, but their
+    // meshes are drawn last.
+    IntPtr batch = planetarium.PlanetariumPlotBatchCreate(Plugin);
+    try {
+      var vessel_draws = main_vessel_guid == null
+                             ? new List<Action>()
+                             : AddVesselTrajectories(batch,
+                                                     main_vessel_guid,
+                                                     history_length);
+      PlotCelestialTrajectories(batch, main_vessel_guid, history_length);
+      foreach (Action draw in vessel_draws) {
+        draw();
+      }
+    } finally {
+      Interface.PlanetariumPlotBatchDelete(ref batch);
     }
-    PlotVesselTrajectories(planetarium, main_vessel_guid, history_length);
   }
 
-  private void PlotVesselTrajectories(DisposablePlanetarium planetarium,
-                                      string main_vessel_guid,
-                                      double history_length) {
+  // Adds the requests for the trajectories of the vessels to |batch|, and
+  // returns the actions that draw them once |batch| has been run.
+  private List<Action> AddVesselTrajectories(IntPtr batch,
+                                             string main_vessel_guid,
+                                             double history_length) {
+    var draws = new List<Action>();
     {
-      planetarium.PlanetariumPlotPsychohistory(
-          Plugin,
+      int request = batch.PlanetariumPlotBatchAddPsychohistory(
           main_vessel_guid,
           history_length,
-          VertexBuffer.data,
-          VertexBuffer.size,
-          out int vertex_count);
-      DrawLineMesh(ref psychohistory_mesh_,
-                   vertex_count,
-                   adapter_.history_colour,
-                   adapter_.history_style);
+          VertexBuffer.size);
+      draws.Add(() => DrawLineMesh(ref psychohistory_mesh_,
+                                   GetVertices(batch, request),
+                                   adapter_.history_colour,
+                                   adapter_.history_style));
     }
     {
-      planetarium.PlanetariumPlotPrediction(
-          Plugin,
+      int request = batch.PlanetariumPlotBatchAddPrediction(
           main_vessel_guid,
-          VertexBuffer.data,
-          VertexBuffer.size,
-          out int vertex_count);
-      DrawLineMesh(ref prediction_mesh_,
-                   vertex_count,
-                   adapter_.prediction_colour,
-                   adapter_.prediction_style);
+          VertexBuffer.size);
+      draws.Add(() => DrawLineMesh(ref prediction_mesh_,
+                                   GetVertices(batch, request),
+                                   adapter_.prediction_colour,
+                                   adapter_.prediction_style));
     }
 
     // Target psychohistory and prediction.
@@ -57,29 +66,23 @@ class Plotter {
         target_id != null &&
         Plugin.HasVessel(target_id)) {
       {
-        planetarium.PlanetariumPlotPsychohistory(
-            Plugin,
+        int request = batch.PlanetariumPlotBatchAddPsychohistory(
             target_id,
             history_length,
-            VertexBuffer.data,
-            VertexBuffer.size,
-            out int vertex_count);
-        DrawLineMesh(ref target_psychohistory_mesh_,
-                     vertex_count,
-                     adapter_.target_history_colour,
-                     adapter_.target_history_style);
+            VertexBuffer.size);
+        draws.Add(() => DrawLineMesh(ref target_psychohistory_mesh_,
+                                     GetVertices(batch, request),
+                                     adapter_.target_history_colour,
+                                     adapter_.target_history_style));
       }
       {
-        planetarium.PlanetariumPlotPrediction(
-            Plugin,
+        int request = batch.PlanetariumPlotBatchAddPrediction(
             target_id,
-            VertexBuffer.data,
-            VertexBuffer.size,
-            out int vertex_count);
-        DrawLineMesh(ref target_prediction_mesh_,
-                     vertex_count,
-                     adapter_.target_prediction_colour,
-                     adapter_.target_prediction_style);
+            VertexBuffer.size);
+        draws.Add(() => DrawLineMesh(ref target_prediction_mesh_,
+                                     GetVertices(batch, request),
+                                     adapter_.target_prediction_colour,
+                                     adapter_.target_prediction_style));
       }
     }
 
@@ -94,27 +97,26 @@ class Plotter {
       }
       for (int i = 0; i < number_of_segments; ++i) {
         bool is_burn = i % 2 == 1;
-        planetarium.PlanetariumPlotFlightPlanSegment(
-            Plugin,
+        UnityEngine.Mesh mesh = flight_plan_segment_meshes_[i];
+        int request = batch.PlanetariumPlotBatchAddFlightPlanSegment(
             main_vessel_guid,
             i,
-            VertexBuffer.data,
-            VertexBuffer.size,
-            out int vertex_count);
+            VertexBuffer.size);
         // No need for dynamic initialization, that was done above.
-        DrawLineMesh(flight_plan_segment_meshes_[i],
-                     vertex_count,
-                     is_burn
-                         ? adapter_.burn_colour
-                         : adapter_.flight_plan_colour,
-                     is_burn
-                         ? adapter_.burn_style
-                         : adapter_.flight_plan_style);
+        draws.Add(() => DrawLineMesh(mesh,
+                                     GetVertices(batch, request),
+                                     is_burn
+                                         ? adapter_.burn_colour
+                                         : adapter_.flight_plan_colour,
+                                     is_burn
+                                         ? adapter_.burn_style
+                                         : adapter_.flight_plan_style));
       }
     }
+    return draws;
   }
 
-  private void PlotCelestialTrajectories(DisposablePlanetarium planetarium,
+  private void PlotCelestialTrajectories(IntPtr batch,
                                          string main_vessel_guid,
                                          double history_length) {
     const double degree = Math.PI / 180;
@@ -127,77 +129,113 @@ class Plotter {
     double tan_angular_resolution = Math.Min(
             Math.Tan(vertical_fov * degree / 2) / (camera.pixelHeight / 2),
             Math.Tan(horizontal_fov * degree / 2) / (camera.pixelWidth / 2));
-    PlotSubtreeTrajectories(planetarium, main_vessel_guid, history_length,
-                            Planetarium.fetch.Sun, tan_angular_resolution);
+    var camera_world_position = ScaledSpace.ScaledToLocalSpace(
+        PlanetariumCamera.fetch.transform.position);
+
+    // Whether the trajectories of the natural satellites of a body are plotted
+    // depends on the distance from the camera to the trajectories of that
+    // body, so the tree of celestials is traversed breadth-first, with one run
+    // of the batch per level.
+    var bodies = new List<CelestialBody>{Planetarium.fetch.Sun};
+    while (bodies.Count > 0) {
+      var requests = new List<CelestialRequests>();
+      foreach (CelestialBody body in bodies) {
+        var body_requests = new CelestialRequests{body = body};
+        if (!adapter_.plotting_frame_selector_.FixesBody(body) &&
+            adapter_.show_celestial_trajectory(body)) {
+          body_requests.past =
+              batch.PlanetariumPlotBatchAddCelestialPastTrajectory(
+                  body.flightGlobalsIndex,
+                  history_length,
+                  VertexBuffer.size);
+          if (main_vessel_guid != null) {
+            body_requests.future =
+                batch.PlanetariumPlotBatchAddCelestialFutureTrajectory(
+                    body.flightGlobalsIndex,
+                    main_vessel_guid,
+                    VertexBuffer.size);
+          }
+        }
+        requests.Add(body_requests);
+      }
+      batch.PlanetariumPlotBatchRun();
+
+      var satellites = new List<CelestialBody>();
+      foreach (CelestialRequests body_requests in requests) {
+        CelestialBody body = body_requests.body;
+        double min_distance_from_camera =
+            (body.position - camera_world_position).magnitude;
+        DrawCelestialTrajectories(batch,
+                                  body_requests,
+                                  ref min_distance_from_camera);
+        foreach (CelestialBody child in body.orbitingBodies) {
+          // Plot the trajectory of an orbiting body if it could be separated
+          // from that of its parent by a pixel of empty space, instead of
+          // merely making the line wider; but always traverse the subtree if
+          // the current body is hidden.
+          if (!adapter_.show_celestial_trajectory(body) ||
+              child.orbit.ApR / min_distance_from_camera >
+                  2 * tan_angular_resolution) {
+            satellites.Add(child);
+          }
+        }
+      }
+      bodies = satellites;
+    }
   }
 
-  // Plots the trajectories of |root| and its natural satellites.
-  private void PlotSubtreeTrajectories(DisposablePlanetarium planetarium,
-                                       string main_vessel_guid,
-                                       double history_length,
-                                       CelestialBody root,
-                                       double tan_angular_resolution) {
+  // Draws the trajectories of |body_requests.body|, which must have been run,
+  // and lowers |min_distance_from_camera| to their distance from the camera.
+  private void DrawCelestialTrajectories(IntPtr batch,
+                                         CelestialRequests body_requests,
+                                         ref double min_distance_from_camera) {
+    CelestialBody body = body_requests.body;
     CelestialTrajectories trajectories;
-    if (!celestial_trajectory_meshes_.TryGetValue(root, out trajectories)) {
-      trajectories = celestial_trajectory_meshes_[root] =
+    if (!celestial_trajectory_meshes_.TryGetValue(body, out trajectories)) {
+      trajectories = celestial_trajectory_meshes_[body] =
           new CelestialTrajectories();
     }
-    var colour = root.orbitDriver?.Renderer?.orbitColor ??
+    var colour = body.orbitDriver?.Renderer?.orbitColor ??
         XKCDColors.SunshineYellow;
-    var camera_world_position = ScaledSpace.ScaledToLocalSpace(
-        PlanetariumCamera.fetch.transform.position);
-    double min_distance_from_camera =
-        (root.position - camera_world_position).magnitude;
-    if (!adapter_.plotting_frame_selector_.FixesBody(root) &&
-        adapter_.show_celestial_trajectory(root)) {
-      {
-        planetarium.PlanetariumPlotCelestialPastTrajectory(
-            Plugin,
-            root.flightGlobalsIndex,
-            history_length,
-            VertexBuffer.data,
-            VertexBuffer.size,
-            out double min_past_distance,
-            out int vertex_count);
-        min_distance_from_camera =
-            Math.Min(min_distance_from_camera, min_past_distance);
-        DrawLineMesh(ref trajectories.past,
-                     vertex_count,
-                     colour,
-                     GLLines.Style.Faded);
-      }
-
-      if (main_vessel_guid != null) {
-        planetarium.PlanetariumPlotCelestialFutureTrajectory(
-            Plugin,
-            root.flightGlobalsIndex,
-            main_vessel_guid,
-            VertexBuffer.data,
-            VertexBuffer.size,
-            out double min_future_distance,
-            out int vertex_count);
-        min_distance_from_camera =
-            Math.Min(min_distance_from_camera, min_future_distance);
-        DrawLineMesh(ref trajectories.future,
-                     vertex_count,
-                     colour,
-                     GLLines.Style.Solid);
-      }
+    if (body_requests.past.HasValue) {
+      batch.PlanetariumPlotBatchGetVertices(body_requests.past.Value,
+                                            VertexBuffer.data,
+                                            VertexBuffer.size,
+                                            out double min_past_distance,
+                                            out int vertex_count);
+      min_distance_from_camera =
+          Math.Min(min_distance_from_camera, min_past_distance);
+      DrawLineMesh(ref trajectories.past,
+                   vertex_count,
+                   colour,
+                   GLLines.Style.Faded);
     }
-    foreach (CelestialBody child in root.orbitingBodies) {
-      // Plot the trajectory of an orbiting body if it could be separated from
-      // that of its parent by a pixel of empty space, instead of merely making
-      // the line wider; but always traverse the subtree if the current body is
-      // hidden.
-      if (!adapter_.show_celestial_trajectory(root) ||
-          child.orbit.ApR / min_distance_from_camera >
-              2 * tan_angular_resolution) {
-        PlotSubtreeTrajectories(planetarium, main_vessel_guid, history_length,
-                                child, tan_angular_resolution);
-      }
+    if (body_requests.future.HasValue) {
+      batch.PlanetariumPlotBatchGetVertices(body_requests.future.Value,
+                                            VertexBuffer.data,
+                                            VertexBuffer.size,
+                                            out double min_future_distance,
+                                            out int vertex_count);
+      min_distance_from_camera =
+          Math.Min(min_distance_from_camera, min_future_distance);
+      DrawLineMesh(ref trajectories.future,
+                   vertex_count,
+                   colour,
+                   GLLines.Style.Solid);
     }
   }
 
+  // Copies the vertices of |request|, which must have been run, to the vertex
+  // buffer, and returns their number.
+  private static int GetVertices(IntPtr batch, int request) {
+    batch.PlanetariumPlotBatchGetVertices(request,
+                                          VertexBuffer.data,
+                                          VertexBuffer.size,
+                                          out double _,
+                                          out int vertex_count);
+    return vertex_count;
+  }
+
   private void DrawLineMesh(ref UnityEngine.Mesh mesh,
                             int vertex_count,
                             UnityEngine.Color colour,
@@ -281,6 +319,13 @@ private class CelestialTrajectories {
     public UnityEngine.Mesh past = MakeDynamicMesh();
   }
 
+  // The indices of the requests plotting the trajectories of |body|, if any.
+  private class CelestialRequests {
+    public CelestialBody body;
+    public int? future;
+    public int? past;
+  }
+
   private readonly Dictionary<CelestialBody, CelestialTrajectories>
       celestial_trajectory_meshes_ =
       new Dictionary<CelestialBody, CelestialTrajectories>();
@@ -1,5 +1,6 @@
 #include "ksp_plugin/plugin.hpp"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -19,10 +20,12 @@ namespace _benchmark {
 namespace internal {
 
 using interface::principia__AdvanceTime;
+using interface::principia__DeserializePluginBytes;
 using interface::principia__FutureCatchUpVessel;
 using interface::principia__FutureWaitForVesselToCatchUp;
 using interface::principia__IteratorDelete;
 using interface::principia__SerializePlugin;
+using interface::principia__SerializePluginBytes;
 using namespace principia::base::_pull_serializer;
 using namespace principia::base::_push_deserializer;
 using namespace principia::base::_serialization;
@@ -115,8 +118,83 @@ void BM_PluginDeserializationBenchmark(benchmark::State& state) {
   state.SetBytesProcessed(bytes_processed);
 }
 
+// Same as |BM_PluginSerializationBenchmark|, but without encoding.
+void BM_PluginSerializationBytesBenchmark(benchmark::State& state) {
+  char const compressor[] = "gipfeli";
+  char const encoder[] = "hexadecimal";
+
+  auto const plugin = ReadPluginFromFile(
+      SOLUTION_DIR / "ksp_plugin_test" / "large_plugin.proto.gipfeli.hex",
+      compressor,
+      encoder);
+
+  std::int64_t bytes_processed = 0;
+  for (auto _ : state) {
+    PullSerializer* serializer = nullptr;
+    int size;
+    while (principia__SerializePluginBytes(plugin.get(),
+                                           &serializer,
+                                           compressor,
+                                           &size) != nullptr) {
+      bytes_processed += size;
+    }
+  }
+
+  state.SetBytesProcessed(bytes_processed);
+}
+
+// Same as |BM_PluginDeserializationBenchmark|, but without decoding.
+void BM_PluginDeserializationBytesBenchmark(benchmark::State& state) {
+  char const compressor[] = "gipfeli";
+  char const encoder[] = "hexadecimal";
+
+  // Produce the chunks once, outside of the measurement.
+  std::vector<std::vector<std::uint8_t>> chunks;
+  {
+    auto const plugin = ReadPluginFromFile(
+        SOLUTION_DIR / "ksp_plugin_test" / "large_plugin.proto.gipfeli.hex",
+        compressor,
+        encoder);
+    PullSerializer* serializer = nullptr;
+    int size;
+    for (;;) {
+      std::uint8_t const* const bytes = principia__SerializePluginBytes(
+          plugin.get(), &serializer, compressor, &size);
+      if (bytes == nullptr) {
+        break;
+      }
+      chunks.emplace_back(bytes, bytes + size);
+    }
+  }
+
+  std::int64_t bytes_processed = 0;
+  for (auto _ : state) {
+    PushDeserializer* deserializer = nullptr;
+    Plugin const* plugin = nullptr;
+    for (auto const& chunk : chunks) {
+      principia__DeserializePluginBytes(chunk.data(),
+                                        static_cast<int>(chunk.size()),
+                                        &deserializer,
+                                        &plugin,
+                                        compressor);
+      bytes_processed += chunk.size();
+    }
+    principia__DeserializePluginBytes(/*bytes=*/nullptr,
+                                      /*size=*/0,
+                                      &deserializer,
+                                      &plugin,
+                                      compressor);
+    delete plugin;
+  }
+  state.SetBytesProcessed(bytes_processed);
+}
+
 BENCHMARK(BM_PluginSerializationBenchmark)->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_PluginDeserializationBenchmark)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PluginSerializationBytesBenchmark)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PluginDeserializationBytesBenchmark)
+    ->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_PluginIntegrationBenchmark)->Unit(benchmark::kMillisecond);
 
 // .\Release\x64\ksp_plugin_test_tests.exe --gtest_filter=PluginBenchmark.DISABLED_All --gtest_also_run_disabled_tests  // NOLINT
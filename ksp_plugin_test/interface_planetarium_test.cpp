@@ -1,38 +1,77 @@
 #include "ksp_plugin/interface.hpp"
 
+#include <limits>
+#include <vector>
+
 #include "geometry/affine_map.hpp"
+#include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/orthogonal_map.hpp"
 #include "geometry/permutation.hpp"
+#include "geometry/perspective.hpp"
+#include "geometry/r3_element.hpp"
 #include "geometry/rotation.hpp"
+#include "geometry/signature.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin_test/mock_planetarium.hpp"
 #include "ksp_plugin_test/mock_plugin.hpp"
 #include "ksp_plugin_test/mock_renderer.hpp"
+#include "ksp_plugin_test/mock_vessel.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/massive_body.hpp"
+#include "physics/mock_continuous_trajectory.hpp"
+#include "physics/mock_ephemeris.hpp"
+#include "physics/mock_rigid_reference_frame.hpp"
+#include "physics/rigid_motion.hpp"
+#include "physics/rotating_body.hpp"
+#include "quantities/numbers.hpp"
 #include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/discrete_trajectory_factories.hpp"
 
 namespace principia {
 namespace interface {
 
 using ::testing::ByMove;
+using ::testing::Gt;
 using ::testing::IsNull;
 using ::testing::Return;
 using ::testing::ReturnRef;
+using ::testing::SizeIs;
 using ::testing::StrictMock;
 using ::testing::_;
 using namespace principia::base::_not_null;
+using namespace principia::geometry::_frame;
+using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_orthogonal_map;
 using namespace principia::geometry::_permutation;
+using namespace principia::geometry::_perspective;
+using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_rotation;
+using namespace principia::geometry::_sign;
+using namespace principia::geometry::_signature;
+using namespace principia::geometry::_space;
 using namespace principia::geometry::_space_transformations;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_planetarium;
+using namespace principia::ksp_plugin::_plot_batch;
 using namespace principia::ksp_plugin::_plugin;
 using namespace principia::ksp_plugin::_renderer;
+using namespace principia::ksp_plugin::_vessel;
+using namespace principia::physics::_continuous_trajectory;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_ephemeris;
+using namespace principia::physics::_massive_body;
+using namespace principia::physics::_rigid_motion;
+using namespace principia::physics::_rigid_reference_frame;
+using namespace principia::physics::_rotating_body;
 using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_discrete_trajectory_factories;
 
 class InterfacePlanetariumTest : public ::testing::Test {
  protected:
@@ -76,5 +115,157 @@ TEST_F(InterfacePlanetariumTest, ConstructionDestruction) {
   EXPECT_THAT(planetarium, IsNull());
 }
 
+TEST_F(InterfacePlanetariumTest, PlotBatch) {
+  MockPlanetarium const planetarium;
+  PlotBatch* batch =
+      principia__PlanetariumPlotBatchCreate(&planetarium, plugin_.get());
+  // Running an empty batch is a no-op.
+  principia__PlanetariumPlotBatchRun(batch);
+  principia__PlanetariumPlotBatchDelete(&batch);
+  EXPECT_THAT(batch, IsNull());
+}
+
+// Plotting several trajectories in a batch gives the same vertices as plotting
+// them one at a time.
+TEST_F(InterfacePlanetariumTest, PlotBatchPredictions) {
+  using LeftNavigation =
+      Frame<struct LeftNavigationTag, Arbitrary, Handedness::Left>;
+  // The camera is located at {0, 20, 0} and is looking along -y.
+  Perspective<Navigation, Camera> const perspective(
+      RigidTransformation<Navigation, Camera>(
+          Navigation::origin +
+              Displacement<Navigation>({0 * Metre, 20 * Metre, 0 * Metre}),
+          Camera::origin,
+          Rotation<LeftNavigation, Camera>(
+              Vector<double, LeftNavigation>({1, 0, 0}),
+              Vector<double, LeftNavigation>({0, 0, 1}),
+              Bivector<double, LeftNavigation>({0, -1, 0}))
+                  .Forget<OrthogonalMap>() *
+              Signature<Navigation, LeftNavigation>(
+                  Sign::Positive(),
+                  Sign::Positive(),
+                  DeduceSignReversingOrientation{})
+                  .Forget<OrthogonalMap>())
+          .Forget<Similarity>(),
+      /*focal=*/5 * Metre);
+
+  // A body of radius 1 m located at the origin, and an identity plotting
+  // frame.
+  RotatingBody<Barycentric> const body(
+      MassiveBody::Parameters(1 * Kilogram),
+      RotatingBody<Barycentric>::Parameters(
+          /*mean_radius=*/1 * Metre,
+          /*reference_angle=*/0 * Radian,
+          /*reference_instant=*/t0_,
+          /*angular_frequency=*/10 * Radian / Second,
+          /*right_ascension_of_pole=*/0 * Radian,
+          /*declination_of_pole=*/π / 2 * Radian));
+  std::vector<not_null<MassiveBody const*>> const bodies({&body});
+  MockContinuousTrajectory<Barycentric> continuous_trajectory;
+  MockEphemeris<Barycentric> ephemeris;
+  MockRigidReferenceFrame<Barycentric, Navigation> plotting_frame;
+  ON_CALL(plotting_frame, t_min()).WillByDefault(Return(InfinitePast));
+  ON_CALL(plotting_frame, t_max()).WillByDefault(Return(InfiniteFuture));
+  EXPECT_CALL(plotting_frame, ToThisFrameAtTime(_))
+      .WillRepeatedly(Return(RigidMotion<Barycentric, Navigation>(
+          RigidTransformation<Barycentric, Navigation>::Identity(),
+          Barycentric::nonrotating,
+          Barycentric::unmoving)));
+  EXPECT_CALL(ephemeris, bodies()).WillRepeatedly(ReturnRef(bodies));
+  EXPECT_CALL(ephemeris, trajectory(_))
+      .WillRepeatedly(Return(&continuous_trajectory));
+  EXPECT_CALL(continuous_trajectory, EvaluatePosition(_))
+      .WillRepeatedly(Return(Barycentric::origin));
+
+  // No dark area, human visual acuity, wide field of view.
+  Planetarium const planetarium(
+      Planetarium::Parameters(/*sphere_radius_multiplier=*/1,
+                              /*angular_resolution=*/0.4 * ArcMinute,
+                              /*field_of_view=*/90 * Degree),
+      perspective,
+      &ephemeris,
+      &plotting_frame,
+      [](Position<Navigation> const& plotted_point) {
+        constexpr auto inverse_scale_factor = 1 / (6000 * Metre);
+        return ScaledSpacePoint::FromCoordinates(
+            ((plotted_point - Navigation::origin) *
+             inverse_scale_factor).coordinates());
+      });
+
+  // Three vessels on circular trajectories of different radii.
+  std::vector<char const*> const vessel_guids = {"v0", "v1", "v2"};
+  std::vector<DiscreteTrajectory<Barycentric>> predictions(
+      vessel_guids.size());
+  std::vector<StrictMock<MockVessel>> vessels(vessel_guids.size());
+  EXPECT_CALL(*plugin_, CurrentTime()).WillRepeatedly(Return(t0_));
+  for (int i = 0; i < vessel_guids.size(); ++i) {
+    AppendTrajectoryTimeline(
+        /*from=*/NewCircularTrajectoryTimeline<Barycentric>(
+            /*period=*/100'000 * Second,
+            /*r=*/(5 + i) * Metre,
+            /*Δt=*/1 * Second,
+            /*t1=*/t0_,
+            /*t2=*/t0_ + 25'000 * Second),
+        /*to=*/predictions[i]);
+    EXPECT_CALL(vessels[i], prediction())
+        .WillRepeatedly(Return(predictions[i].segments().begin()));
+    EXPECT_CALL(*plugin_, GetVessel(vessel_guids[i]))
+        .WillRepeatedly(Return(&vessels[i]));
+  }
+
+  constexpr int vertices_size = 10'000;
+  auto const to_coordinates = [](ScaledSpacePoint const* const vertices,
+                                 int const vertex_count) {
+    std::vector<R3Element<double>> coordinates;
+    for (int i = 0; i < vertex_count; ++i) {
+      coordinates.emplace_back(vertices[i].x, vertices[i].y, vertices[i].z);
+    }
+    return coordinates;
+  };
+
+  std::vector<std::vector<R3Element<double>>> expected_vertices;
+  for (char const* const vessel_guid : vessel_guids) {
+    std::vector<ScaledSpacePoint> vertices(vertices_size);
+    int vertex_count;
+    principia__PlanetariumPlotPrediction(&planetarium,
+                                         plugin_.get(),
+                                         vessel_guid,
+                                         vertices.data(),
+                                         vertices_size,
+                                         &vertex_count);
+    expected_vertices.push_back(to_coordinates(vertices.data(), vertex_count));
+    EXPECT_THAT(expected_vertices.back(), SizeIs(Gt(1)));
+  }
+
+  PlotBatch* batch =
+      principia__PlanetariumPlotBatchCreate(&planetarium, plugin_.get());
+  std::vector<int> requests;
+  for (char const* const vessel_guid : vessel_guids) {
+    requests.push_back(principia__PlanetariumPlotBatchAddPrediction(
+        batch, vessel_guid, vertices_size));
+  }
+  // Plotting the same trajectory a second time in the same direction is
+  // harmless.
+  requests.push_back(principia__PlanetariumPlotBatchAddPrediction(
+      batch, vessel_guids.front(), vertices_size));
+  principia__PlanetariumPlotBatchRun(batch);
+  for (int i = 0; i < requests.size(); ++i) {
+    std::vector<ScaledSpacePoint> vertices(vertices_size);
+    double minimal_distance_from_camera;
+    int vertex_count;
+    principia__PlanetariumPlotBatchGetVertices(batch,
+                                               requests[i],
+                                               vertices.data(),
+                                               vertices_size,
+                                               &minimal_distance_from_camera,
+                                               &vertex_count);
+    EXPECT_EQ(expected_vertices[i % vessel_guids.size()],
+              to_coordinates(vertices.data(), vertex_count)) << i;
+    EXPECT_EQ(std::numeric_limits<double>::infinity(),
+              minimal_distance_from_camera);
+  }
+  principia__PlanetariumPlotBatchDelete(&batch);
+}
+
 }  // namespace interface
 }  // namespace principia
@@ -140,6 +140,14 @@ Recorder* InterfaceTest::recorder_ = nullptr;
 
 using InterfaceDeathTest = InterfaceTest;
 
+// The functions that (de)serialize the plugin to (from) bytes are not
+// journalled and refuse to run while the recorder is active.
+class InterfaceBytesTest : public InterfaceTest {
+ protected:
+  static void SetUpTestCase() {}
+  static void TearDownTestCase() {}
+};
+
 // And there is only one thing we say to Death.
 TEST_F(InterfaceDeathTest, Errors) {
   Plugin* plugin = nullptr;
@@ -648,6 +656,119 @@ TEST_F(InterfaceTest, DeserializePlugin) {
   principia__DeletePlugin(&plugin);
 }
 
+TEST_F(InterfaceBytesTest, SerializePluginBytes) {
+  PullSerializer* serializer = nullptr;
+  auto const message = ParseFromBytes<principia::serialization::Plugin>(
+      serialized_simple_plugin_);
+
+  EXPECT_CALL(*plugin_, WriteToMessage(_)).WillOnce(SetArgPointee<0>(message));
+  int size;
+  std::uint8_t const* const bytes =
+      principia__SerializePluginBytes(plugin_.get(),
+                                      &serializer,
+                                      /*compressor=*/"",
+                                      &size);
+  EXPECT_EQ(serialized_simple_plugin_,
+            std::vector<std::uint8_t>(bytes, bytes + size));
+  EXPECT_EQ(nullptr,
+            principia__SerializePluginBytes(plugin_.get(),
+                                            &serializer,
+                                            /*compressor=*/"",
+                                            &size));
+  EXPECT_EQ(0, size);
+  EXPECT_THAT(serializer, IsNull());
+}
+
+TEST_F(InterfaceBytesTest, DeserializePluginBytes) {
+  PushDeserializer* deserializer = nullptr;
+  Plugin const* plugin = nullptr;
+  principia__DeserializePluginBytes(serialized_simple_plugin_.data(),
+                                    static_cast<int>(
+                                        serialized_simple_plugin_.size()),
+                                    &deserializer,
+                                    &plugin,
+                                    /*compressor=*/"");
+  principia__DeserializePluginBytes(/*bytes=*/nullptr,
+                                    /*size=*/0,
+                                    &deserializer,
+                                    &plugin,
+                                    /*compressor=*/"");
+  EXPECT_THAT(deserializer, IsNull());
+  EXPECT_THAT(plugin, NotNull());
+  principia__DeletePlugin(&plugin);
+}
+
+// Saves a plugin to chunks of bytes and loads it back, twice, and checks that
+// the two saves are identical.
+TEST_F(InterfaceBytesTest, SerializePluginBytesRoundTrip) {
+  auto const load = [](std::vector<std::vector<std::uint8_t>> const& chunks) {
+    PushDeserializer* deserializer = nullptr;
+    Plugin const* plugin = nullptr;
+    for (auto const& chunk : chunks) {
+      principia__DeserializePluginBytes(chunk.data(),
+                                        static_cast<int>(chunk.size()),
+                                        &deserializer,
+                                        &plugin,
+                                        /*compressor=*/"");
+    }
+    principia__DeserializePluginBytes(/*bytes=*/nullptr,
+                                      /*size=*/0,
+                                      &deserializer,
+                                      &plugin,
+                                      /*compressor=*/"");
+    EXPECT_THAT(deserializer, IsNull());
+    EXPECT_THAT(plugin, NotNull());
+    return plugin;
+  };
+  auto const save = [](Plugin const* const plugin) {
+    // The chunks are only valid until the next call, so they are copied.
+    std::vector<std::vector<std::uint8_t>> chunks;
+    PullSerializer* serializer = nullptr;
+    int size;
+    while (std::uint8_t const* const bytes =
+               principia__SerializePluginBytes(plugin,
+                                               &serializer,
+                                               /*compressor=*/"",
+                                               &size)) {
+      chunks.emplace_back(bytes, bytes + size);
+    }
+    EXPECT_EQ(0, size);
+    EXPECT_THAT(serializer, IsNull());
+    return chunks;
+  };
+
+  Plugin const* plugin1 = load({serialized_simple_plugin_});
+  auto const chunks1 = save(plugin1);
+  principia__DeletePlugin(&plugin1);
+  EXPECT_FALSE(chunks1.empty());
+
+  Plugin const* plugin2 = load(chunks1);
+  auto const chunks2 = save(plugin2);
+  principia__DeletePlugin(&plugin2);
+  EXPECT_EQ(chunks1, chunks2);
+}
+
+TEST_F(InterfaceDeathTest, PluginBytesJournalled) {
+  EXPECT_DEATH({
+    PullSerializer* serializer = nullptr;
+    int size;
+    principia__SerializePluginBytes(plugin_.get(),
+                                    &serializer,
+                                    /*compressor=*/"",
+                                    &size);
+  }, "cannot be journalled");
+  EXPECT_DEATH({
+    PushDeserializer* deserializer = nullptr;
+    Plugin const* plugin = nullptr;
+    principia__DeserializePluginBytes(serialized_simple_plugin_.data(),
+                                      static_cast<int>(
+                                          serialized_simple_plugin_.size()),
+                                      &deserializer,
+                                      &plugin,
+                                      /*compressor=*/"");
+  }, "cannot be journalled");
+}
+
 TEST_F(InterfaceDeathTest, SettersAndGetters) {
   // We use EXPECT_EXITs in this test to avoid interfering with the execution of
   // the other tests.
@@ -1,5 +1,6 @@
 #include "ksp_plugin/planetarium.hpp"
 
+#include <algorithm>
 #include <random>
 #include <vector>
 
@@ -10,6 +11,7 @@
 #include "geometry/instant.hpp"
 #include "geometry/orthogonal_map.hpp"
 #include "geometry/perspective.hpp"
+#include "geometry/r3_element.hpp"
 #include "geometry/rotation.hpp"
 #include "geometry/space.hpp"
 #include "gtest/gtest.h"
@@ -46,6 +48,7 @@ using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_orthogonal_map;
 using namespace principia::geometry::_perspective;
+using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_rotation;
 using namespace principia::geometry::_sign;
 using namespace principia::geometry::_signature;
@@ -259,6 +262,92 @@ TEST_F(PlanetariumTest, PlotMethod2) {
   }
 }
 
+TEST_F(PlanetariumTest, PlotMethod3Cache) {
+  // A quarter of a circular trajectory around the origin, with many small
+  // segments.
+  DiscreteTrajectory<Barycentric> discrete_trajectory;
+  AppendTrajectoryTimeline(/*from=*/NewCircularTrajectoryTimeline<Barycentric>(
+                                        /*period=*/100'000 * Second,
+                                        /*r=*/10 * Metre,
+                                        /*Δt=*/1 * Second,
+                                        /*t1=*/t0_,
+                                        /*t2=*/t0_ + 25'000 * Second),
+                           /*to=*/discrete_trajectory);
+
+  // No dark area, human visual acuity, wide field of view.
+  Planetarium::Parameters parameters(
+      /*sphere_radius_multiplier=*/1,
+      /*angular_resolution=*/0.4 * ArcMinute,
+      /*field_of_view=*/90 * Degree);
+  PlotCache plot_cache;
+  Planetarium const planetarium(parameters,
+                                perspective_,
+                                &ephemeris_,
+                                &plotting_frame_,
+                                plotting_to_scaled_space_);
+  Planetarium const cached_planetarium(parameters,
+                                       perspective_,
+                                       &ephemeris_,
+                                       &plotting_frame_,
+                                       plotting_to_scaled_space_,
+                                       &plot_cache);
+
+  auto const plot = [&discrete_trajectory, this](
+                        Planetarium const& planetarium,
+                        Instant const& last_time) {
+    std::vector<R3Element<double>> points;
+    planetarium.PlotMethod3(
+        discrete_trajectory,
+        discrete_trajectory.front().time,
+        last_time,
+        t0_,
+        /*reverse=*/false,
+        [&points](ScaledSpacePoint const& point) {
+          points.emplace_back(point.x, point.y, point.z);
+        },
+        /*max_points=*/10'000);
+    return points;
+  };
+
+  // The first plot is identical to the one computed without a cache.
+  auto const uncached_points = plot(planetarium, t0_ + 20'000 * Second);
+  EXPECT_THAT(uncached_points, SizeIs(36));
+  EXPECT_EQ(uncached_points, plot(cached_planetarium, t0_ + 20'000 * Second));
+
+  // The second plot doesn't evaluate the plotting frame.
+  EXPECT_CALL(plotting_frame_, ToThisFrameAtTime(_)).Times(0);
+  EXPECT_EQ(uncached_points, plot(cached_planetarium, t0_ + 20'000 * Second));
+  EXPECT_CALL(plotting_frame_, ToThisFrameAtTime(_))
+      .WillRepeatedly(Return(RigidMotion<Barycentric, Navigation>(
+          RigidTransformation<Barycentric, Navigation>::Identity(),
+          Barycentric::nonrotating,
+          Barycentric::unmoving)));
+
+  // The plot is extended when plotting further.
+  {
+    Instant const last_time = discrete_trajectory.back().time;
+    auto const extended_points = plot(cached_planetarium, last_time);
+    auto const uncached_extended_points = plot(planetarium, last_time);
+    EXPECT_THAT(extended_points, SizeIs(43));
+    EXPECT_EQ(uncached_extended_points.front(), extended_points.front());
+    EXPECT_EQ(uncached_extended_points.back(), extended_points.back());
+    EXPECT_TRUE(std::equal(uncached_points.begin(),
+                           uncached_points.end(),
+                           extended_points.begin()));
+  }
+
+  // The end of the plot is recomputed when the end of the trajectory is
+  // forgotten.
+  {
+    discrete_trajectory.ForgetAfter(t0_ + 10'000 * Second);
+    Instant const last_time = discrete_trajectory.back().time;
+    auto const truncated_points = plot(cached_planetarium, last_time);
+    auto const uncached_truncated_points = plot(planetarium, last_time);
+    EXPECT_THAT(truncated_points, SizeIs(18));
+    EXPECT_EQ(uncached_truncated_points.back(), truncated_points.back());
+  }
+}
+
 #if !defined(_DEBUG)
 TEST_F(PlanetariumTest, RealSolarSystem) {
   auto const discrete_trajectory =
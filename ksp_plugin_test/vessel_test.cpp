@@ -133,6 +133,14 @@ class VesselTest : public testing::Test {
     vessel_.checkpointer_->WriteToMessage(message->mutable_checkpoint());
   }
 
+  absl::StatusOr<DiscreteTrajectory<Barycentric>> FlowPrognostication(
+      Instant const& first_time,
+      DegreesOfFreedom<Barycentric> const& first_degrees_of_freedom) {
+    return vessel_.FlowPrognostication({first_time,
+                                        first_degrees_of_freedom,
+                                        DefaultPredictionParameters()});
+  }
+
   MockEphemeris<Barycentric> ephemeris_;
   RotatingBody<Barycentric> const body_;
   Celestial const celestial_;
@@ -315,6 +323,104 @@ TEST_F(VesselTest, Prediction) {
   }
 }
 
+TEST_F(VesselTest, SplicePrediction) {
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(t0_ + 2 * Second));
+  auto const expected_vessel_prediction = NewLinearTrajectoryTimeline(
+      p1_dof_,
+      /*Δt=*/0.5 * Second,
+      /*t1=*/t0_,
+      /*t2=*/t0_ + 2.5 * Second);
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+      .WillRepeatedly(Return(absl::OkStatus()));
+
+  // The first prognostication is integrated from scratch.
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _))
+      .WillOnce(DoAll(
+          AppendPointsToDiscreteTrajectory(&expected_vessel_prediction),
+          Return(absl::OkStatus())));
+  {
+    auto const prognostication = FlowPrognostication(t0_, p1_dof_);
+    ASSERT_THAT(prognostication, IsOk());
+    EXPECT_EQ(5, prognostication->size());
+  }
+
+  // The second one starts on the first one, and reuses its points without
+  // integrating up to |t_max|.
+  {
+    Instant const t = t0_ + 0.75 * Second;
+    DegreesOfFreedom<Barycentric> const degrees_of_freedom(
+        p1_dof_.position() + p1_dof_.velocity() * (t - t0_),
+        p1_dof_.velocity());
+    auto const prognostication = FlowPrognostication(t, degrees_of_freedom);
+    ASSERT_THAT(prognostication, IsOk());
+    EXPECT_EQ(4, prognostication->size());
+    EXPECT_EQ(t, prognostication->front().time);
+    EXPECT_EQ(t0_ + 1 * Second, std::next(prognostication->begin())->time);
+    EXPECT_EQ(t0_ + 2 * Second, prognostication->back().time);
+  }
+
+  // The third one starts off the second one and is integrated from scratch.
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _))
+      .WillOnce(Return(absl::OkStatus()));
+  {
+    Instant const t = t0_ + 1.25 * Second;
+    auto const prognostication = FlowPrognostication(t, p2_dof_);
+    ASSERT_THAT(prognostication, IsOk());
+    EXPECT_EQ(1, prognostication->size());
+  }
+}
+
+// Same as above, but the first prognostication uses up the step budget, so the
+// second one must not integrate at all.
+TEST_F(VesselTest, SplicePredictionMaxSteps) {
+  std::int64_t const max_steps = DefaultPredictionParameters().max_steps();
+  Instant const t_max = t0_ + max_steps * 0.5 * Second;
+  EXPECT_CALL(ephemeris_, t_max()).WillRepeatedly(Return(t_max));
+
+  // The first prognostication is made of two flows of |max_steps| each.
+  auto const expected_vessel_prediction1 = NewLinearTrajectoryTimeline(
+      p1_dof_,
+      /*Δt=*/0.5 * Second,
+      /*t1=*/t0_,
+      /*t2=*/t_max + 0.5 * Second);
+  auto const expected_vessel_prediction2 = NewLinearTrajectoryTimeline(
+      p1_dof_,
+      /*Δt=*/0.5 * Second,
+      /*t0=*/t0_,
+      /*t1=*/t_max + 0.5 * Second,
+      /*t2=*/t_max + (max_steps + 1) * 0.5 * Second);
+  EXPECT_CALL(ephemeris_, FlowWithAdaptiveStep(_, _, t_max, _, _))
+      .WillOnce(DoAll(
+          AppendPointsToDiscreteTrajectory(&expected_vessel_prediction1),
+          Return(absl::OkStatus())));
+  EXPECT_CALL(ephemeris_, FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+      .WillOnce(DoAll(
+          AppendPointsToDiscreteTrajectory(&expected_vessel_prediction2),
+          Return(absl::OkStatus())));
+  {
+    auto const prognostication = FlowPrognostication(t0_, p1_dof_);
+    ASSERT_THAT(prognostication, IsOk());
+    EXPECT_EQ(2 * max_steps + 1, prognostication->size());
+  }
+
+  // The second one reuses more than |max_steps| points, and the mocks above
+  // check that it doesn't call the ephemeris.
+  {
+    Instant const t = t0_ + 0.75 * Second;
+    DegreesOfFreedom<Barycentric> const degrees_of_freedom(
+        p1_dof_.position() + p1_dof_.velocity() * (t - t0_),
+        p1_dof_.velocity());
+    auto const prognostication = FlowPrognostication(t, degrees_of_freedom);
+    ASSERT_THAT(prognostication, IsOk());
+    EXPECT_EQ(2 * max_steps, prognostication->size());
+    EXPECT_EQ(t, prognostication->front().time);
+  }
+}
+
 TEST_F(VesselTest, PredictBeyondTheInfinite) {
   EXPECT_CALL(ephemeris_, t_min_locked())
       .WillRepeatedly(Return(t0_));
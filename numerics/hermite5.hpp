@@ -0,0 +1,56 @@
+#pragma once
+
+#include <utility>
+
+#include "quantities/named_quantities.hpp"
+
+namespace principia {
+namespace numerics {
+namespace _hermite5 {
+namespace internal {
+
+using namespace principia::quantities::_named_quantities;
+
+// A 5th degree Hermite polynomial defined by its values, first and second
+// derivatives at the bounds of some interval.  This is the natural continuous
+// extension of a step of a second-order integrator when the accelerations are
+// known at both ends of the step.
+template<typename Argument, typename Value>
+class Hermite5 final {
+ public:
+  using Derivative1 = Derivative<Value, Argument>;
+  using Derivative2 = Derivative<Derivative1, Argument>;
+
+  Hermite5(std::pair<Argument, Argument> arguments,
+           std::pair<Value, Value> const& values,
+           std::pair<Derivative1, Derivative1> const& derivatives,
+           std::pair<Derivative2, Derivative2> const& second_derivatives);
+
+  Value Evaluate(Argument const& argument) const;
+  Derivative1 EvaluateDerivative(Argument const& argument) const;
+
+ private:
+  using Derivative3 = Derivative<Derivative2, Argument>;
+  using Derivative4 = Derivative<Derivative3, Argument>;
+  using Derivative5 = Derivative<Derivative4, Argument>;
+
+  std::pair<Argument, Argument> const arguments_;
+
+  // The coefficients are relative to |arguments.first|.
+  Value a0_;
+  Derivative1 a1_;
+  Derivative2 a2_;
+  Derivative3 a3_;
+  Derivative4 a4_;
+  Derivative5 a5_;
+};
+
+}  // namespace internal
+
+using internal::Hermite5;
+
+}  // namespace _hermite5
+}  // namespace numerics
+}  // namespace principia
+
+#include "numerics/hermite5_body.hpp"
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "numerics/hermite5.hpp"
+
+#include <utility>
+
+namespace principia {
+namespace numerics {
+namespace _hermite5 {
+namespace internal {
+
+using namespace principia::quantities::_named_quantities;
+
+template<typename Argument, typename Value>
+Hermite5<Argument, Value>::Hermite5(
+    std::pair<Argument, Argument> arguments,
+    std::pair<Value, Value> const& values,
+    std::pair<Derivative1, Derivative1> const& derivatives,
+    std::pair<Derivative2, Derivative2> const& second_derivatives)
+    : arguments_(std::move(arguments)) {
+  a0_ = values.first;
+  a1_ = derivatives.first;
+  a2_ = 0.5 * second_derivatives.first;
+  Difference<Argument> const Δargument = arguments_.second - arguments_.first;
+  // If we were given the same point twice, there is a removable singularity.
+  // Otherwise, if the arguments are the same but not the values or the
+  // derivatives, we proceed to merrily NaN away as we should.
+  if (Δargument == Difference<Argument>{} &&
+      values.first == values.second &&
+      derivatives.first == derivatives.second &&
+      second_derivatives.first == second_derivatives.second) {
+    a3_ = {};
+    a4_ = {};
+    a5_ = {};
+    return;
+  }
+  auto const one_over_Δargument = 1.0 / Δargument;
+  auto const one_over_Δargument² = one_over_Δargument * one_over_Δargument;
+  auto const one_over_Δargument³ = one_over_Δargument * one_over_Δargument²;
+  auto const one_over_Δargument⁴ = one_over_Δargument² * one_over_Δargument²;
+  auto const one_over_Δargument⁵ = one_over_Δargument² * one_over_Δargument³;
+  // The differences between the values (resp. the derivatives, the second
+  // derivatives) at the upper bound and those of the quadratic defined by the
+  // lower bound, all expressed as differences of |Value|.
+  Difference<Value> const Δvalue =
+      values.second - values.first -
+      (derivatives.first + 0.5 * second_derivatives.first * Δargument) *
+          Δargument;
+  Difference<Value> const Δderivative =
+      (derivatives.second - derivatives.first -
+       second_derivatives.first * Δargument) * Δargument;
+  Difference<Value> const Δsecond_derivative =
+      (second_derivatives.second - second_derivatives.first) *
+      Δargument * Δargument;
+  a3_ = (10.0 * Δvalue - 4.0 * Δderivative + 0.5 * Δsecond_derivative) *
+        one_over_Δargument³;
+  a4_ = (-15.0 * Δvalue + 7.0 * Δderivative - Δsecond_derivative) *
+        one_over_Δargument⁴;
+  a5_ = (6.0 * Δvalue - 3.0 * Δderivative + 0.5 * Δsecond_derivative) *
+        one_over_Δargument⁵;
+}
+
+template<typename Argument, typename Value>
+Value Hermite5<Argument, Value>::Evaluate(Argument const& argument) const {
+  Difference<Argument> const Δargument = argument - arguments_.first;
+  return ((((a5_ * Δargument + a4_) * Δargument + a3_) * Δargument + a2_) *
+              Δargument + a1_) * Δargument + a0_;
+}
+
+template<typename Argument, typename Value>
+typename Hermite5<Argument, Value>::Derivative1
+Hermite5<Argument, Value>::EvaluateDerivative(Argument const& argument) const {
+  Difference<Argument> const Δargument = argument - arguments_.first;
+  return (((5.0 * a5_ * Δargument + 4.0 * a4_) * Δargument + 3.0 * a3_) *
+              Δargument + 2.0 * a2_) * Δargument + a1_;
+}
+
+}  // namespace internal
+}  // namespace _hermite5
+}  // namespace numerics
+}  // namespace principia
@@ -0,0 +1,119 @@
+#include "numerics/hermite5.hpp"
+
+#include <algorithm>
+
+#include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "numerics/hermite3.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/almost_equals.hpp"
+#include "testing_utilities/numerics.hpp"
+
+namespace principia {
+namespace numerics {
+
+using ::testing::Lt;
+using namespace principia::geometry::_frame;
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::numerics::_hermite3;
+using namespace principia::numerics::_hermite5;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_almost_equals;
+using namespace principia::testing_utilities::_numerics;
+
+class Hermite5Test : public ::testing::Test {
+ protected:
+  using World = Frame<struct WorldTag, Inertial>;
+
+  Instant const t0_;
+};
+
+TEST_F(Hermite5Test, Quintic) {
+  // A quintic polynomial is reproduced exactly.
+  auto const q = [this](Instant const& t) {
+    double const τ = (t - t0_) / Second;
+    return (((((2 * τ - 3) * τ + 1) * τ - 5) * τ + 7) * τ - 11) * Metre;
+  };
+  auto const v = [this](Instant const& t) {
+    double const τ = (t - t0_) / Second;
+    return ((((10 * τ - 12) * τ + 3) * τ - 10) * τ + 7) * Metre / Second;
+  };
+  auto const a = [this](Instant const& t) {
+    double const τ = (t - t0_) / Second;
+    return (((40 * τ - 36) * τ + 6) * τ - 10) * Metre / Second / Second;
+  };
+  Instant const t1 = t0_ + 1 * Second;
+  Instant const t2 = t0_ + 3 * Second;
+  Hermite5<Instant, Length> const h({t1, t2},
+                                    {q(t1), q(t2)},
+                                    {v(t1), v(t2)},
+                                    {a(t1), a(t2)});
+  for (int i = 0; i <= 8; ++i) {
+    Instant const t = t1 + i * (t2 - t1) / 8;
+    EXPECT_THAT(h.Evaluate(t), AlmostEquals(q(t), 0, 24)) << i;
+    EXPECT_THAT(h.EvaluateDerivative(t), AlmostEquals(v(t), 0, 24)) << i;
+  }
+}
+
+TEST_F(Hermite5Test, Typed) {
+  // Just here to check that the types work in the presence of affine spaces.
+  Hermite5<Instant, Position<World>> h(
+      {t0_ + 1 * Second, t0_ + 2 * Second},
+      {World::origin, World::origin},
+      {World::unmoving, World::unmoving},
+      {Vector<Acceleration, World>(), Vector<Acceleration, World>()});
+
+  EXPECT_EQ(World::origin, h.Evaluate(t0_ + 1.3 * Second));
+  EXPECT_EQ(Velocity<World>(), h.EvaluateDerivative(t0_ + 1.7 * Second));
+}
+
+TEST_F(Hermite5Test, Circle) {
+  // On an arc of a uniform circular motion, the quintic interpolation is much
+  // more accurate than the cubic one built from the same positions and
+  // velocities.
+  Length const r = 1 * Metre;
+  AngularFrequency const ω = 1 * Radian / Second;
+  auto const q = [this, r, ω](Instant const& t) {
+    Angle const θ = ω * (t - t0_);
+    return World::origin +
+           Displacement<World>({r * Cos(θ), r * Sin(θ), 0 * Metre});
+  };
+  auto const v = [this, r, ω](Instant const& t) {
+    Angle const θ = ω * (t - t0_);
+    return Velocity<World>({-r * ω * Sin(θ) / Radian,
+                            r * ω * Cos(θ) / Radian,
+                            0 * Metre / Second});
+  };
+  auto const a = [&q, ω](Instant const& t) {
+    return -(q(t) - World::origin) * ω * ω / (Radian * Radian);
+  };
+  Instant const t1 = t0_;
+  Instant const t2 = t0_ + 0.5 * Second;
+  Hermite3<Instant, Position<World>> const h3(
+      {t1, t2}, {q(t1), q(t2)}, {v(t1), v(t2)});
+  Hermite5<Instant, Position<World>> const h5(
+      {t1, t2}, {q(t1), q(t2)}, {v(t1), v(t2)}, {a(t1), a(t2)});
+  Length max_error3;
+  Length max_error5;
+  for (int i = 1; i < 10; ++i) {
+    Instant const t = t1 + i * (t2 - t1) / 10;
+    max_error3 = std::max(max_error3, AbsoluteError(q(t), h3.Evaluate(t)));
+    max_error5 = std::max(max_error5, AbsoluteError(q(t), h5.Evaluate(t)));
+  }
+  EXPECT_THAT(max_error3, Lt(2e-4 * Metre));
+  EXPECT_THAT(max_error5, Lt(1e-6 * Metre));
+  EXPECT_THAT(max_error5, Lt(max_error3 / 100));
+}
+
+}  // namespace numerics
+}  // namespace principia
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "numerics/polynomial.hpp"
+#include "numerics/polynomial_evaluators.hpp"
+
+namespace principia {
+namespace numerics {
+namespace _polynomial_arena {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::numerics::_polynomial;
+using namespace principia::numerics::_polynomial_evaluators;
+
+// A sequence of polynomials in the monomial basis with values in
+// |Position<Frame>| and argument |Instant|, stored without any per-polynomial
+// allocation: the coefficients of all the polynomials live in a single
+// contiguous array, and the origins and degrees of the polynomials are kept in
+// a side table.  Evaluation dispatches on the degree to an Estrin scheme that
+// gives exactly the same results as the |PolynomialInMonomialBasis| with an
+// |EstrinEvaluator| from which the polynomial was built, but without virtual
+// calls or pointer chasing.  This class is not thread-safe.
+template<typename Frame>
+class PolynomialArena final {
+ public:
+  static constexpr int min_degree = 1;
+  static constexpr int max_degree = 17;
+
+  template<int degree_>
+  using PolynomialOfDegree = PolynomialInMonomialBasis<
+      Position<Frame>, Instant, degree_, EstrinEvaluator>;
+
+  bool empty() const;
+  std::int64_t size() const;
+
+  // Appends a copy of |polynomial|, which must be a |PolynomialOfDegree| with a
+  // degree in [min_degree, max_degree].
+  void Append(Polynomial<Position<Frame>, Instant> const& polynomial);
+  template<int degree_>
+  void Append(PolynomialOfDegree<degree_> const& polynomial);
+
+  // Removes the polynomials at indices greater than or equal to |size|.
+  void Truncate(std::int64_t size);
+
+  // Inserts the polynomials of |prefix| before those of this object.  This
+  // operation is in O(size()) and leaves |prefix| empty.
+  void Prepend(PolynomialArena&& prefix);
+
+  int degree(std::int64_t index) const;
+
+  Position<Frame> Evaluate(std::int64_t index, Instant const& argument) const;
+  Velocity<Frame> EvaluateDerivative(std::int64_t index,
+                                     Instant const& argument) const;
+
+  // Returns a copy of the polynomial at |index| as a |PolynomialOfDegree|.
+  // Expensive, for use by serialization and the like.
+  not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>> Get(
+      std::int64_t index) const;
+
+  // The number of bytes used by the coefficients and the side table, excluding
+  // any unused capacity.
+  std::int64_t size_in_bytes() const;
+
+ private:
+  // The coefficients of the polynomial are at indices [offset,
+  // offset + 3 * (degree + 1)[ of |coefficients_|.
+  struct Entry {
+    Instant origin;
+    std::int64_t offset;
+    int degree;
+  };
+
+  template<int degree_>
+  Position<Frame> EvaluateWithDegree(Entry const& entry,
+                                     Instant const& argument) const;
+  template<int degree_>
+  Velocity<Frame> EvaluateDerivativeWithDegree(Entry const& entry,
+                                               Instant const& argument) const;
+  template<int degree_>
+  PolynomialOfDegree<degree_> GetWithDegree(Entry const& entry) const;
+
+  std::vector<Entry> entries_;
+
+  // The coordinates of the coefficients in SI units, coefficient by
+  // coefficient.  The constant term is relative to |Frame::origin|.
+  std::vector<double> coefficients_;
+};
+
+}  // namespace internal
+
+using internal::PolynomialArena;
+
+}  // namespace _polynomial_arena
+}  // namespace numerics
+}  // namespace principia
+
+#include "numerics/polynomial_arena_body.hpp"
@@ -0,0 +1,497 @@
+#pragma once
+
+#include "numerics/polynomial_arena.hpp"
+
+#include <array>
+#include <tuple>
+#include <utility>
+
+#include "base/bits.hpp"
+#include "base/macros.hpp"
+#include "geometry/grassmann.hpp"
+#include "geometry/r3_element.hpp"
+#include "glog/logging.h"
+#include "numerics/fma.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace numerics {
+namespace _polynomial_arena {
+namespace internal {
+
+using namespace principia::base::_bits;
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_r3_element;
+using namespace principia::numerics::_fma;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+
+// Conversion between the coefficients of a |PolynomialOfDegree| and their
+// coordinates in the arena.
+template<typename Coefficient>
+struct CoefficientCoordinates;
+
+template<typename Scalar, typename Frame>
+struct CoefficientCoordinates<Vector<Scalar, Frame>> {
+  static void Append(Vector<Scalar, Frame> const& coefficient,
+                     std::vector<double>& coordinates);
+  static Vector<Scalar, Frame> Load(double const* coordinates);
+};
+
+template<typename Frame>
+struct CoefficientCoordinates<Position<Frame>> {
+  static void Append(Position<Frame> const& coefficient,
+                     std::vector<double>& coordinates);
+  static Position<Frame> Load(double const* coordinates);
+};
+
+template<typename Scalar, typename Frame>
+void CoefficientCoordinates<Vector<Scalar, Frame>>::Append(
+    Vector<Scalar, Frame> const& coefficient,
+    std::vector<double>& coordinates) {
+  R3Element<double> const c = coefficient.coordinates() / si::Unit<Scalar>;
+  coordinates.push_back(c.x);
+  coordinates.push_back(c.y);
+  coordinates.push_back(c.z);
+}
+
+template<typename Scalar, typename Frame>
+Vector<Scalar, Frame> CoefficientCoordinates<Vector<Scalar, Frame>>::Load(
+    double const* const coordinates) {
+  return Vector<Scalar, Frame>(
+      R3Element<double>(coordinates[0], coordinates[1], coordinates[2]) *
+      si::Unit<Scalar>);
+}
+
+template<typename Frame>
+void CoefficientCoordinates<Position<Frame>>::Append(
+    Position<Frame> const& coefficient,
+    std::vector<double>& coordinates) {
+  CoefficientCoordinates<Displacement<Frame>>::Append(
+      coefficient - Frame::origin, coordinates);
+}
+
+template<typename Frame>
+Position<Frame> CoefficientCoordinates<Position<Frame>>::Load(
+    double const* const coordinates) {
+  return Frame::origin +
+         CoefficientCoordinates<Displacement<Frame>>::Load(coordinates);
+}
+
+template<typename Coefficients, std::size_t... k>
+void AppendCoefficients(Coefficients const& coefficients,
+                        std::index_sequence<k...>,
+                        std::vector<double>& coordinates) {
+  (CoefficientCoordinates<std::tuple_element_t<k, Coefficients>>::Append(
+       std::get<k>(coefficients), coordinates),
+   ...);
+}
+
+template<typename Coefficients, std::size_t... k>
+Coefficients LoadCoefficients(double const* const coordinates,
+                              std::index_sequence<k...>) {
+  return Coefficients(
+      CoefficientCoordinates<std::tuple_element_t<k, Coefficients>>::Load(
+          coordinates + 3 * k)...);
+}
+
+FORCE_INLINE(inline) R3Element<double> LoadCoefficient(
+    double const* const coefficients,
+    int const k) {
+  return R3Element<double>(coefficients[3 * k],
+                           coefficients[3 * k + 1],
+                           coefficients[3 * k + 2]);
+}
+
+// Same as |InternalEstrinEvaluator|, but for the coordinates of the
+// coefficients as stored in the arena.  The operations are performed in the
+// same order, and therefore give the same results.
+template<int degree, bool fma, int low, int subdegree>
+struct ArenaEstrinEvaluator {
+  using ArgumentSquares = std::array<double, FloorLog2(degree)>;
+
+  FORCE_INLINE(static) R3Element<double> Evaluate(
+      double const* coefficients,
+      double argument,
+      ArgumentSquares const& argument_squares);
+  FORCE_INLINE(static) R3Element<double> EvaluateDerivative(
+      double const* coefficients,
+      double argument,
+      ArgumentSquares const& argument_squares);
+};
+
+template<int degree, bool fma, int low>
+struct ArenaEstrinEvaluator<degree, fma, low, 1> {
+  using ArgumentSquares = std::array<double, FloorLog2(degree)>;
+
+  FORCE_INLINE(static) R3Element<double> Evaluate(
+      double const* coefficients,
+      double argument,
+      ArgumentSquares const& argument_squares);
+  FORCE_INLINE(static) R3Element<double> EvaluateDerivative(
+      double const* coefficients,
+      double argument,
+      ArgumentSquares const& argument_squares);
+};
+
+template<int degree, bool fma, int low>
+struct ArenaEstrinEvaluator<degree, fma, low, 0> {
+  using ArgumentSquares = std::array<double, FloorLog2(degree)>;
+
+  FORCE_INLINE(static) R3Element<double> Evaluate(
+      double const* coefficients,
+      double argument,
+      ArgumentSquares const& argument_squares);
+  FORCE_INLINE(static) R3Element<double> EvaluateDerivative(
+      double const* coefficients,
+      double argument,
+      ArgumentSquares const& argument_squares);
+};
+
+// Returns argument², argument⁴, etc.
+template<int degree>
+FORCE_INLINE(inline) std::array<double, FloorLog2(degree)> ArgumentSquares(
+    double const argument) {
+  std::array<double, FloorLog2(degree)> argument_squares;
+  double square = argument;
+  for (auto& argument_square : argument_squares) {
+    square *= square;
+    argument_square = square;
+  }
+  return argument_squares;
+}
+
+template<int degree, bool fma, int low, int subdegree>
+FORCE_INLINE(inline) R3Element<double>
+ArenaEstrinEvaluator<degree, fma, low, subdegree>::Evaluate(
+    double const* const coefficients,
+    double const argument,
+    ArgumentSquares const& argument_squares) {
+  static_assert(subdegree >= 2,
+                "Unexpected subdegree in ArenaEstrinEvaluator::Evaluate");
+  // |n| is used to select |argument^(2^(n + 1))| = |argument^m|.
+  constexpr int n = FloorLog2(subdegree) - 1;
+  // |m| is |2^(n + 1)|.
+  constexpr int m = PowerOf2Le(subdegree);
+  double const xᵐ = std::get<n>(argument_squares);
+  auto const a =
+      ArenaEstrinEvaluator<degree, fma, low + m, subdegree - m>::Evaluate(
+          coefficients, argument, argument_squares);
+  auto const b = ArenaEstrinEvaluator<degree, fma, low, m - 1>::Evaluate(
+      coefficients, argument, argument_squares);
+  if constexpr (fma) {
+    return FusedMultiplyAdd(a, xᵐ, b);
+  } else {
+    return a * xᵐ + b;
+  }
+}
+
+template<int degree, bool fma, int low, int subdegree>
+FORCE_INLINE(inline) R3Element<double>
+ArenaEstrinEvaluator<degree, fma, low, subdegree>::EvaluateDerivative(
+    double const* const coefficients,
+    double const argument,
+    ArgumentSquares const& argument_squares) {
+  static_assert(
+      subdegree >= 2,
+      "Unexpected subdegree in ArenaEstrinEvaluator::EvaluateDerivative");
+  // |n| is used to select |argument^(2^(n + 1))| = |argument^m|.
+  constexpr int n = FloorLog2(subdegree) - 1;
+  // |m| is |2^(n + 1)|.
+  constexpr int m = PowerOf2Le(subdegree);
+  double const xᵐ = std::get<n>(argument_squares);
+  auto const a = ArenaEstrinEvaluator<degree, fma, low + m, subdegree - m>::
+      EvaluateDerivative(coefficients, argument, argument_squares);
+  auto const b = ArenaEstrinEvaluator<degree, fma, low, m - 1>::
+      EvaluateDerivative(coefficients, argument, argument_squares);
+  if constexpr (fma) {
+    return FusedMultiplyAdd(a, xᵐ, b);
+  } else {
+    return a * xᵐ + b;
+  }
+}
+
+template<int degree, bool fma, int low>
+FORCE_INLINE(inline) R3Element<double>
+ArenaEstrinEvaluator<degree, fma, low, 1>::Evaluate(
+    double const* const coefficients,
+    double const argument,
+    ArgumentSquares const& argument_squares) {
+  double const x = argument;
+  auto const a = LoadCoefficient(coefficients, low + 1);
+  auto const b = LoadCoefficient(coefficients, low);
+  if constexpr (fma) {
+    return FusedMultiplyAdd(a, x, b);
+  } else {
+    return a * x + b;
+  }
+}
+
+template<int degree, bool fma, int low>
+FORCE_INLINE(inline) R3Element<double>
+ArenaEstrinEvaluator<degree, fma, low, 1>::EvaluateDerivative(
+    double const* const coefficients,
+    double const argument,
+    ArgumentSquares const& argument_squares) {
+  double const x = argument;
+  auto const a = (low + 1) * LoadCoefficient(coefficients, low + 1);
+  auto const b = low * LoadCoefficient(coefficients, low);
+  if constexpr (fma) {
+    return FusedMultiplyAdd(a, x, b);
+  } else {
+    return a * x + b;
+  }
+}
+
+template<int degree, bool fma, int low>
+FORCE_INLINE(inline) R3Element<double>
+ArenaEstrinEvaluator<degree, fma, low, 0>::Evaluate(
+    double const* const coefficients,
+    double const argument,
+    ArgumentSquares const& argument_squares) {
+  return LoadCoefficient(coefficients, low);
+}
+
+template<int degree, bool fma, int low>
+FORCE_INLINE(inline) R3Element<double>
+ArenaEstrinEvaluator<degree, fma, low, 0>::EvaluateDerivative(
+    double const* const coefficients,
+    double const argument,
+    ArgumentSquares const& argument_squares) {
+  return low * LoadCoefficient(coefficients, low);
+}
+
+template<typename Frame>
+bool PolynomialArena<Frame>::empty() const {
+  return entries_.empty();
+}
+
+template<typename Frame>
+std::int64_t PolynomialArena<Frame>::size() const {
+  return entries_.size();
+}
+
+#define PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(value)                       \
+  case value:                                                               \
+    return Append(*dynamic_cast_not_null<PolynomialOfDegree<value> const*>( \
+        check_not_null(&polynomial)))
+
+template<typename Frame>
+void PolynomialArena<Frame>::Append(
+    Polynomial<Position<Frame>, Instant> const& polynomial) {
+  switch (polynomial.degree()) {
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(1);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(2);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(3);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(4);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(5);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(6);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(7);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(8);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(9);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(10);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(11);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(12);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(13);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(14);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(15);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(16);
+    PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE(17);
+    default:
+      LOG(FATAL) << "Unexpected degree " << polynomial.degree();
+  }
+}
+
+#undef PRINCIPIA_POLYNOMIAL_ARENA_APPEND_CASE
+
+template<typename Frame>
+template<int degree_>
+void PolynomialArena<Frame>::Append(
+    PolynomialOfDegree<degree_> const& polynomial) {
+  static_assert(degree_ >= min_degree && degree_ <= max_degree);
+  entries_.push_back(
+      Entry{polynomial.origin(),
+            /*offset=*/static_cast<std::int64_t>(coefficients_.size()),
+            degree_});
+  AppendCoefficients(polynomial.coefficients(),
+                     std::make_index_sequence<degree_ + 1>(),
+                     coefficients_);
+}
+
+template<typename Frame>
+void PolynomialArena<Frame>::Truncate(std::int64_t const size) {
+  if (size < entries_.size()) {
+    coefficients_.resize(entries_[size].offset);
+    entries_.resize(size);
+  }
+}
+
+template<typename Frame>
+void PolynomialArena<Frame>::Prepend(PolynomialArena&& prefix) {
+  std::int64_t const prefix_coefficients_size = prefix.coefficients_.size();
+  for (auto& entry : entries_) {
+    entry.offset += prefix_coefficients_size;
+  }
+  prefix.entries_.insert(prefix.entries_.end(),
+                         entries_.begin(), entries_.end());
+  prefix.coefficients_.insert(prefix.coefficients_.end(),
+                              coefficients_.begin(), coefficients_.end());
+  entries_.swap(prefix.entries_);
+  coefficients_.swap(prefix.coefficients_);
+  prefix.entries_.clear();
+  prefix.coefficients_.clear();
+}
+
+template<typename Frame>
+int PolynomialArena<Frame>::degree(std::int64_t const index) const {
+  return entries_[index].degree;
+}
+
+#define PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, value) \
+  case value:                                                   \
+    return function<value>(entry, argument)
+
+#define PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_SWITCH(function)   \
+  switch (entry.degree) {                                    \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 1);     \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 2);     \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 3);     \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 4);     \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 5);     \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 6);     \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 7);     \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 8);     \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 9);     \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 10);    \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 11);    \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 12);    \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 13);    \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 14);    \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 15);    \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 16);    \
+    PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE(function, 17);    \
+    default:                                                 \
+      LOG(FATAL) << "Unexpected degree " << entry.degree;    \
+  }
+
+template<typename Frame>
+Position<Frame> PolynomialArena<Frame>::Evaluate(
+    std::int64_t const index,
+    Instant const& argument) const {
+  Entry const& entry = entries_[index];
+  PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_SWITCH(EvaluateWithDegree);
+}
+
+template<typename Frame>
+Velocity<Frame> PolynomialArena<Frame>::EvaluateDerivative(
+    std::int64_t const index,
+    Instant const& argument) const {
+  Entry const& entry = entries_[index];
+  PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_SWITCH(EvaluateDerivativeWithDegree);
+}
+
+#undef PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_SWITCH
+#undef PRINCIPIA_POLYNOMIAL_ARENA_DEGREE_CASE
+
+#define PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(value)                       \
+  case value:                                                            \
+    return make_not_null_unique<PolynomialOfDegree<value>>(              \
+        GetWithDegree<value>(entry))
+
+template<typename Frame>
+not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
+PolynomialArena<Frame>::Get(std::int64_t const index) const {
+  Entry const& entry = entries_[index];
+  switch (entry.degree) {
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(1);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(2);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(3);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(4);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(5);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(6);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(7);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(8);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(9);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(10);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(11);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(12);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(13);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(14);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(15);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(16);
+    PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE(17);
+    default:
+      LOG(FATAL) << "Unexpected degree " << entry.degree;
+  }
+}
+
+#undef PRINCIPIA_POLYNOMIAL_ARENA_GET_CASE
+
+template<typename Frame>
+std::int64_t PolynomialArena<Frame>::size_in_bytes() const {
+  return entries_.size() * sizeof(Entry) +
+         coefficients_.size() * sizeof(double);
+}
+
+template<typename Frame>
+template<int degree_>
+FORCE_INLINE(inline) Position<Frame>
+PolynomialArena<Frame>::EvaluateWithDegree(Entry const& entry,
+                                           Instant const& argument) const {
+  double const* const coefficients = &coefficients_[entry.offset];
+  double const x = (argument - entry.origin) / si::Unit<Time>;
+  auto const argument_squares = ArgumentSquares<degree_>(x);
+  R3Element<double> coordinates;
+  if (UseHardwareFMA) {
+    coordinates = ArenaEstrinEvaluator<degree_, /*fma=*/true,
+                                       /*low=*/0, /*subdegree=*/degree_>::
+        Evaluate(coefficients, x, argument_squares);
+  } else {
+    coordinates = ArenaEstrinEvaluator<degree_, /*fma=*/false,
+                                       /*low=*/0, /*subdegree=*/degree_>::
+        Evaluate(coefficients, x, argument_squares);
+  }
+  return Frame::origin +
+         Displacement<Frame>(coordinates * si::Unit<Length>);
+}
+
+template<typename Frame>
+template<int degree_>
+FORCE_INLINE(inline) Velocity<Frame>
+PolynomialArena<Frame>::EvaluateDerivativeWithDegree(
+    Entry const& entry,
+    Instant const& argument) const {
+  double const* const coefficients = &coefficients_[entry.offset];
+  double const x = (argument - entry.origin) / si::Unit<Time>;
+  auto const argument_squares = ArgumentSquares<degree_>(x);
+  R3Element<double> coordinates;
+  if (UseHardwareFMA) {
+    coordinates = ArenaEstrinEvaluator<degree_, /*fma=*/true,
+                                       /*low=*/1, /*subdegree=*/degree_ - 1>::
+        EvaluateDerivative(coefficients, x, argument_squares);
+  } else {
+    coordinates = ArenaEstrinEvaluator<degree_, /*fma=*/false,
+                                       /*low=*/1, /*subdegree=*/degree_ - 1>::
+        EvaluateDerivative(coefficients, x, argument_squares);
+  }
+  return Velocity<Frame>(coordinates * si::Unit<Speed>);
+}
+
+template<typename Frame>
+template<int degree_>
+auto PolynomialArena<Frame>::GetWithDegree(Entry const& entry) const
+    -> PolynomialOfDegree<degree_> {
+  using Coefficients = typename PolynomialOfDegree<degree_>::Coefficients;
+  return PolynomialOfDegree<degree_>(
+      LoadCoefficients<Coefficients>(&coefficients_[entry.offset],
+                                     std::make_index_sequence<degree_ + 1>()),
+      entry.origin);
+}
+
+}  // namespace internal
+}  // namespace _polynomial_arena
+}  // namespace numerics
+}  // namespace principia
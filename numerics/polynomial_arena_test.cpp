@@ -0,0 +1,162 @@
+#include "numerics/polynomial_arena.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "numerics/newhall.hpp"
+#include "numerics/polynomial.hpp"
+#include "numerics/polynomial_evaluators.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "serialization/geometry.pb.h"
+#include "serialization/numerics.pb.h"
+#include "testing_utilities/matchers.hpp"
+
+namespace principia {
+namespace numerics {
+
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_frame;
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::numerics::_newhall;
+using namespace principia::numerics::_polynomial;
+using namespace principia::numerics::_polynomial_arena;
+using namespace principia::numerics::_polynomial_evaluators;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_matchers;
+
+class PolynomialArenaTest : public ::testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      Inertial,
+                      Handedness::Right,
+                      serialization::Frame::TEST>;
+
+  static constexpr int divisions = 8;
+
+  // Fits polynomials of all the degrees supported by Newhall to consecutive
+  // intervals of a helix.
+  PolynomialArenaTest() {
+    Length const r = 1e9 * Metre;
+    AngularFrequency const ω = 1e-5 * Radian / Second;
+    Speed const vz = 1e3 * Metre / Second;
+    Instant t_min = t0_;
+    for (int degree = 3; degree <= 17; ++degree) {
+      Instant const t_max = t_min + step_;
+      std::vector<Position<World>> q;
+      std::vector<Velocity<World>> v;
+      for (int i = 0; i <= divisions; ++i) {
+        Time const t = t_min - t0_ + i * step_ / divisions;
+        q.push_back(World::origin + Displacement<World>({r * Cos(ω * t),
+                                                         r * Sin(ω * t),
+                                                         vz * t}));
+        v.push_back(Velocity<World>({-r * ω * Sin(ω * t) / Radian,
+                                     r * ω * Cos(ω * t) / Radian,
+                                     vz}));
+      }
+      Displacement<World> error_estimate;
+      polynomials_.push_back(
+          NewhallApproximationInMonomialBasis<Position<World>,
+                                              EstrinEvaluator>(
+              degree, q, v, t_min, t_max, error_estimate));
+      t_mins_.push_back(t_min);
+      t_min = t_max;
+    }
+  }
+
+  // Checks that |arena| evaluates like the polynomials with indices in
+  // [first, first + arena.size()[.
+  void ExpectSameEvaluations(PolynomialArena<World> const& arena,
+                             int const first) const {
+    for (int i = 0; i < arena.size(); ++i) {
+      auto const& polynomial = *polynomials_[first + i];
+      EXPECT_EQ(polynomial.degree(), arena.degree(i));
+      for (int j = 0; j <= 10; ++j) {
+        Instant const t = t_mins_[first + i] + j * step_ / 10;
+        EXPECT_EQ(polynomial(t), arena.Evaluate(i, t)) << i << " " << j;
+        EXPECT_EQ(polynomial.EvaluateDerivative(t),
+                  arena.EvaluateDerivative(i, t)) << i << " " << j;
+      }
+    }
+  }
+
+  Instant const t0_;
+  Time const step_ = 45 * Minute;
+  std::vector<not_null<std::unique_ptr<Polynomial<Position<World>, Instant>>>>
+      polynomials_;
+  std::vector<Instant> t_mins_;
+};
+
+TEST_F(PolynomialArenaTest, Evaluate) {
+  PolynomialArena<World> arena;
+  EXPECT_TRUE(arena.empty());
+  for (auto const& polynomial : polynomials_) {
+    arena.Append(*polynomial);
+  }
+  EXPECT_FALSE(arena.empty());
+  EXPECT_EQ(polynomials_.size(), arena.size());
+  ExpectSameEvaluations(arena, /*first=*/0);
+
+  // Degrees 3 to 17 take 3 * (4 + ... + 18) doubles.
+  EXPECT_EQ(3 * 165 * sizeof(double) + 15 * 24, arena.size_in_bytes());
+}
+
+TEST_F(PolynomialArenaTest, Get) {
+  PolynomialArena<World> arena;
+  for (auto const& polynomial : polynomials_) {
+    arena.Append(*polynomial);
+  }
+  for (int i = 0; i < arena.size(); ++i) {
+    serialization::Polynomial expected;
+    polynomials_[i]->WriteToMessage(&expected);
+    serialization::Polynomial actual;
+    arena.Get(i)->WriteToMessage(&actual);
+    EXPECT_THAT(actual, EqualsProto(expected)) << i;
+  }
+}
+
+TEST_F(PolynomialArenaTest, TruncateAndPrepend) {
+  PolynomialArena<World> prefix;
+  PolynomialArena<World> arena;
+  for (int i = 0; i < 5; ++i) {
+    prefix.Append(*polynomials_[i]);
+  }
+  for (int i = 5; i < polynomials_.size(); ++i) {
+    arena.Append(*polynomials_[i]);
+  }
+
+  arena.Truncate(20);
+  EXPECT_EQ(10, arena.size());
+  arena.Truncate(7);
+  EXPECT_EQ(7, arena.size());
+  ExpectSameEvaluations(arena, /*first=*/5);
+
+  arena.Prepend(std::move(prefix));
+  EXPECT_TRUE(prefix.empty());
+  EXPECT_EQ(12, arena.size());
+  ExpectSameEvaluations(arena, /*first=*/0);
+
+  // Appending after truncation reuses the space of the removed polynomials.
+  arena.Truncate(3);
+  for (int i = 3; i < polynomials_.size(); ++i) {
+    arena.Append(*polynomials_[i]);
+  }
+  ExpectSameEvaluations(arena, /*first=*/0);
+}
+
+}  // namespace numerics
+}  // namespace principia
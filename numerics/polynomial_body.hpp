@@ -446,6 +446,13 @@ is_zero() const {
   return coefficients_ == Coefficients{};
 }
 
+template<typename Value_, typename Argument_, int degree_,
+         template<typename, typename, int> typename Evaluator>
+auto PolynomialInMonomialBasis<Value_, Argument_, degree_, Evaluator>::
+coefficients() const -> Coefficients const& {
+  return coefficients_;
+}
+
 template<typename Value_, typename Argument_, int degree_,
          template<typename, typename, int> typename Evaluator>
 Argument_ const&
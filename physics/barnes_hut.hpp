@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "physics/point_mass_accelerations.hpp"
+
+namespace principia {
+namespace physics {
+namespace _barnes_hut {
+namespace internal {
+
+using namespace principia::physics::_point_mass_accelerations;
+
+// An octree over a set of point masses, used to approximate the gravitational
+// accelerations between them in O(N log N) instead of O(N²) (Barnes and Hut,
+// 1986).  A cell of the tree of size s whose centre of mass is at a distance d
+// from a body is replaced by a point mass if s < θ d, where θ is the opening
+// angle.  Otherwise the cell is opened and its children are examined.  The
+// cells that contain the body are always opened, and the interactions with
+// the bodies of the leaves that are reached are computed exactly, so that
+// close pairs are never approximated.  The tree may be reused for successive
+// sets of point masses, in which case its storage is recycled.
+class BarnesHutTree final {
+ public:
+  // Builds the tree for the positions and gravitational parameters in
+  // |arrays|.  The accelerations in |arrays| are ignored.
+  void Build(PointMassArrays const& arrays);
+
+  // Adds to the accelerations in |arrays| the approximate gravitational
+  // accelerations between the bodies, which must be those given to the last
+  // call to |Build|.  An |opening_angle| of 0 results in all the interactions
+  // being computed exactly.
+  void AccumulateAccelerations(double opening_angle, PointMassArrays& arrays);
+
+ private:
+  // Cells with at most that many bodies are not subdivided: it is cheaper to
+  // compute their interactions exactly than to traverse deeper levels.
+  static constexpr std::int64_t max_bodies_per_leaf = 8;
+  // The maximal depth of the tree.  It limits the recursion if bodies are
+  // coincident or nearly so, in which case they share a leaf.
+  static constexpr int max_depth = 48;
+
+  struct Cell {
+    // The geometric centre and half the size of the cell.
+    double centre_x;
+    double centre_y;
+    double centre_z;
+    double half_size;
+    // The total gravitational parameter and the centre of mass of the bodies
+    // in the cell.
+    double μ = 0;
+    double centre_of_mass_x = 0;
+    double centre_of_mass_y = 0;
+    double centre_of_mass_z = 0;
+    // The bodies in the cell are |bodies_[bodies_begin, bodies_end[|.
+    std::int64_t bodies_begin;
+    std::int64_t bodies_end;
+    // The children of a non-leaf cell are
+    // |cells_[children_begin, children_end[|; the empty octants have no cell.
+    // Both are 0 for a leaf.
+    std::int64_t children_begin = 0;
+    std::int64_t children_end = 0;
+  };
+
+  // Fills the cell with index |c|, whose geometry and range of bodies must
+  // have been set, and creates its descendants.
+  void BuildCell(std::int64_t c, int depth, PointMassArrays const& arrays);
+
+  // The indices of the bodies in |arrays|, ordered so that the bodies of each
+  // cell are contiguous.
+  std::vector<std::int64_t> bodies_;
+  // The root is at index 0.  Empty if there are no bodies.
+  std::vector<Cell> cells_;
+  // Scratch storage for |AccumulateAccelerations|.
+  std::vector<std::int64_t> stack_;
+};
+
+}  // namespace internal
+
+using internal::BarnesHutTree;
+
+}  // namespace _barnes_hut
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/barnes_hut_body.hpp"
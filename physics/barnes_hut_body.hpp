@@ -0,0 +1,222 @@
+#pragma once
+
+#include "physics/barnes_hut.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace physics {
+namespace _barnes_hut {
+namespace internal {
+
+inline void BarnesHutTree::Build(PointMassArrays const& arrays) {
+  std::int64_t const size = arrays.x.size();
+  bodies_.resize(size);
+  std::iota(bodies_.begin(), bodies_.end(), 0);
+  cells_.clear();
+  if (size == 0) {
+    return;
+  }
+
+  // The root is the smallest cube that contains all the bodies.
+  auto const [min_x, max_x] =
+      std::minmax_element(arrays.x.begin(), arrays.x.end());
+  auto const [min_y, max_y] =
+      std::minmax_element(arrays.y.begin(), arrays.y.end());
+  auto const [min_z, max_z] =
+      std::minmax_element(arrays.z.begin(), arrays.z.end());
+  Cell& root = cells_.emplace_back();
+  root.centre_x = (*min_x + *max_x) / 2;
+  root.centre_y = (*min_y + *max_y) / 2;
+  root.centre_z = (*min_z + *max_z) / 2;
+  root.half_size =
+      std::max({*max_x - *min_x, *max_y - *min_y, *max_z - *min_z}) / 2;
+  root.bodies_begin = 0;
+  root.bodies_end = size;
+  BuildCell(/*c=*/0, /*depth=*/0, arrays);
+}
+
+inline void BarnesHutTree::AccumulateAccelerations(double const opening_angle,
+                                                   PointMassArrays& arrays) {
+  if (cells_.empty()) {
+    return;
+  }
+  CHECK_GE(opening_angle, 0);
+  double const opening_angle² = opening_angle * opening_angle;
+  std::int64_t const size = bodies_.size();
+  for (std::int64_t b1 = 0; b1 < size; ++b1) {
+    double const x1 = arrays.x[b1];
+    double const y1 = arrays.y[b1];
+    double const z1 = arrays.z[b1];
+    double ax1 = 0;
+    double ay1 = 0;
+    double az1 = 0;
+    // Adds the acceleration exerted on |b1| by a point mass |μ2| located at
+    // (|x2|, |y2|, |z2|).
+    auto const accumulate =
+        [x1, y1, z1, &ax1, &ay1, &az1](
+            double const x2, double const y2, double const z2,
+            double const μ2) {
+          // A vector from the point mass to the center of |b1|.
+          double const Δx = x1 - x2;
+          double const Δy = y1 - y2;
+          double const Δz = z1 - z2;
+
+          double const Δq² = Δx * Δx + Δy * Δy + Δz * Δz;
+          double const Δq_norm = std::sqrt(Δq²);
+          double const μ2_over_Δq³ = μ2 * Δq_norm / (Δq² * Δq²);
+          ax1 -= Δx * μ2_over_Δq³;
+          ay1 -= Δy * μ2_over_Δq³;
+          az1 -= Δz * μ2_over_Δq³;
+        };
+
+    stack_.clear();
+    stack_.push_back(0);
+    while (!stack_.empty()) {
+      Cell const& cell = cells_[stack_.back()];
+      stack_.pop_back();
+      if (cell.children_begin == cell.children_end) {
+        for (std::int64_t i = cell.bodies_begin; i < cell.bodies_end; ++i) {
+          std::int64_t const b2 = bodies_[i];
+          if (b2 != b1) {
+            accumulate(arrays.x[b2], arrays.y[b2], arrays.z[b2], arrays.μ[b2]);
+          }
+        }
+        continue;
+      }
+
+      bool const contains_b1 =
+          std::abs(x1 - cell.centre_x) <= cell.half_size &&
+          std::abs(y1 - cell.centre_y) <= cell.half_size &&
+          std::abs(z1 - cell.centre_z) <= cell.half_size;
+      double const Δx = x1 - cell.centre_of_mass_x;
+      double const Δy = y1 - cell.centre_of_mass_y;
+      double const Δz = z1 - cell.centre_of_mass_z;
+      double const Δq² = Δx * Δx + Δy * Δy + Δz * Δz;
+      // The size of the cell is twice its half size.
+      if (!contains_b1 &&
+          4 * cell.half_size * cell.half_size < opening_angle² * Δq²) {
+        accumulate(cell.centre_of_mass_x,
+                   cell.centre_of_mass_y,
+                   cell.centre_of_mass_z,
+                   cell.μ);
+      } else {
+        // Push the children in reverse order so that they are popped in
+        // order.
+        for (std::int64_t c = cell.children_end - 1;
+             c >= cell.children_begin;
+             --c) {
+          stack_.push_back(c);
+        }
+      }
+    }
+
+    arrays.ax[b1] += ax1;
+    arrays.ay[b1] += ay1;
+    arrays.az[b1] += az1;
+  }
+}
+
+inline void BarnesHutTree::BuildCell(std::int64_t const c,
+                                     int const depth,
+                                     PointMassArrays const& arrays) {
+  // Note that |cells_| is extended below, so we must not hold a reference to
+  // |cell| across insertions.
+  {
+    Cell& cell = cells_[c];
+    double μ = 0;
+    double μx = 0;
+    double μy = 0;
+    double μz = 0;
+    for (std::int64_t i = cell.bodies_begin; i < cell.bodies_end; ++i) {
+      std::int64_t const b = bodies_[i];
+      μ += arrays.μ[b];
+      μx += arrays.μ[b] * arrays.x[b];
+      μy += arrays.μ[b] * arrays.y[b];
+      μz += arrays.μ[b] * arrays.z[b];
+    }
+    cell.μ = μ;
+    if (μ == 0) {
+      // The bodies are massless, the centre of mass doesn't matter.
+      cell.centre_of_mass_x = cell.centre_x;
+      cell.centre_of_mass_y = cell.centre_y;
+      cell.centre_of_mass_z = cell.centre_z;
+    } else {
+      cell.centre_of_mass_x = μx / μ;
+      cell.centre_of_mass_y = μy / μ;
+      cell.centre_of_mass_z = μz / μ;
+    }
+    if (cell.bodies_end - cell.bodies_begin <= max_bodies_per_leaf ||
+        depth == max_depth ||
+        cell.half_size == 0) {
+      return;
+    }
+  }
+
+  Cell const parent = cells_[c];
+  // Partition the bodies of the cell by octant.  The octant with index
+  // |octant| has its bodies in |bodies_[octant_begins[octant],
+  // octant_begins[octant + 1][|; bit 2 (resp. 1, 0) of |octant| indicates that
+  // the octant is on the positive side of the centre along x (resp. y, z).
+  using Iterator = std::vector<std::int64_t>::iterator;
+  std::array<Iterator, 9> octant_begins;
+  octant_begins[0] = bodies_.begin() + parent.bodies_begin;
+  octant_begins[8] = bodies_.begin() + parent.bodies_end;
+  auto const partition = [](Iterator const begin,
+                            Iterator const end,
+                            std::vector<double> const& coordinates,
+                            double const centre) {
+    return std::partition(begin, end, [&coordinates, centre](std::int64_t b) {
+      return coordinates[b] < centre;
+    });
+  };
+  octant_begins[4] = partition(
+      octant_begins[0], octant_begins[8], arrays.x, parent.centre_x);
+  for (int octant = 0; octant < 8; octant += 4) {
+    octant_begins[octant + 2] = partition(octant_begins[octant],
+                                          octant_begins[octant + 4],
+                                          arrays.y,
+                                          parent.centre_y);
+  }
+  for (int octant = 0; octant < 8; octant += 2) {
+    octant_begins[octant + 1] = partition(octant_begins[octant],
+                                          octant_begins[octant + 2],
+                                          arrays.z,
+                                          parent.centre_z);
+  }
+
+  std::int64_t const children_begin = cells_.size();
+  double const child_half_size = parent.half_size / 2;
+  for (int octant = 0; octant < 8; ++octant) {
+    if (octant_begins[octant] == octant_begins[octant + 1]) {
+      continue;
+    }
+    Cell& child = cells_.emplace_back();
+    child.centre_x =
+        parent.centre_x + ((octant & 4) ? child_half_size : -child_half_size);
+    child.centre_y =
+        parent.centre_y + ((octant & 2) ? child_half_size : -child_half_size);
+    child.centre_z =
+        parent.centre_z + ((octant & 1) ? child_half_size : -child_half_size);
+    child.half_size = child_half_size;
+    child.bodies_begin = octant_begins[octant] - bodies_.begin();
+    child.bodies_end = octant_begins[octant + 1] - bodies_.begin();
+  }
+  std::int64_t const children_end = cells_.size();
+  cells_[c].children_begin = children_begin;
+  cells_[c].children_end = children_end;
+
+  for (std::int64_t child = children_begin; child < children_end; ++child) {
+    BuildCell(child, depth + 1, arrays);
+  }
+}
+
+}  // namespace internal
+}  // namespace _barnes_hut
+}  // namespace physics
+}  // namespace principia
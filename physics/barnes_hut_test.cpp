@@ -0,0 +1,142 @@
+#include "physics/barnes_hut.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "physics/point_mass_accelerations.hpp"
+
+namespace principia {
+namespace physics {
+namespace _barnes_hut {
+namespace internal {
+
+using ::testing::Gt;
+using ::testing::Lt;
+using namespace principia::physics::_point_mass_accelerations;
+
+class BarnesHutTest : public testing::Test {
+ protected:
+  static constexpr std::int64_t number_of_bodies = 500;
+
+  BarnesHutTest() {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<> position_distribution(-1e12, 1e12);
+    std::uniform_real_distribution<> μ_distribution(1e5, 1e20);
+    arrays_.Reset(number_of_bodies);
+    for (std::int64_t b = 0; b < number_of_bodies; ++b) {
+      arrays_.x[b] = position_distribution(random);
+      arrays_.y[b] = position_distribution(random);
+      arrays_.z[b] = position_distribution(random);
+      arrays_.μ[b] = μ_distribution(random);
+    }
+  }
+
+  // Computes all the mutual accelerations exactly.
+  PointMassArrays ExactAccelerations() const {
+    PointMassArrays expected = arrays_;
+    for (std::int64_t b1 = 0; b1 < number_of_bodies; ++b1) {
+      AccumulateMutualAccelerations(
+          b1, /*b2_begin=*/b1 + 1, /*b2_end=*/number_of_bodies, expected);
+    }
+    return expected;
+  }
+
+  // Returns the largest relative error on the norm of the accelerations.
+  double MaxRelativeError(PointMassArrays const& actual,
+                          PointMassArrays const& expected) const {
+    double max_relative_error = 0;
+    for (std::int64_t b = 0; b < number_of_bodies; ++b) {
+      double const Δax = actual.ax[b] - expected.ax[b];
+      double const Δay = actual.ay[b] - expected.ay[b];
+      double const Δaz = actual.az[b] - expected.az[b];
+      max_relative_error = std::max(
+          max_relative_error,
+          std::sqrt((Δax * Δax + Δay * Δay + Δaz * Δaz) /
+                    (expected.ax[b] * expected.ax[b] +
+                     expected.ay[b] * expected.ay[b] +
+                     expected.az[b] * expected.az[b])));
+    }
+    return max_relative_error;
+  }
+
+  PointMassArrays arrays_;
+};
+
+TEST_F(BarnesHutTest, Exact) {
+  // With an opening angle of 0 all the cells are opened, so only the order of
+  // the summations differs from the exact computation.
+  BarnesHutTree tree;
+  tree.Build(arrays_);
+  PointMassArrays actual = arrays_;
+  tree.AccumulateAccelerations(/*opening_angle=*/0, actual);
+  EXPECT_THAT(MaxRelativeError(actual, ExactAccelerations()), Lt(1e-13));
+}
+
+TEST_F(BarnesHutTest, Approximate) {
+  PointMassArrays const expected = ExactAccelerations();
+  BarnesHutTree tree;
+  tree.Build(arrays_);
+
+  PointMassArrays coarse = arrays_;
+  tree.AccumulateAccelerations(/*opening_angle=*/0.5, coarse);
+  double const coarse_error = MaxRelativeError(coarse, expected);
+
+  PointMassArrays fine = arrays_;
+  tree.AccumulateAccelerations(/*opening_angle=*/0.1, fine);
+  double const fine_error = MaxRelativeError(fine, expected);
+
+  EXPECT_THAT(fine_error, Gt(0));
+  EXPECT_THAT(fine_error, Lt(1e-3));
+  EXPECT_THAT(coarse_error, Gt(fine_error));
+  EXPECT_THAT(coarse_error, Lt(2e-1));
+}
+
+TEST_F(BarnesHutTest, Reuse) {
+  // A tree that was built for other bodies gives the same results as a new
+  // one.
+  PointMassArrays other;
+  other.Reset(3);
+  other.x = {1, 2, 3};
+  other.y = {-1, 0, 1};
+  other.z = {5, 5, 5};
+  other.μ = {1, 1, 1};
+  BarnesHutTree reused_tree;
+  reused_tree.Build(other);
+  reused_tree.AccumulateAccelerations(/*opening_angle=*/0.5, other);
+  reused_tree.Build(arrays_);
+  PointMassArrays reused = arrays_;
+  reused_tree.AccumulateAccelerations(/*opening_angle=*/0.5, reused);
+
+  BarnesHutTree new_tree;
+  new_tree.Build(arrays_);
+  PointMassArrays expected = arrays_;
+  new_tree.AccumulateAccelerations(/*opening_angle=*/0.5, expected);
+
+  EXPECT_EQ(expected.ax, reused.ax);
+  EXPECT_EQ(expected.ay, reused.ay);
+  EXPECT_EQ(expected.az, reused.az);
+}
+
+TEST_F(BarnesHutTest, CoincidentBodies) {
+  // Two bodies at the same position end up in the same leaf, and the depth of
+  // the tree remains bounded.  Their mutual acceleration is not finite, but
+  // that of the other bodies is.
+  arrays_.x[1] = arrays_.x[0];
+  arrays_.y[1] = arrays_.y[0];
+  arrays_.z[1] = arrays_.z[0];
+  BarnesHutTree tree;
+  tree.Build(arrays_);
+  PointMassArrays actual = arrays_;
+  tree.AccumulateAccelerations(/*opening_angle=*/0.5, actual);
+  for (std::int64_t b = 2; b < number_of_bodies; ++b) {
+    EXPECT_TRUE(std::isfinite(actual.ax[b])) << b;
+  }
+}
+
+}  // namespace internal
+}  // namespace _barnes_hut
+}  // namespace physics
+}  // namespace principia
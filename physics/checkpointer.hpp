@@ -1,6 +1,11 @@
 #pragma once
 
+#include <concepts>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
 
 #include "absl/container/btree_map.h"
 #include "absl/container/btree_set.h"
@@ -35,6 +40,7 @@ using namespace principia::quantities::_quantities;
 // The |Message| must declare a nested message named |Checkpoint|, which must
 // have a field named |time| of type |Point|.  There must be a repeated field of
 // |Checkpoint|s in |Message|.
+// The checkpoints may optionally be stored as deltas, see the constructor.
 // This class is thread-safe.  The callbacks are not run under a lock.
 template<typename Message>
 class Checkpointer {
@@ -48,7 +54,20 @@ class Checkpointer {
   using Reader =
       std::function<absl::Status(typename Message::Checkpoint const&)>;
 
-  Checkpointer(Writer writer, Reader reader);
+  // If |keyframe_interval| is greater than 1, only one checkpoint out of
+  // |keyframe_interval| (a keyframe) is stored in full; the others are stored
+  // as a delta with respect to the serialization of the previous checkpoint,
+  // which is usually much smaller since consecutive checkpoints tend to share
+  // most of their contents.  A checkpoint for which the delta would not be
+  // smaller than the full checkpoint is stored in full.  The deltas are
+  // preserved by |WriteToMessage| and |ReadFromMessage|, and the checkpoints
+  // are reconstructed transparently before being passed to the |Reader|.  This
+  // requires the |Checkpoint| to be a protocol buffer with a |bytes delta|
+  // field, in which case all its fields other than |time| and |delta| must be
+  // optional.
+  Checkpointer(Writer writer,
+               Reader reader,
+               std::int64_t keyframe_interval = 1);
 
   // Returns the oldest checkpoint in this object, or +∞ if no checkpoint was
   // ever created.
@@ -121,24 +140,69 @@ class Checkpointer {
       Writer writer,
       Reader reader,
       google::protobuf::RepeatedPtrField<typename Message::Checkpoint> const&
-          message);
+          message,
+      std::int64_t keyframe_interval = 1);
 
  private:
-  using CheckpointsByTime =
-      absl::btree_map<Instant, typename Message::Checkpoint>;
+  using Checkpoint = typename Message::Checkpoint;
+  using CheckpointsByTime = absl::btree_map<Instant, Checkpoint>;
+
+  // Whether |Checkpoint| may be stored as a delta, see the constructor.
+  static constexpr bool supports_deltas =
+      requires(Checkpoint& checkpoint, std::string* const bytes) {
+        { checkpoint.has_delta() } -> std::same_as<bool>;
+        { checkpoint.mutable_delta() } -> std::same_as<std::string*>;
+        checkpoint.clear_time();
+        checkpoint.ParsePartialFromString(*bytes);
+        checkpoint.SerializePartialToString(bytes);
+      };
 
   void WriteToCheckpointLocked(Instant const& t)
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // If the checkpoint designated by |it| is a delta, reconstructs it in
+  // |reconstructed| and returns a pointer to it.  Otherwise returns a pointer
+  // to the stored checkpoint.
+  Checkpoint const* FullCheckpoint(
+      typename CheckpointsByTime::const_iterator it,
+      std::unique_ptr<Checkpoint>& reconstructed) const
+      SHARED_LOCKS_REQUIRED(lock_);
+
+  // Returns the serialization of the checkpoint designated by |it|, obtained by
+  // applying the deltas starting from the preceding keyframe.
+  std::string SerializedCheckpoint(
+      typename CheckpointsByTime::const_iterator it) const
+      SHARED_LOCKS_REQUIRED(lock_);
+
   mutable absl::Mutex lock_;
   Writer const writer_;
   Reader const reader_;
+  std::int64_t const keyframe_interval_;
 
   // The time field of the Checkpoint message may or may not be set.  The map
   // key is the source of truth.
   CheckpointsByTime checkpoints_;
+
+  // Only used when storing deltas.  The number of deltas written since the
+  // last keyframe, and the serialization of the newest checkpoint, from which
+  // the delta for the next one is computed.  |newest_serialized_checkpoint_| is
+  // empty if the next checkpoint must be a keyframe.
+  std::int64_t deltas_since_keyframe_ GUARDED_BY(lock_) = 0;
+  std::string newest_serialized_checkpoint_ GUARDED_BY(lock_);
 };
 
+// Returns a delta that transforms |base| into |target|.  The delta is the
+// size of |target| followed by the bytewise exclusive or of |base| and
+// |target| (where |base| is extended with zeroes), in which the runs of zeroes
+// are encoded by their length.  Small changes to a serialized message thus
+// result in small deltas.
+inline std::string EncodeDelta(std::string_view base,
+                               std::string_view target);
+
+// Returns the |target| such that |delta == EncodeDelta(base, target)|.
+inline std::string DecodeDelta(std::string_view base,
+                               std::string_view delta);
+
 }  // namespace internal
 
 using internal::Checkpointer;
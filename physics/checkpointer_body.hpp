@@ -3,8 +3,10 @@
 #include "physics/checkpointer.hpp"
 
 #include <map>
-#include <vector>
+#include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/btree_set.h"
 #include "base/status_utilities.hpp"
@@ -14,10 +16,99 @@ namespace physics {
 namespace _checkpointer {
 namespace internal {
 
+// Appends |value| to |bytes| as a base-128 varint.
+inline void AppendVarint(std::uint64_t value, std::string& bytes) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<char>(value));
+}
+
+// Reads a base-128 varint at the beginning of |bytes| and removes it.
+inline std::uint64_t ExtractVarint(std::string_view& bytes) {
+  std::uint64_t value = 0;
+  for (int shift = 0;; shift += 7) {
+    CHECK(!bytes.empty());
+    CHECK_LT(shift, 64);
+    auto const byte = static_cast<std::uint8_t>(bytes.front());
+    bytes.remove_prefix(1);
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if (byte < 0x80) {
+      return value;
+    }
+  }
+}
+
+inline std::string EncodeDelta(std::string_view const base,
+                               std::string_view const target) {
+  std::int64_t const size = target.size();
+  auto const exclusive_or = [base, target](std::int64_t const i) -> char {
+    return i < static_cast<std::int64_t>(base.size()) ? target[i] ^ base[i]
+                                                      : target[i];
+  };
+  // A literal is terminated by two consecutive zeroes, since encoding shorter
+  // runs of zeroes would not save space.
+  auto const ends_literal = [size, &exclusive_or](std::int64_t const i) {
+    return i == size ||
+           (exclusive_or(i) == 0 && i + 1 < size && exclusive_or(i + 1) == 0);
+  };
+
+  std::string delta;
+  AppendVarint(size, delta);
+  std::int64_t i = 0;
+  for (;;) {
+    std::int64_t const zeroes_begin = i;
+    while (i < size && exclusive_or(i) == 0) {
+      ++i;
+    }
+    if (i == size) {
+      // Trailing zeroes are implicit.
+      break;
+    }
+    std::int64_t const literal_begin = i;
+    while (!ends_literal(i)) {
+      ++i;
+    }
+    AppendVarint(literal_begin - zeroes_begin, delta);
+    AppendVarint(i - literal_begin, delta);
+    for (std::int64_t j = literal_begin; j < i; ++j) {
+      delta.push_back(exclusive_or(j));
+    }
+  }
+  return delta;
+}
+
+inline std::string DecodeDelta(std::string_view const base,
+                               std::string_view delta) {
+  std::int64_t const size = ExtractVarint(delta);
+  std::string target(base.substr(0, size));
+  target.resize(size, '\0');
+  std::int64_t i = 0;
+  while (!delta.empty()) {
+    i += ExtractVarint(delta);
+    std::int64_t const literal_size = ExtractVarint(delta);
+    CHECK_LE(i + literal_size, size);
+    CHECK_LE(literal_size, static_cast<std::int64_t>(delta.size()));
+    for (std::int64_t j = 0; j < literal_size; ++j, ++i) {
+      target[i] ^= delta[j];
+    }
+    delta.remove_prefix(literal_size);
+  }
+  return target;
+}
+
 template<typename Message>
-Checkpointer<Message>::Checkpointer(Writer writer, Reader reader)
+Checkpointer<Message>::Checkpointer(Writer writer,
+                                    Reader reader,
+                                    std::int64_t const keyframe_interval)
     : writer_(std::move(writer)),
-      reader_(std::move(reader)) {}
+      reader_(std::move(reader)),
+      keyframe_interval_(keyframe_interval) {
+  CHECK_LE(1, keyframe_interval_);
+  CHECK(keyframe_interval_ == 1 || supports_deltas)
+      << "Checkpoints cannot be stored as deltas";
+}
 
 template<typename Message>
 Instant Checkpointer<Message>::oldest_checkpoint() const {
@@ -135,26 +226,28 @@ bool Checkpointer<Message>::WriteToCheckpointIfNeeded(
 
 template<typename Message>
 absl::Status Checkpointer<Message>::ReadFromOldestCheckpoint() const {
-  typename Message::Checkpoint const* checkpoint = nullptr;
+  Checkpoint const* checkpoint = nullptr;
+  std::unique_ptr<Checkpoint> reconstructed;
   {
     absl::ReaderMutexLock l(&lock_);
     if (checkpoints_.empty()) {
       return absl::NotFoundError("No checkpoint");
     }
-    checkpoint = &checkpoints_.cbegin()->second;
+    checkpoint = FullCheckpoint(checkpoints_.cbegin(), reconstructed);
   }
   return reader_(*checkpoint);
 }
 
 template<typename Message>
 absl::Status Checkpointer<Message>::ReadFromNewestCheckpoint() const {
-  typename Message::Checkpoint const* checkpoint = nullptr;
+  Checkpoint const* checkpoint = nullptr;
+  std::unique_ptr<Checkpoint> reconstructed;
   {
     absl::ReaderMutexLock l(&lock_);
     if (checkpoints_.empty()) {
       return absl::NotFoundError("No checkpoint");
     }
-    checkpoint = &checkpoints_.crbegin()->second;
+    checkpoint = FullCheckpoint(std::prev(checkpoints_.cend()), reconstructed);
   }
   return reader_(*checkpoint);
 }
@@ -162,7 +255,8 @@ absl::Status Checkpointer<Message>::ReadFromNewestCheckpoint() const {
 template<typename Message>
 absl::Status Checkpointer<Message>::ReadFromCheckpointAtOrBefore(
     Instant const& t) const {
-  typename Message::Checkpoint const* checkpoint = nullptr;
+  Checkpoint const* checkpoint = nullptr;
+  std::unique_ptr<Checkpoint> reconstructed;
   {
     absl::ReaderMutexLock l(&lock_);
     // |it| denotes an entry strictly greater than |t| (or end).
@@ -170,7 +264,7 @@ absl::Status Checkpointer<Message>::ReadFromCheckpointAtOrBefore(
     if (it == checkpoints_.cbegin()) {
       return absl::NotFoundError("No checkpoint");
     }
-    checkpoint = &std::prev(it)->second;
+    checkpoint = FullCheckpoint(std::prev(it), reconstructed);
   }
   return reader_(*checkpoint);
 }
@@ -179,15 +273,17 @@ template<typename Message>
 absl::Status Checkpointer<Message>::ReadFromCheckpointAt(
     Instant const& t,
     Reader const& reader) const {
-  typename CheckpointsByTime::const_iterator it;
+  Checkpoint const* checkpoint = nullptr;
+  std::unique_ptr<Checkpoint> reconstructed;
   {
     absl::ReaderMutexLock l(&lock_);
-    it = checkpoints_.find(t);
+    auto const it = checkpoints_.find(t);
     if (it == checkpoints_.end()) {
       return absl::NotFoundError("No checkpoint found");
     }
+    checkpoint = FullCheckpoint(it, reconstructed);
   }
-  return reader(it->second);
+  return reader(*checkpoint);
 }
 
 template<typename Message>
@@ -214,12 +310,18 @@ Checkpointer<Message>::ReadFromMessage(
     Writer writer,
     Reader reader,
     google::protobuf::RepeatedPtrField<typename Message::Checkpoint> const&
-        message) {
-  auto checkpointer =
-      std::make_unique<Checkpointer>(std::move(writer), std::move(reader));
+        message,
+    std::int64_t const keyframe_interval) {
+  auto checkpointer = std::make_unique<Checkpointer>(
+      std::move(writer), std::move(reader), keyframe_interval);
   for (const auto& checkpoint : message) {
     Instant const time = Instant::ReadFromMessage(checkpoint.time());
-    checkpointer->checkpoints_.emplace(time, checkpoint);
+    auto const [it, _] = checkpointer->checkpoints_.emplace(time, checkpoint);
+    if constexpr (supports_deltas) {
+      // The deltas were computed on checkpoints without a time, see
+      // |WriteToCheckpointLocked|.
+      it->second.clear_time();
+    }
   }
   return std::move(checkpointer);
 }
@@ -228,11 +330,83 @@ template<typename Message>
 void Checkpointer<Message>::WriteToCheckpointLocked(Instant const& t) {
   lock_.AssertHeld();
   CHECK(!checkpoints_.contains(t)) << t;
+  if constexpr (supports_deltas) {
+    // Inserting a checkpoint in the middle of a chain of deltas would break
+    // the chain, so the next checkpoint must be stored in full.
+    auto const next = checkpoints_.upper_bound(t);
+    if (next != checkpoints_.end() && next->second.has_delta()) {
+      CHECK(next->second.ParsePartialFromString(SerializedCheckpoint(next)));
+    }
+  }
   auto const it = checkpoints_.emplace_hint(
       checkpoints_.end(), t, typename Message::Checkpoint());
   lock_.Unlock();
   writer_(&it->second);
   lock_.Lock();
+
+  if constexpr (supports_deltas) {
+    if (keyframe_interval_ == 1) {
+      return;
+    }
+    // The time is not part of the delta since it is given by the key.
+    Checkpoint& checkpoint = it->second;
+    checkpoint.clear_time();
+    std::string serialized;
+    CHECK(checkpoint.SerializePartialToString(&serialized));
+    bool const is_newest = std::next(it) == checkpoints_.end();
+    bool stored_as_delta = false;
+    if (is_newest &&
+        !newest_serialized_checkpoint_.empty() &&
+        deltas_since_keyframe_ + 1 < keyframe_interval_) {
+      std::string delta = EncodeDelta(newest_serialized_checkpoint_,
+                                      serialized);
+      if (delta.size() < serialized.size()) {
+        checkpoint.Clear();
+        *checkpoint.mutable_delta() = std::move(delta);
+        stored_as_delta = true;
+      }
+    }
+    if (is_newest) {
+      deltas_since_keyframe_ =
+          stored_as_delta ? deltas_since_keyframe_ + 1 : 0;
+      newest_serialized_checkpoint_ = std::move(serialized);
+    }
+  }
+}
+
+template<typename Message>
+auto Checkpointer<Message>::FullCheckpoint(
+    typename CheckpointsByTime::const_iterator const it,
+    std::unique_ptr<Checkpoint>& reconstructed) const -> Checkpoint const* {
+  if constexpr (supports_deltas) {
+    if (it->second.has_delta()) {
+      reconstructed = std::make_unique<Checkpoint>();
+      CHECK(reconstructed->ParsePartialFromString(SerializedCheckpoint(it)));
+      return reconstructed.get();
+    }
+  }
+  return &it->second;
+}
+
+template<typename Message>
+std::string Checkpointer<Message>::SerializedCheckpoint(
+    typename CheckpointsByTime::const_iterator const it) const {
+  std::string serialized;
+  if constexpr (supports_deltas) {
+    auto keyframe = it;
+    while (keyframe->second.has_delta()) {
+      CHECK(keyframe != checkpoints_.cbegin())
+          << "No keyframe before " << it->first;
+      --keyframe;
+    }
+    CHECK(keyframe->second.SerializePartialToString(&serialized));
+    for (auto delta = std::next(keyframe); delta != std::next(it); ++delta) {
+      serialized = DecodeDelta(serialized, delta->second.delta());
+    }
+  } else {
+    LOG(FATAL) << "Checkpoints cannot be stored as deltas";
+  }
+  return serialized;
 }
 
 }  // namespace internal
@@ -1,9 +1,12 @@
 #include "physics/checkpointer.hpp"
 
+#include <vector>
+
 #include "base/status_utilities.hpp"
 #include "geometry/instant.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "serialization/physics.pb.h"
 #include "testing_utilities/matchers.hpp"
 
 namespace principia {
@@ -236,5 +239,106 @@ TEST_F(CheckpointerTest, Serialization) {
   EXPECT_EQ(Instant() + 10 * Second, checkpointer->oldest_checkpoint());
 }
 
+// Checkpoints of an actual protocol buffer, which may be stored as deltas.
+class CheckpointerDeltaTest : public ::testing::Test {
+ protected:
+  using Checkpoint = serialization::Ephemeris::Checkpoint;
+
+  static constexpr int keyframe_interval = 4;
+
+  CheckpointerDeltaTest()
+      : checkpointer_(
+            [this](not_null<Checkpoint*> const checkpoint) {
+              *checkpoint = MakeCheckpoint(next_);
+            },
+            [this](Checkpoint const& checkpoint) {
+              read_ = checkpoint;
+              return absl::OkStatus();
+            },
+            keyframe_interval) {}
+
+  // A checkpoint whose contents vary slowly with |i|.
+  static Checkpoint MakeCheckpoint(int const i) {
+    Checkpoint checkpoint;
+    auto* const state = checkpoint.mutable_instance()->mutable_current_state();
+    state->mutable_time()->mutable_value()->mutable_point()->mutable_scalar()
+        ->set_magnitude(i);
+    for (int b = 0; b < 10; ++b) {
+      state->add_position()->mutable_value()->mutable_point()
+          ->mutable_scalar()->set_magnitude(1e9 * (b + 1) + i);
+      state->add_velocity()->mutable_value()->mutable_point()
+          ->mutable_scalar()->set_magnitude(1e3 * (b + 1));
+    }
+    return checkpoint;
+  }
+
+  // Checks that the checkpoint at |t| was reconstructed as |MakeCheckpoint(i)|.
+  void ExpectCheckpointAt(Checkpointer<serialization::Ephemeris> const& c,
+                          Instant const& t,
+                          int const i) {
+    EXPECT_OK(c.ReadFromCheckpointAt(t));
+    EXPECT_THAT(read_.instance(), EqualsProto(MakeCheckpoint(i).instance()))
+        << i;
+  }
+
+  int next_ = 0;
+  Checkpoint read_;
+  Checkpointer<serialization::Ephemeris> checkpointer_;
+};
+
+TEST_F(CheckpointerDeltaTest, Deltas) {
+  std::vector<Instant> times;
+  for (next_ = 0; next_ < 10; ++next_) {
+    times.push_back(Instant() + next_ * Second);
+    checkpointer_.WriteToCheckpoint(times.back());
+  }
+  for (int i = 0; i < 10; ++i) {
+    ExpectCheckpointAt(checkpointer_, times[i], i);
+  }
+  EXPECT_OK(checkpointer_.ReadFromNewestCheckpoint());
+  EXPECT_THAT(read_.instance(), EqualsProto(MakeCheckpoint(9).instance()));
+
+  serialization::Ephemeris message;
+  checkpointer_.WriteToMessage(message.mutable_checkpoint());
+  ASSERT_EQ(10, message.checkpoint_size());
+  for (int i = 0; i < 10; ++i) {
+    auto const& checkpoint = message.checkpoint(i);
+    EXPECT_EQ(i, checkpoint.time().scalar().magnitude());
+    bool const is_keyframe = i % keyframe_interval == 0;
+    EXPECT_EQ(is_keyframe, checkpoint.has_instance()) << i;
+    EXPECT_EQ(!is_keyframe, checkpoint.has_delta()) << i;
+    if (!is_keyframe) {
+      EXPECT_LT(checkpoint.ByteSizeLong(),
+                MakeCheckpoint(i).ByteSizeLong() / 2) << i;
+    }
+  }
+
+  auto const checkpointer = Checkpointer<serialization::Ephemeris>::
+      ReadFromMessage(/*writer=*/nullptr,
+                      [this](Checkpoint const& checkpoint) {
+                        read_ = checkpoint;
+                        return absl::OkStatus();
+                      },
+                      message.checkpoint(),
+                      keyframe_interval);
+  for (int i = 0; i < 10; ++i) {
+    ExpectCheckpointAt(*checkpointer, times[i], i);
+  }
+}
+
+TEST_F(CheckpointerDeltaTest, InsertionInChain) {
+  for (next_ = 0; next_ < 3; ++next_) {
+    checkpointer_.WriteToCheckpoint(Instant() + 10 * next_ * Second);
+  }
+  // Insert a checkpoint before the last delta of the chain.
+  next_ = 42;
+  checkpointer_.WriteToCheckpoint(Instant() + 15 * Second);
+
+  ExpectCheckpointAt(checkpointer_, Instant(), 0);
+  ExpectCheckpointAt(checkpointer_, Instant() + 10 * Second, 1);
+  ExpectCheckpointAt(checkpointer_, Instant() + 15 * Second, 42);
+  ExpectCheckpointAt(checkpointer_, Instant() + 20 * Second, 2);
+}
+
 }  // namespace physics
 }  // namespace principia
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -12,6 +13,7 @@
 #include "geometry/space.hpp"
 #include "numerics/piecewise_poisson_series.hpp"
 #include "numerics/polynomial.hpp"
+#include "numerics/polynomial_arena.hpp"
 #include "numerics/polynomial_evaluators.hpp"
 #include "physics/checkpointer.hpp"
 #include "physics/degrees_of_freedom.hpp"
@@ -34,6 +36,7 @@ using namespace principia::geometry::_instant;
 using namespace principia::geometry::_space;
 using namespace principia::numerics::_piecewise_poisson_series;
 using namespace principia::numerics::_polynomial;
+using namespace principia::numerics::_polynomial_arena;
 using namespace principia::numerics::_polynomial_evaluators;
 using namespace principia::physics::_checkpointer;
 using namespace principia::physics::_degrees_of_freedom;
@@ -78,8 +81,8 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // Prepends the given |trajectory| to this one.  Ideally the last point of
   // |trajectory| should match the first point of this object.
   // Note the rvalue reference: |ContinuousTrajectory| is not moveable and not
-  // copyable, but the |InstantPolynomialPairs| are moveable and we really want
-  // to move them.  We could pass by non-const lvalue reference, but we would
+  // copyable, but the polynomials are moveable and we really want to move
+  // them.  We could pass by non-const lvalue reference, but we would
   // rather make it clear at the calling site that the object is consumed, so
   // we require the use of std::move.
   void Prepend(ContinuousTrajectory&& trajectory);
@@ -159,28 +162,29 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   DegreesOfFreedom<Frame> EvaluateDegreesOfFreedomLocked(
       Instant const& time) const;
 
+  // Returns the index of the polynomial applicable for |time|, which must be in
+  // [t_min, t_max].  The trajectories of an |Ephemeris| are appended to in
+  // lockstep, so their polynomials cover the same intervals and an index
+  // obtained from one of them may be passed to the functions below for all the
+  // others, thereby avoiding repeated searches.
+  std::int64_t PolynomialIndexLocked(Instant const& time) const;
+
+  // Same as the functions above, but |index| is a hint for the index of the
+  // polynomial applicable for |time|.  If it is not correct for this
+  // trajectory, a search takes place.
+  Position<Frame> EvaluatePositionLocked(Instant const& time,
+                                         std::int64_t index) const;
+  DegreesOfFreedom<Frame> EvaluateDegreesOfFreedomLocked(
+      Instant const& time,
+      std::int64_t index) const;
+
  protected:
   // For mocking.
   ContinuousTrajectory();
 
  private:
-  // Each polynomial is valid over an interval [t_min, t_max].  Polynomials are
-  // stored in this vector sorted by their |t_max|, as it turns out that we
-  // never need to extract their |t_min|.  Logically, the |t_min| for a
-  // polynomial is the |t_max| of the previous one.  The first polynomial has a
-  // |t_min| which is |*first_time_|.
-  struct InstantPolynomialPair {
-    InstantPolynomialPair(
-        Instant t_max,
-        not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
-            polynomial);
-    Instant t_max;
-    not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
-        polynomial;
-  };
-  using InstantPolynomialPairs = std::vector<InstantPolynomialPair>;
-
-  // Really a static method, but may be overridden for testing.
+  // Really a static method, but may be overridden for testing.  The result
+  // must be a |PolynomialArena<Frame>::PolynomialOfDegree|.
   virtual not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
   NewhallApproximationInMonomialBasis(
       int degree,
@@ -199,12 +203,17 @@ class ContinuousTrajectory : public Trajectory<Frame> {
       std::vector<Position<Frame>> const& q,
       std::vector<Velocity<Frame>> const& v) REQUIRES(lock_);
 
-  // Returns an iterator to the polynomial applicable for the given |time|, or
-  // |begin| if |time| is before the first polynomial or |end| if |time| is
-  // after the last polynomial.  If |time| is the |t_max| of some polynomial,
-  // that polynomial is returned.  Time complexity is O(N Log N).
-  typename InstantPolynomialPairs::const_iterator
-  FindPolynomialForInstantLocked(Instant const& time) const
+  // Returns the index of the polynomial applicable for the given |time|, or 0
+  // if |time| is before the first polynomial or |polynomials_.size()| if |time|
+  // is after the last polynomial.  If |time| is the |t_max| of some
+  // polynomial, that polynomial is returned.  Time complexity is O(N Log N).
+  std::int64_t FindPolynomialForInstantLocked(Instant const& time) const
+      REQUIRES_SHARED(lock_);
+
+  // Returns true if |index| is the index of a polynomial whose interval
+  // contains |time|.  Time complexity is O(1).
+  bool IsPolynomialForInstantLocked(std::int64_t index,
+                                    Instant const& time) const
       REQUIRES_SHARED(lock_);
 
   // Construction parameters;
@@ -226,8 +235,16 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   int degree_ GUARDED_BY(lock_);
   int degree_age_ GUARDED_BY(lock_);
 
-  // The polynomials are in increasing time order.
-  InstantPolynomialPairs polynomials_ GUARDED_BY(lock_);
+  // Each polynomial is valid over an interval [t_min, t_max].  Polynomials are
+  // stored in increasing time order, and their |t_max| is stored at the same
+  // index in |polynomial_t_maxes_|, as it turns out that we never need to
+  // extract their |t_min|.  Logically, the |t_min| for a polynomial is the
+  // |t_max| of the previous one.  The first polynomial has a |t_min| which is
+  // |*first_time_|.  The coefficients of all the polynomials are stored
+  // contiguously, which avoids a virtual call and some pointer chasing on each
+  // evaluation, and reduces the memory footprint.
+  std::vector<Instant> polynomial_t_maxes_ GUARDED_BY(lock_);
+  PolynomialArena<Frame> polynomials_ GUARDED_BY(lock_);
 
   // Lookups into |polynomials_| are expensive because they entail a binary
   // search into a vector that grows over time.  In benchmarks, this can be as
@@ -249,7 +266,7 @@ class ContinuousTrajectory : public Trajectory<Frame> {
 
   // The points that have not yet been incorporated in a polynomial.  Nonempty
   // for a nonempty trajectory.
-  // |last_points_.begin()->first == polynomials_.back().t_max|
+  // |last_points_.begin()->first == polynomial_t_maxes_.back()|
   std::vector<std::pair<Instant, DegreesOfFreedom<Frame>>> last_points_
       GUARDED_BY(lock_);
 
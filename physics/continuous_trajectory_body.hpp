@@ -70,8 +70,8 @@ double ContinuousTrajectory<Frame>::average_degree() const {
     return 0;
   } else {
     double total = 0;
-    for (auto const& pair : polynomials_) {
-      total += pair.polynomial->degree();
+    for (std::int64_t i = 0; i < polynomials_.size(); ++i) {
+      total += polynomials_.degree(i);
     }
     return total / polynomials_.size();
   }
@@ -144,7 +144,8 @@ void ContinuousTrajectory<Frame>::Prepend(ContinuousTrajectory&& prefix) {
     is_unstable_ = prefix.is_unstable_;
     degree_ = prefix.degree_;
     degree_age_ = prefix.degree_age_;
-    polynomials_ = std::move(prefix.polynomials_);
+    polynomial_t_maxes_ = std::move(prefix.polynomial_t_maxes_);
+    polynomials_.Prepend(std::move(prefix.polynomials_));
     last_accessed_polynomial_ = prefix.last_accessed_polynomial_;
     first_time_ = prefix.first_time_;
     last_points_ = prefix.last_points_;
@@ -154,12 +155,13 @@ void ContinuousTrajectory<Frame>::Prepend(ContinuousTrajectory&& prefix) {
     // on the other may depend on characteristics of the hardware and/or math
     // library, so we cannot check that the trajectories are "continuous" at the
     // junction.
-    CHECK_EQ(*first_time_, prefix.polynomials_.back().t_max);
-    // This operation is in O(prefix.size()).
-    std::move(polynomials_.begin(),
-              polynomials_.end(),
-              std::back_inserter(prefix.polynomials_));
-    polynomials_.swap(prefix.polynomials_);
+    CHECK_EQ(*first_time_, prefix.polynomial_t_maxes_.back());
+    // This operation is in O(size()).
+    prefix.polynomial_t_maxes_.insert(prefix.polynomial_t_maxes_.end(),
+                                      polynomial_t_maxes_.begin(),
+                                      polynomial_t_maxes_.end());
+    polynomial_t_maxes_.swap(prefix.polynomial_t_maxes_);
+    polynomials_.Prepend(std::move(prefix.polynomials_));
     first_time_ = prefix.first_time_;
     // Note that any |last_points_| in |prefix| are irrelevant because they
     // correspond to a time interval covered by the first polynomial of this
@@ -209,14 +211,11 @@ int ContinuousTrajectory<Frame>::PiecewisePoissonSeriesDegree(
   absl::ReaderMutexLock l(&lock_);
   CHECK_LE(t_min_locked(), t_min);
   CHECK_GE(t_max_locked(), t_max);
-  auto const it_min = FindPolynomialForInstantLocked(t_min);
-  auto const it_max = FindPolynomialForInstantLocked(t_max);
+  std::int64_t const i_min = FindPolynomialForInstantLocked(t_min);
+  std::int64_t const i_max = FindPolynomialForInstantLocked(t_max);
   int degree = min_degree;
-  for (auto it = it_min;; ++it) {
-    degree = std::max(degree, it->polynomial->degree());
-    if (it == it_max) {
-      break;
-    }
+  for (std::int64_t i = i_min; i <= i_max; ++i) {
+    degree = std::max(degree, polynomials_.degree(i));
   }
   return degree;
 }
@@ -302,15 +301,16 @@ ContinuousTrajectory<Frame>::ToPiecewisePoissonSeries(
   std::unique_ptr<PiecewisePoisson> result;
 
   absl::ReaderMutexLock l(&lock_);
-  auto const it_min = FindPolynomialForInstantLocked(t_min);
-  auto const it_max = FindPolynomialForInstantLocked(t_max);
+  std::int64_t const i_min = FindPolynomialForInstantLocked(t_min);
+  std::int64_t const i_max = FindPolynomialForInstantLocked(t_max);
   Instant current_t_min = t_min;
-  for (auto it = it_min;; ++it) {
-    Instant const current_t_max = std::min(t_max, it->t_max);
+  for (std::int64_t i = i_min;; ++i) {
+    Instant const current_t_max = std::min(t_max, polynomial_t_maxes_[i]);
     Interval<Instant> interval;
     interval.Include(current_t_min);
     interval.Include(current_t_max);
-    auto const polynomial_cast_to_degree = cast_to_degree(it->polynomial.get());
+    auto const polynomial_cast_to_degree =
+        cast_to_degree(polynomials_.Get(i).get());
     if (result == nullptr) {
       result = std::make_unique<PiecewisePoisson>(
           interval, Poisson(polynomial_cast_to_degree, {{}}));
@@ -318,7 +318,7 @@ ContinuousTrajectory<Frame>::ToPiecewisePoissonSeries(
       result->Append(interval, Poisson(polynomial_cast_to_degree, {{}}));
     }
     current_t_min = current_t_max;
-    if (it == it_max) {
+    if (i == i_max) {
       break;
     }
   }
@@ -342,13 +342,12 @@ void ContinuousTrajectory<Frame>::WriteToMessage(
   // true since Fatou (#2149), but we maintain compatibility with older saves,
   // see #3039.  When such an old save is rewritten, we end up with polynomials
   // before the oldest checkpoint.
-  for (auto const& pair : polynomials_) {
-    Instant const& t_max = pair.t_max;
-    auto const& polynomial = pair.polynomial;
+  for (std::int64_t i = 0; i < polynomials_.size(); ++i) {
+    Instant const& t_max = polynomial_t_maxes_[i];
     if (t_max <= checkpointer_->oldest_checkpoint()) {
       auto* const pair = message->add_instant_polynomial_pair();
       t_max.WriteToMessage(pair->mutable_t_max());
-      polynomial->WriteToMessage(pair->mutable_polynomial());
+      polynomials_.Get(i)->WriteToMessage(pair->mutable_polynomial());
     } else {
       break;
     }
@@ -402,9 +401,9 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
         v.push_back(series.EvaluateDerivative(t));
       }
       Displacement<Frame> error_estimate;  // Should we do something with this?
-      continuous_trajectory->polynomials_.emplace_back(
-          series.t_max(),
-          continuous_trajectory->NewhallApproximationInMonomialBasis(
+      continuous_trajectory->polynomial_t_maxes_.push_back(series.t_max());
+      continuous_trajectory->polynomials_.Append(
+          *continuous_trajectory->NewhallApproximationInMonomialBasis(
               series.degree(),
               q, v,
               series.t_min(), series.t_max(),
@@ -424,14 +423,16 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
             mutable_coefficient(0)->mutable_point();
         *coefficient0_point->mutable_multivector() = coefficient0_multivector;
 
-        continuous_trajectory->polynomials_.emplace_back(
-            Instant::ReadFromMessage(pair.t_max()),
-            Polynomial<Position<Frame>, Instant>::template ReadFromMessage<
+        continuous_trajectory->polynomial_t_maxes_.push_back(
+            Instant::ReadFromMessage(pair.t_max()));
+        continuous_trajectory->polynomials_.Append(
+            *Polynomial<Position<Frame>, Instant>::template ReadFromMessage<
                 EstrinEvaluator>(polynomial));
       } else {
-        continuous_trajectory->polynomials_.emplace_back(
-            Instant::ReadFromMessage(pair.t_max()),
-            Polynomial<Position<Frame>, Instant>::template ReadFromMessage<
+        continuous_trajectory->polynomial_t_maxes_.push_back(
+            Instant::ReadFromMessage(pair.t_max()));
+        continuous_trajectory->polynomials_.Append(
+            *Polynomial<Position<Frame>, Instant>::template ReadFromMessage<
                 EstrinEvaluator>(pair.polynomial()));
       }
     }
@@ -549,7 +550,8 @@ ContinuousTrajectory<Frame>::MakeCheckpointerReader() {
 
       // Restore the other members to their state at the time of the checkpoint.
       if (last_points_.empty()) {
-        polynomials_.clear();
+        polynomial_t_maxes_.clear();
+        polynomials_.Truncate(0);
         first_time_ = std::nullopt;
       } else {
         // Locate the polynomial that ends at the first last_point_.  Note that
@@ -558,15 +560,11 @@ ContinuousTrajectory<Frame>::MakeCheckpointerReader() {
         Instant const& oldest_time = last_points_.front().first;
         // If oldest_time is the t_max of some polynomial, then the returned
         // iterator points to the next polynomial.
-        auto const it =
-            std::upper_bound(polynomials_.begin(),
-                             polynomials_.end(),
-                             oldest_time,
-                             [](Instant const& left,
-                                InstantPolynomialPair const& right) {
-                               return left < right.t_max;
-                             });
-        polynomials_.erase(it, polynomials_.end());
+        auto const it = std::upper_bound(polynomial_t_maxes_.begin(),
+                                         polynomial_t_maxes_.end(),
+                                         oldest_time);
+        polynomials_.Truncate(it - polynomial_t_maxes_.begin());
+        polynomial_t_maxes_.erase(it, polynomial_t_maxes_.end());
         if (polynomials_.empty()) {
           first_time_ = oldest_time;
         }
@@ -593,7 +591,7 @@ Instant ContinuousTrajectory<Frame>::t_max_locked() const {
   if (polynomials_.empty()) {
     return InfinitePast;
   }
-  return polynomials_.crbegin()->t_max;
+  return polynomial_t_maxes_.back();
 }
 
 template<typename Frame>
@@ -601,10 +599,9 @@ Position<Frame> ContinuousTrajectory<Frame>::EvaluatePositionLocked(
     Instant const& time) const {
   CHECK_LE(t_min_locked(), time);
   CHECK_GE(t_max_locked(), time);
-  auto const it = FindPolynomialForInstantLocked(time);
-  CHECK(it != polynomials_.end());
-  auto const& polynomial = *it->polynomial;
-  return polynomial(time);
+  std::int64_t const i = FindPolynomialForInstantLocked(time);
+  CHECK_LT(i, polynomials_.size());
+  return polynomials_.Evaluate(i, time);
 }
 
 template<typename Frame>
@@ -612,10 +609,9 @@ Velocity<Frame> ContinuousTrajectory<Frame>::EvaluateVelocityLocked(
     Instant const& time) const {
   CHECK_LE(t_min_locked(), time);
   CHECK_GE(t_max_locked(), time);
-  auto const it = FindPolynomialForInstantLocked(time);
-  CHECK(it != polynomials_.end());
-  auto const& polynomial = *it->polynomial;
-  return polynomial.EvaluateDerivative(time);
+  std::int64_t const i = FindPolynomialForInstantLocked(time);
+  CHECK_LT(i, polynomials_.size());
+  return polynomials_.EvaluateDerivative(i, time);
 }
 
 template<typename Frame>
@@ -624,11 +620,43 @@ ContinuousTrajectory<Frame>::EvaluateDegreesOfFreedomLocked(
     Instant const& time) const {
   CHECK_LE(t_min_locked(), time);
   CHECK_GE(t_max_locked(), time);
-  auto const it = FindPolynomialForInstantLocked(time);
-  CHECK(it != polynomials_.end());
-  auto const& polynomial = *it->polynomial;
-  return DegreesOfFreedom<Frame>(polynomial(time),
-                                 polynomial.EvaluateDerivative(time));
+  std::int64_t const i = FindPolynomialForInstantLocked(time);
+  CHECK_LT(i, polynomials_.size());
+  return DegreesOfFreedom<Frame>(polynomials_.Evaluate(i, time),
+                                 polynomials_.EvaluateDerivative(i, time));
+}
+
+template<typename Frame>
+std::int64_t ContinuousTrajectory<Frame>::PolynomialIndexLocked(
+    Instant const& time) const {
+  CHECK_LE(t_min_locked(), time);
+  CHECK_GE(t_max_locked(), time);
+  std::int64_t const i = FindPolynomialForInstantLocked(time);
+  CHECK_LT(i, polynomials_.size());
+  return i;
+}
+
+template<typename Frame>
+Position<Frame> ContinuousTrajectory<Frame>::EvaluatePositionLocked(
+    Instant const& time,
+    std::int64_t const index) const {
+  if (IsPolynomialForInstantLocked(index, time)) {
+    return polynomials_.Evaluate(index, time);
+  }
+  return EvaluatePositionLocked(time);
+}
+
+template<typename Frame>
+DegreesOfFreedom<Frame>
+ContinuousTrajectory<Frame>::EvaluateDegreesOfFreedomLocked(
+    Instant const& time,
+    std::int64_t const index) const {
+  if (IsPolynomialForInstantLocked(index, time)) {
+    return DegreesOfFreedom<Frame>(
+        polynomials_.Evaluate(index, time),
+        polynomials_.EvaluateDerivative(index, time));
+  }
+  return EvaluateDegreesOfFreedomLocked(time);
 }
 
 template<typename Frame>
@@ -639,14 +667,6 @@ ContinuousTrajectory<Frame>::ContinuousTrajectory()
           /*reader=*/nullptr,
           /*writer=*/nullptr)) {}
 
-template<typename Frame>
-ContinuousTrajectory<Frame>::InstantPolynomialPair::InstantPolynomialPair(
-    Instant const t_max,
-    not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
-        polynomial)
-    : t_max(t_max),
-      polynomial(std::move(polynomial)) {}
-
 template<typename Frame>
 not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
 ContinuousTrajectory<Frame>::NewhallApproximationInMonomialBasis(
@@ -684,12 +704,11 @@ absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
 
   // Compute the approximation with the current degree.
   Displacement<Frame> displacement_error_estimate;
-  polynomials_.emplace_back(time,
-                            NewhallApproximationInMonomialBasis(
-                                degree_,
-                                q, v,
-                                last_points_.cbegin()->first, time,
-                                displacement_error_estimate));
+  not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>> polynomial =
+      NewhallApproximationInMonomialBasis(degree_,
+                                          q, v,
+                                          last_points_.cbegin()->first, time,
+                                          displacement_error_estimate);
 
   // Estimate the error.  For initializing |previous_error_estimate|, any value
   // greater than |error_estimate| will do.
@@ -721,11 +740,11 @@ absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
     ++degree_;
     VLOG(1) << "Increasing degree for " << this << " to " <<degree_
             << " because error estimate was " << error_estimate;
-    polynomials_.back().polynomial = NewhallApproximationInMonomialBasis(
-                                         degree_,
-                                         q, v,
-                                         last_points_.cbegin()->first, time,
-                                         displacement_error_estimate);
+    polynomial = NewhallApproximationInMonomialBasis(
+                     degree_,
+                     q, v,
+                     last_points_.cbegin()->first, time,
+                     displacement_error_estimate);
     previous_error_estimate = error_estimate;
     error_estimate = displacement_error_estimate.Norm();
   }
@@ -748,6 +767,9 @@ absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
             << " with error estimate " << error_estimate;
   }
 
+  polynomial_t_maxes_.push_back(time);
+  polynomials_.Append(*polynomial);
+
   ++degree_age_;
 
   // Check that the tolerance did not explode.
@@ -767,30 +789,30 @@ absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
 }
 
 template<typename Frame>
-typename ContinuousTrajectory<Frame>::InstantPolynomialPairs::const_iterator
-ContinuousTrajectory<Frame>::FindPolynomialForInstantLocked(
+std::int64_t ContinuousTrajectory<Frame>::FindPolynomialForInstantLocked(
     Instant const& time) const {
   // This returns the first polynomial |p| such that |time <= p.t_max|.
-  {
-    auto const begin = polynomials_.begin();
-    auto const it = begin + last_accessed_polynomial_;
-    if (it != polynomials_.end() && time <= it->t_max &&
-        (it == begin || std::prev(it)->t_max < time)) {
-      return it;
-    }
-  }
-  {
-    auto const it =
-        std::lower_bound(polynomials_.begin(),
-                         polynomials_.end(),
-                         time,
-                         [](InstantPolynomialPair const& left,
-                            Instant const& right) {
-                           return left.t_max < right;
-                         });
-    last_accessed_polynomial_ = it - polynomials_.begin();
-    return it;
+  if (IsPolynomialForInstantLocked(last_accessed_polynomial_, time)) {
+    return last_accessed_polynomial_;
   }
+  auto const it = std::lower_bound(polynomial_t_maxes_.begin(),
+                                   polynomial_t_maxes_.end(),
+                                   time);
+  last_accessed_polynomial_ = it - polynomial_t_maxes_.begin();
+  return last_accessed_polynomial_;
+}
+
+template<typename Frame>
+bool ContinuousTrajectory<Frame>::IsPolynomialForInstantLocked(
+    std::int64_t const index,
+    Instant const& time) const {
+  // Note that the polynomial at |index| starts at |*first_time_| if |index| is
+  // 0, which ensures that |time| is in [t_min, t_max] if this function returns
+  // true.
+  return index < polynomial_t_maxes_.size() &&
+         time <= polynomial_t_maxes_[index] &&
+         (index == 0 ? *first_time_ <= time
+                     : polynomial_t_maxes_[index - 1] < time);
 }
 
 }  // namespace internal
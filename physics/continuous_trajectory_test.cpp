@@ -101,7 +101,7 @@ TestableContinuousTrajectory<Frame>::NewhallApproximationInMonomialBasis(
     Instant const& t_max,
     Displacement<Frame>& error_estimate) const {
   using P = PolynomialInMonomialBasis<
-                Position<Frame>, Instant, /*degree=*/1, HornerEvaluator>;
+                Position<Frame>, Instant, /*degree=*/1, EstrinEvaluator>;
   typename P::Coefficients const coefficients = {Position<Frame>(),
                                                  Velocity<Frame>()};
   not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
@@ -10,6 +10,7 @@
 #include "base/macros.hpp"
 #include "base/not_null.hpp"
 #include "base/tags.hpp"
+#include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
 #include "physics/degrees_of_freedom.hpp"
@@ -19,6 +20,7 @@
 #include "physics/discrete_trajectory_segment_range.hpp"
 #include "physics/discrete_trajectory_types.hpp"
 #include "physics/trajectory.hpp"
+#include "quantities/named_quantities.hpp"
 #include "serialization/physics.pb.h"
 
 namespace principia {
@@ -34,6 +36,7 @@ namespace internal {
 using namespace principia::base::_not_null;
 using namespace principia::base::_tags;
 using namespace principia::base::_traits;
+using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_space;
 using namespace principia::physics::_degrees_of_freedom;
@@ -42,6 +45,7 @@ using namespace principia::physics::_discrete_trajectory_segment_iterator;
 using namespace principia::physics::_discrete_trajectory_segment_range;
 using namespace principia::physics::_discrete_trajectory_types;
 using namespace principia::physics::_trajectory;
+using namespace principia::quantities::_named_quantities;
 
 template<typename Frame>
 class DiscreteTrajectory : public Trajectory<Frame> {
@@ -109,6 +113,14 @@ class DiscreteTrajectory : public Trajectory<Frame> {
   // Return an error if downsampling was aborted.
   absl::Status Append(Instant const& t,
                       DegreesOfFreedom<Frame> const& degrees_of_freedom);
+  // Same as above, but also records the |acceleration| at |t|.  Between two
+  // consecutive points of a segment that both have an acceleration, the
+  // trajectory is evaluated using a polynomial of degree 5 instead of 3, which
+  // makes it possible to keep fewer points for the same accuracy.  Typically
+  // the accelerations come from the integrator and are free.
+  absl::Status Append(Instant const& t,
+                      DegreesOfFreedom<Frame> const& degrees_of_freedom,
+                      Vector<Acceleration, Frame> const& acceleration);
 
   // Merges |trajectory| (the source) into this object (the target).  The
   // operation processes pairs of segments taken from each trajectory and
@@ -178,6 +190,9 @@ class DiscreteTrajectory : public Trajectory<Frame> {
   typename SegmentByLeftEndpoint::const_iterator
   FindSegment(Instant const& t) const;
 
+  // Returns the segment to which a point at time |t| must be appended.
+  typename Segments::iterator FindSegmentForAppend(Instant const& t);
+
   // Determines if this objects is in a consistent state, and returns an error
   // status with a relevant message if it isn't.
   absl::Status ConsistencyStatus() const;
@@ -368,24 +368,19 @@ template<typename Frame>
 absl::Status DiscreteTrajectory<Frame>::Append(
     Instant const& t,
     DegreesOfFreedom<Frame> const& degrees_of_freedom) {
-  typename Segments::iterator sit;
-  if (segment_by_left_endpoint_.empty()) {
-    // If this is the first point appended to this trajectory, insert it in the
-    // time-to-segment map.
-    sit = --segments_->end();
-    segment_by_left_endpoint_.insert_or_assign(
-        segment_by_left_endpoint_.end(), t, sit);
-  } else {
-    auto const leit = FindSegment(t);
-    CHECK(leit != segment_by_left_endpoint_.end())
-        << "Append at " << t << " before the beginning of the trajectory at "
-        << front().time;
-    // The segment is expected to always have a point copied from its
-    // predecessor.
-    sit = leit->second;
-    CHECK(!sit->empty()) << "Empty segment at " << t;
-  }
-  RETURN_IF_ERROR(sit->Append(t, degrees_of_freedom));
+  RETURN_IF_ERROR(FindSegmentForAppend(t)->Append(t, degrees_of_freedom));
+
+  DCHECK_OK(ConsistencyStatus());
+  return absl::OkStatus();
+}
+
+template<typename Frame>
+absl::Status DiscreteTrajectory<Frame>::Append(
+    Instant const& t,
+    DegreesOfFreedom<Frame> const& degrees_of_freedom,
+    Vector<Acceleration, Frame> const& acceleration) {
+  RETURN_IF_ERROR(
+      FindSegmentForAppend(t)->Append(t, degrees_of_freedom, acceleration));
 
   DCHECK_OK(ConsistencyStatus());
   return absl::OkStatus();
@@ -708,6 +703,29 @@ DiscreteTrajectory<Frame>::FindSegment(
   }
 }
 
+template<typename Frame>
+typename DiscreteTrajectory<Frame>::Segments::iterator
+DiscreteTrajectory<Frame>::FindSegmentForAppend(Instant const& t) {
+  typename Segments::iterator sit;
+  if (segment_by_left_endpoint_.empty()) {
+    // If this is the first point appended to this trajectory, insert it in the
+    // time-to-segment map.
+    sit = --segments_->end();
+    segment_by_left_endpoint_.insert_or_assign(
+        segment_by_left_endpoint_.end(), t, sit);
+  } else {
+    auto const leit = FindSegment(t);
+    CHECK(leit != segment_by_left_endpoint_.end())
+        << "Append at " << t << " before the beginning of the trajectory at "
+        << front().time;
+    // The segment is expected to always have a point copied from its
+    // predecessor.
+    sit = leit->second;
+    CHECK(!sit->empty()) << "Empty segment at " << t;
+  }
+  return sit;
+}
+
 template<typename Frame>
 absl::Status DiscreteTrajectory<Frame>::ConsistencyStatus() const {
   if (segments_->size() < segment_by_left_endpoint_.size()) {
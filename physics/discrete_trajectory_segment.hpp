@@ -8,14 +8,17 @@
 #include "absl/container/btree_map.h"
 #include "absl/status/status.h"
 #include "base/not_null.hpp"
+#include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
 #include "numerics/hermite3.hpp"
+#include "numerics/hermite5.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory_iterator.hpp"
 #include "physics/discrete_trajectory_segment_iterator.hpp"
 #include "physics/discrete_trajectory_types.hpp"
 #include "physics/trajectory.hpp"
+#include "quantities/named_quantities.hpp"
 #include "serialization/physics.pb.h"
 
 namespace principia {
@@ -41,15 +44,18 @@ namespace internal {
 
 using namespace principia::base::_not_null;
 using namespace principia::base::_traits;
+using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_space;
 using namespace principia::numerics::_hermite3;
+using namespace principia::numerics::_hermite5;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_discrete_trajectory_iterator;
 using namespace principia::physics::_discrete_trajectory_segment_iterator;
 using namespace principia::physics::_discrete_trajectory_types;
 using namespace principia::physics::_trajectory;
+using namespace principia::quantities::_named_quantities;
 
 template<typename Frame>
 class DiscreteTrajectorySegment : public Trajectory<Frame> {
@@ -171,8 +177,11 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
   void ForgetBefore(Instant const& t);
   void ForgetBefore(typename Timeline::const_iterator end);
 
+  // The |acceleration|, if any, is recorded in |accelerations_|.
   absl::Status Append(Instant const& t,
-                      DegreesOfFreedom<Frame> const& degrees_of_freedom);
+                      DegreesOfFreedom<Frame> const& degrees_of_freedom,
+                      std::optional<Vector<Acceleration, Frame>> const&
+                          acceleration = std::nullopt);
 
   // Merges the points from the given |segment| into this object.  The two
   // segments must have nonoverlapping times.  The downsampling state of the
@@ -197,6 +206,12 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
   Hermite3<Instant, Position<Frame>> GetInterpolation(
       typename Timeline::const_iterator upper) const;
 
+  // Returns the Hermite interpolation of degree 5 for the same segment as
+  // |GetInterpolation|, or nullopt if the accelerations are not known at both
+  // of its ends.  Doesn't search |accelerations_| if it is empty.
+  std::optional<Hermite5<Instant, Position<Frame>>> GetDenseInterpolation(
+      typename Timeline::const_iterator upper) const;
+
   typename Timeline::const_iterator timeline_begin() const;
   typename Timeline::const_iterator timeline_end() const;
   bool timeline_empty() const;
@@ -226,6 +241,14 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
   DiscreteTrajectorySegmentIterator<Frame> self_;
   Timeline timeline_;
 
+  // The accelerations at some of the points of |timeline_|, as given to
+  // |Append|.  Between two consecutive points that both have an acceleration
+  // the segment is interpolated by a polynomial of degree 5 instead of 3.  The
+  // accelerations are not serialized.  They are kept out of |timeline_| so
+  // that the segments that never have accelerations (histories, deserialized
+  // trajectories) don't pay for them.
+  absl::btree_map<Instant, Vector<Acceleration, Frame>> accelerations_;
+
   template<typename F>
   friend class _discrete_trajectory::internal::DiscreteTrajectory;
   template<typename F>
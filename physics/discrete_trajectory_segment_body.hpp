@@ -97,6 +97,7 @@ void DiscreteTrajectorySegment<Frame>::clear() {
   number_of_dense_points_ = 0;
   was_downsampled_ = false;
   timeline_.clear();
+  accelerations_.clear();
 }
 
 template<typename Frame>
@@ -139,6 +140,10 @@ Position<Frame> DiscreteTrajectorySegment<Frame>::EvaluatePosition(
   }
   CHECK_LT(t_min(), t);
   CHECK_GT(t_max(), t);
+  if (auto const interpolation = GetDenseInterpolation(it);
+      interpolation.has_value()) {
+    return interpolation->Evaluate(t);
+  }
   return GetInterpolation(it).Evaluate(t);
 }
 
@@ -151,6 +156,10 @@ Velocity<Frame> DiscreteTrajectorySegment<Frame>::EvaluateVelocity(
   }
   CHECK_LT(t_min(), t);
   CHECK_GT(t_max(), t);
+  if (auto const interpolation = GetDenseInterpolation(it);
+      interpolation.has_value()) {
+    return interpolation->EvaluateDerivative(t);
+  }
   return GetInterpolation(it).EvaluateDerivative(t);
 }
 
@@ -164,6 +173,10 @@ DiscreteTrajectorySegment<Frame>::EvaluateDegreesOfFreedom(
   }
   CHECK_LT(t_min(), t);
   CHECK_GT(t_max(), t);
+  if (auto const interpolation = GetDenseInterpolation(it);
+      interpolation.has_value()) {
+    return {interpolation->Evaluate(t), interpolation->EvaluateDerivative(t)};
+  }
   auto const interpolation = GetInterpolation(it);
   return {interpolation.Evaluate(t), interpolation.EvaluateDerivative(t)};
 }
@@ -388,6 +401,10 @@ void DiscreteTrajectorySegment<Frame>::ForgetAfter(
       std::max<std::int64_t>(
           0, number_of_dense_points_ - number_of_points_to_remove);
 
+  if (begin != timeline_.cend()) {
+    accelerations_.erase(accelerations_.lower_bound(begin->time),
+                         accelerations_.cend());
+  }
   timeline_.erase(begin, timeline_.cend());
 }
 
@@ -406,13 +423,18 @@ void DiscreteTrajectorySegment<Frame>::ForgetBefore(
       number_of_points_to_remove + number_of_dense_points_ - timeline_.size());
   number_of_dense_points_ -= number_of_dense_points_to_remove;
 
+  accelerations_.erase(accelerations_.cbegin(),
+                       end == timeline_.cend()
+                           ? accelerations_.cend()
+                           : accelerations_.lower_bound(end->time));
   timeline_.erase(timeline_.cbegin(), end);
 }
 
 template<typename Frame>
 absl::Status DiscreteTrajectorySegment<Frame>::Append(
     Instant const& t,
-    DegreesOfFreedom<Frame> const& degrees_of_freedom) {
+    DegreesOfFreedom<Frame> const& degrees_of_freedom,
+    std::optional<Vector<Acceleration, Frame>> const& acceleration) {
   if (!timeline_.empty() && timeline_.cbegin()->time == t) {
     LOG(WARNING) << "Append at existing time " << t << ", time range = ["
                  << timeline_.cbegin()->time << ", "
@@ -425,6 +447,11 @@ absl::Status DiscreteTrajectorySegment<Frame>::Append(
   CHECK(++it == timeline_.end())
       << "Append out of order at " << t << ", last time is "
       << timeline_.crbegin()->time;
+  // Record the acceleration before downsampling, which keeps |accelerations_|
+  // in sync with |timeline_|.
+  if (acceleration.has_value()) {
+    accelerations_.emplace_hint(accelerations_.cend(), t, *acceleration);
+  }
 
   if (downsampling_parameters_.has_value()) {
     return DownsampleIfNeeded();
@@ -448,6 +475,7 @@ void DiscreteTrajectorySegment<Frame>::Merge(
   } else if (timeline_.empty()) {
     downsampling_parameters_ = segment.downsampling_parameters_;
     timeline_ = std::move(segment.timeline_);
+    accelerations_ = std::move(segment.accelerations_);
     number_of_dense_points_ = segment.number_of_dense_points_;
   } else if (auto const [this_crbegin, segment_cbegin] =
                  std::pair{std::prev(timeline_.cend()),
@@ -467,6 +495,7 @@ void DiscreteTrajectorySegment<Frame>::Merge(
 #endif
     downsampling_parameters_ = segment.downsampling_parameters_;
     timeline_.merge(segment.timeline_);
+    accelerations_.merge(segment.accelerations_);
     number_of_dense_points_ = segment.number_of_dense_points_;
   } else if (auto const [segment_crbegin, this_cbegin] =
                  std::pair{std::prev(segment.timeline_.cend()),
@@ -485,6 +514,7 @@ void DiscreteTrajectorySegment<Frame>::Merge(
         << this_cbegin->degrees_of_freedom << " don't match";
 #endif
     timeline_.merge(segment.timeline_);
+    accelerations_.merge(segment.accelerations_);
   } else {
     LOG(FATAL) << "Overlapping merge: [" << segment.timeline_.cbegin()->time
                << ", " << std::prev(segment.timeline_.cend())->time
@@ -563,6 +593,10 @@ absl::Status DiscreteTrajectorySegment<Frame>::DownsampleIfNeeded() {
     for (Instant const& right : right_endpoints_times) {
       ++left_it;
       auto const right_it = timeline_.find(right);
+      if (left_it != right_it) {
+        accelerations_.erase(accelerations_.lower_bound(left_it->time),
+                             accelerations_.lower_bound(right));
+      }
       left_it = timeline_.erase(left_it, right_it);
     }
     number_of_dense_points_ = std::distance(left_it, timeline_.cend());
@@ -587,6 +621,37 @@ DiscreteTrajectorySegment<Frame>::GetInterpolation(
        upper_degrees_of_freedom.velocity()}};
 }
 
+template<typename Frame>
+std::optional<Hermite5<Instant, Position<Frame>>>
+DiscreteTrajectorySegment<Frame>::GetDenseInterpolation(
+    typename Timeline::const_iterator const upper) const {
+  if (accelerations_.empty()) {
+    return std::nullopt;
+  }
+  CHECK(upper != timeline_.cbegin());
+  auto const lower = std::prev(upper);
+  auto const& [lower_time, lower_degrees_of_freedom] = *lower;
+  auto const& [upper_time, upper_degrees_of_freedom] = *upper;
+  // A single search: the acceleration at |lower_time|, if any, immediately
+  // precedes the one at |upper_time| since there is no point in between.
+  auto const upper_acceleration = accelerations_.find(upper_time);
+  if (upper_acceleration == accelerations_.cend() ||
+      upper_acceleration == accelerations_.cbegin()) {
+    return std::nullopt;
+  }
+  auto const lower_acceleration = std::prev(upper_acceleration);
+  if (lower_acceleration->first != lower_time) {
+    return std::nullopt;
+  }
+  return Hermite5<Instant, Position<Frame>>{
+      {lower_time, upper_time},
+      {lower_degrees_of_freedom.position(),
+       upper_degrees_of_freedom.position()},
+      {lower_degrees_of_freedom.velocity(),
+       upper_degrees_of_freedom.velocity()},
+      {lower_acceleration->second, upper_acceleration->second}};
+}
+
 template<typename Frame>
 typename DiscreteTrajectorySegment<Frame>::Timeline::const_iterator
 DiscreteTrajectorySegment<Frame>::timeline_begin() const {
@@ -1,11 +1,13 @@
 #include "physics/discrete_trajectory_segment.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <vector>
 
 #include "base/not_null.hpp"
 #include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
 #include "gmock/gmock.h"
@@ -25,10 +27,12 @@ namespace principia {
 namespace physics {
 
 using ::testing::Eq;
+using ::testing::Gt;
 using ::testing::Le;
 using ::testing::Lt;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
+using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_space;
 using namespace principia::physics::_degrees_of_freedom;
@@ -79,6 +83,13 @@ class DiscreteTrajectorySegmentTest : public ::testing::Test {
     segment_->ForgetBefore(t);
   }
 
+  void Append(Instant const& t,
+              DegreesOfFreedom<World> const& degrees_of_freedom,
+              Vector<Acceleration, World> const& acceleration,
+              DiscreteTrajectorySegment<World>& segment) {
+    EXPECT_OK(segment.Append(t, degrees_of_freedom, acceleration));
+  }
+
   void ForgetBefore(Instant const& t,
                     DiscreteTrajectorySegment<World>& segment) {
     segment.ForgetBefore(t);
@@ -233,6 +244,65 @@ TEST_F(DiscreteTrajectorySegmentTest, Evaluate) {
               IsNear(10.4_(1) * Nano(Metre / Second)));
 }
 
+TEST_F(DiscreteTrajectorySegmentTest, EvaluateWithAccelerations) {
+  auto const segments = MakeSegments(1);
+  auto& circle = *segments->begin();
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Time const Δt = 10 * Milli(Second);
+  Instant const t1 = t0_;
+  Instant const t2 = t0_ + 10 * Second;
+  for (auto const& [time, degrees_of_freedom] :
+       NewCircularTrajectoryTimeline<World>(ω, r, Δt, t1, t2)) {
+    Append(time,
+           degrees_of_freedom,
+           -(degrees_of_freedom.position() - World::origin) * ω * ω /
+               (Radian * Radian),
+           circle);
+  }
+
+  // Compare with the |Evaluate| test above: the interpolation now has degree
+  // 5.
+  EXPECT_THAT(circle.size(), Eq(1001));
+  std::vector<Length> position_errors;
+  std::vector<Speed> velocity_errors;
+  for (Instant t = circle.t_min();
+       t <= circle.t_max();
+       t += 1 * Milli(Second)) {
+    position_errors.push_back(
+        Abs((circle.EvaluatePosition(t) - World::origin).Norm() - r));
+    velocity_errors.push_back(
+        Abs(circle.EvaluateVelocity(t).Norm() - r * ω / Radian));
+  }
+  EXPECT_THAT(*std::max_element(position_errors.begin(), position_errors.end()),
+              IsNear(3.2e-14_(1) * Metre));
+  EXPECT_THAT(*std::max_element(velocity_errors.begin(), velocity_errors.end()),
+              IsNear(7.1e-13_(1) * Metre / Second));
+
+  // After forgetting the end of the segment and appending points without
+  // accelerations, the interpolation falls back to degree 3 for the new
+  // points.
+  Instant const restart_time = circle.lower_bound(t0_ + 5 * Second)->time;
+  ForgetAfter(restart_time, circle);
+  AppendTrajectoryTimeline(
+      NewCircularTrajectoryTimeline<World>(ω, r, Δt, restart_time, t2),
+      /*to=*/circle);
+  EXPECT_THAT(circle.size(), Eq(1001));
+  EXPECT_EQ(std::distance(circle.begin(), circle.find(restart_time)),
+            circle.accelerations_.size());
+  EXPECT_TRUE(circle.accelerations_.contains(
+      std::prev(circle.find(restart_time))->time));
+  EXPECT_FALSE(circle.accelerations_.contains(restart_time));
+  EXPECT_THAT(
+      Abs((circle.EvaluatePosition(restart_time - 1.5 * Δt) - World::origin)
+              .Norm() - r),
+      Lt(1 * Nano(Metre)));
+  EXPECT_THAT(
+      Abs((circle.EvaluatePosition(restart_time + 0.5 * Δt) - World::origin)
+              .Norm() - r),
+      Gt(1 * Nano(Metre)));
+}
+
 TEST_F(DiscreteTrajectorySegmentTest, DownsamplingCircle) {
   auto const circle_segments = MakeSegments(1);
   auto const downsampled_circle_segments = MakeSegments(1);
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "absl/status/status.h"
@@ -23,9 +26,11 @@
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/geopotential.hpp"
+#include "physics/geopotential_grid.hpp"
 #include "physics/integration_parameters.hpp"
 #include "physics/massive_body.hpp"
 #include "physics/oblate_body.hpp"
+#include "physics/point_mass_accelerations.hpp"
 #include "physics/protector.hpp"
 #include "physics/tensors.hpp"
 #include "serialization/ksp_plugin.pb.h"
@@ -51,8 +56,11 @@ using namespace principia::physics::_continuous_trajectory;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_geopotential;
+using namespace principia::physics::_geopotential_grid;
 using namespace principia::physics::_integration_parameters;
 using namespace principia::physics::_massive_body;
+using namespace principia::physics::_oblate_body;
+using namespace principia::physics::_point_mass_accelerations;
 using namespace principia::physics::_tensors;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
@@ -77,6 +85,8 @@ class Ephemeris {
   static IntrinsicAccelerations const NoIntrinsicAccelerations;
   static std::int64_t constexpr unlimited_max_ephemeris_steps =
       std::numeric_limits<std::int64_t>::max();
+  // The default value for |SetConcurrencyThreshold|.
+  static int constexpr default_concurrency_threshold = 64;
 
   // The equations describing the motion of the |bodies_|.
   using NewtonianMotionEquation =
@@ -94,8 +104,19 @@ class Ephemeris {
 
   class AccuracyParameters final {
    public:
+    // If |opening_angle| is positive, the accelerations between the spherical
+    // bodies are approximated using a |BarnesHutTree| with that opening angle;
+    // the accelerations involving oblate bodies are always computed exactly.
+    // If |use_geopotential_grids| is true, the accelerations due to the
+    // geopotential of each oblate body on massless bodies are interpolated in a
+    // |GeopotentialGrid| built for |geopotential_tolerance| in the shell where
+    // the harmonics of degree 3 and above are not damped.  This is expensive
+    // at construction but speeds up long predictions in low orbit around
+    // bodies with high-degree models.
     AccuracyParameters(Length const& fitting_tolerance,
-                       double geopotential_tolerance);
+                       double geopotential_tolerance,
+                       double opening_angle = 0,
+                       bool use_geopotential_grids = false);
 
     void WriteToMessage(
         not_null<serialization::Ephemeris::AccuracyParameters*> message) const;
@@ -105,6 +126,8 @@ class Ephemeris {
    private:
     Length fitting_tolerance_;
     double geopotential_tolerance_ = 0;
+    double opening_angle_ = 0;
+    bool use_geopotential_grids_ = false;
     friend class Ephemeris<Frame>;
   };
 
@@ -128,6 +151,34 @@ class Ephemeris {
   // Returns true if at least one of the trajectories is empty.
   virtual bool empty() const;
 
+  // Returns the positions (resp. degrees of freedom) of all the bodies at time
+  // |t|, in the order of |bodies()|.  |t| must be in [t_min(), t_max()].  This
+  // is cheaper than evaluating the trajectories one by one because the
+  // polynomial lookup is shared by all the trajectories, and because the
+  // positions at the most recently evaluated time are cached.
+  virtual std::vector<Position<Frame>> EvaluateAllPositions(
+      Instant const& t) const EXCLUDES(lock_);
+  virtual std::vector<DegreesOfFreedom<Frame>> EvaluateAllDegreesOfFreedom(
+      Instant const& t) const EXCLUDES(lock_);
+
+  // Statistics about the cache of body positions shared by
+  // |EvaluateAllPositions| and by the computation of the accelerations and
+  // potentials.  The counters are cumulative since construction.
+  struct BodyPositionsCacheStatistics {
+    std::int64_t hits = 0;
+    std::int64_t misses = 0;
+  };
+  BodyPositionsCacheStatistics body_positions_cache_statistics() const;
+
+  // When there are at least |threshold| spherical bodies, the accelerations
+  // between them are computed concurrently on a thread pool.  The pair
+  // interactions are split in a fixed number of blocks, each of which
+  // accumulates its own partial sums, and the partial sums are added in a fixed
+  // order.  Therefore, the results don't depend on the number of threads or on
+  // the scheduling, but they may differ in the last bits from those of the
+  // sequential computation.  May be called while integrations are in progress.
+  void SetConcurrencyThreshold(int threshold);
+
   // The maximum of the |t_min|s of the trajectories.
   virtual Instant t_min() const EXCLUDES(lock_);
   // The mimimum of the |t_max|s of the trajectories.
@@ -285,15 +336,21 @@ class Ephemeris {
   // Called on a stoppable thread to reconstruct the past state of the ephemeris
   // and its trajectories starting in such a way that |t_min()| is at or before
   // |desired_t_min|.  The member variable |oldest_reanimated_checkpoint_| tells
-  // the reanimator where to stop.
+  // the reanimator where to stop.  The segments between checkpoints are
+  // reconstructed in parallel.
   absl::Status Reanimate(Instant const desired_t_min) EXCLUDES(lock_);
 
   // Reconstructs the past state of the ephemeris between |t_initial| and
-  // |t_final| using the given checkpoint |message|.
+  // |t_final| using the given checkpoint |message|.  The result is stored in
+  // |trajectories|, which must be empty, and which the caller is responsible
+  // for prepending to the trajectories of this object.  May be called
+  // concurrently for distinct segments.
   absl::Status ReanimateOneCheckpoint(
       serialization::Ephemeris::Checkpoint const& message,
       Instant const& t_initial,
-      Instant const& t_final) EXCLUDES(lock_);
+      Instant const& t_final,
+      std::vector<not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>>&
+          trajectories) EXCLUDES(lock_);
 
   // Callbacks for the integrators.
   void AppendMassiveBodiesState(
@@ -318,6 +375,32 @@ class Ephemeris {
   virtual Instant t_min_locked() const REQUIRES_SHARED(lock_);
   virtual Instant t_max_locked() const REQUIRES_SHARED(lock_);
 
+  // One entry of |body_positions_cache_|, protected by a sequence lock: a
+  // writer makes |sequence| odd while it updates the entry, and a reader
+  // retries or gives up if |sequence| is odd or changes while it copies the
+  // entry.  The fields are atomic so that a torn read is not a data race.
+  struct BodyPositionsCacheEntry {
+    std::atomic<std::uint64_t> sequence = 0;
+    // The time of the positions, in seconds from |Instant()|, or NaN if the
+    // entry is empty.
+    std::atomic<double> t = std::numeric_limits<double>::quiet_NaN();
+    // The coordinates of the positions relative to |Frame::origin|, in
+    // metres, body by body.
+    std::vector<std::atomic<double>> coordinates;
+  };
+
+  // Sets |positions| to the positions of the |bodies_| at time |t|, in the
+  // same order.  The polynomial lookup is only done for the first trajectory,
+  // and its result is used as a hint for the others.  The positions are looked
+  // up in, and added to, |body_positions_cache_|.  This function is lock-free
+  // and may be called concurrently.
+  void EvaluateBodyPositionsLocked(
+      Instant const& t,
+      std::vector<Position<Frame>>& positions) const REQUIRES_SHARED(lock_);
+  // Same as above, but returns the degrees of freedom without caching.
+  std::vector<DegreesOfFreedom<Frame>> EvaluateBodyDegreesOfFreedomLocked(
+      Instant const& t) const REQUIRES_SHARED(lock_);
+
   // Computes the Jacobian of the acceleration field between one body, |body1|
   // (with index |b1| in the |positions| and |jacobians| arrays) and the bodies
   // |bodies2| (with indices [b2_begin, b2_end[ in the |bodies2|, |positions|
@@ -369,30 +452,83 @@ class Ephemeris {
       std::vector<Vector<Acceleration, Frame>>& accelerations,
       std::vector<Geopotential<Frame>> const& geopotentials);
 
+  // Computes the accelerations between all the spherical bodies in |bodies_|.
+  // This is equivalent to calling
+  // |ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies| for all the
+  // pairs of spherical bodies, but the computation is done on a
+  // structure-of-arrays representation and is vectorized.
+  void ComputeGravitationalAccelerationsBetweenSphericalBodies(
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
+  // Same as above, but the computation is split in blocks that are executed
+  // concurrently.  See |SetConcurrencyThreshold|.
+  void ComputeGravitationalAccelerationsBetweenSphericalBodiesConcurrently(
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
+  // Same as above, but the accelerations are approximated using a
+  // |BarnesHutTree| with the opening angle of the |accuracy_parameters_|.
+  void ComputeGravitationalAccelerationsBetweenSphericalBodiesApproximately(
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
   // Computes the accelerations due to one body, |body1| (with index |b1| in the
-  // |bodies_| and |trajectories_| arrays) on massless bodies at the given
-  // |positions|.  The template parameter specifies what we know about the
-  // massive body, and therefore what forces apply.  Returns an integer for
-  // efficiency.
+  // |bodies_| and |trajectories_| arrays, and located at |position1|) on
+  // massless bodies at the given |positions|.  The template parameter
+  // specifies what we know about the massive body, and therefore what forces
+  // apply.  Returns an integer for efficiency.
   template<bool body1_is_oblate>
   std::underlying_type_t<absl::StatusCode>
   ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
       Instant const& t,
       MassiveBody const& body1,
       std::size_t b1,
+      Position<Frame> const& position1,
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const
+      REQUIRES_SHARED(lock_);
+
+  // Adds to |accelerations| the accelerations due to the spherical harmonics of
+  // the oblate body |b1|, with gravitational parameter |μ1| and located at
+  // |position1|, on massless bodies at the given |positions|.  All the massless
+  // bodies are processed in one call to |GeneralSphericalHarmonicsAccelerations|
+  // so that the recurrences are vectorized across them.  The grid of |b1| is
+  // used if there is one.
+  void AccumulateSphericalHarmonicsAccelerationsOnMasslessBodies(
+      Instant const& t,
+      GravitationalParameter const& μ1,
+      std::size_t b1,
+      Position<Frame> const& position1,
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const
+      REQUIRES_SHARED(lock_);
+
+  // Computes the accelerations due to all the massive bodies on massless bodies
+  // at the given |positions|.  This is equivalent to calling
+  // |ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies| for all the
+  // massive bodies, but the central part of the force is computed on a
+  // structure-of-arrays representation and is vectorized, as is the collision
+  // check.  The massive bodies are at the given |body_positions|.  Returns an
+  // integer for efficiency.
+  std::underlying_type_t<absl::StatusCode>
+  ComputeGravitationalAccelerationsOnMasslessBodiesVectorized(
+      Instant const& t,
+      std::vector<Position<Frame>> const& body_positions,
       std::vector<Position<Frame>> const& positions,
       std::vector<Vector<Acceleration, Frame>>& accelerations) const
       REQUIRES_SHARED(lock_);
 
   // Computes the potential resulting from one body, |body1| (with index |b1| in
-  // the |bodies_| and |trajectories_| arrays) at the given |positions|.  The
-  // template parameter specifies what we know about the massive body, and
-  // therefore what potential applies.
+  // the |bodies_| and |trajectories_| arrays, and located at |position1|) at
+  // the given |positions|.  The template parameter specifies what we know
+  // about the massive body, and therefore what potential applies.
   template<bool body1_is_oblate>
   void ComputeGravitationalPotentialsOfMassiveBody(
       Instant const& t,
       MassiveBody const& body1,
       std::size_t b1,
+      Position<Frame> const& position1,
       std::vector<Position<Frame>> const& positions,
       std::vector<SpecificEnergy>& potentials) const
       REQUIRES_SHARED(lock_);
@@ -431,6 +567,13 @@ class Ephemeris {
       _integration_parameters::AdaptiveStepParameters<ODE> const& parameters,
       std::int64_t max_ephemeris_steps) EXCLUDES(lock_);
 
+  // Returns a grid for the geopotential of |body|, or |std::nullopt| if the
+  // exact geopotential is cheap enough everywhere or if the grid would exceed
+  // the budget of nodes.
+  std::optional<GeopotentialGrid<Frame>> MakeGeopotentialGrid(
+      not_null<OblateBody<Frame> const*> body,
+      Geopotential<Frame> const& geopotential) const;
+
   // Computes an estimate of the ratio |tolerance / error|.
   static double ToleranceToErrorRatio(
       Length const& length_integration_tolerance,
@@ -452,6 +595,12 @@ class Ephemeris {
   // Only has entries for the oblate bodies, at the same indices as |bodies_|.
   std::vector<Geopotential<Frame>> geopotentials_;
 
+  // Same indices as |geopotentials_|.  Only has values if
+  // |accuracy_parameters_.use_geopotential_grids_| is true and the body has
+  // harmonics of degree 3 or above.  Only used for the accelerations on
+  // massless bodies.
+  std::vector<std::optional<GeopotentialGrid<Frame>>> geopotential_grids_;
+
   // The indices in |bodies_| correspond to those in |trajectories_|.
   std::vector<not_null<ContinuousTrajectory<Frame>*>> trajectories_;
 
@@ -491,6 +640,18 @@ class Ephemeris {
       instance_ GUARDED_BY(lock_);
 
   absl::Status last_severe_integration_status_ GUARDED_BY(lock_);
+
+  // The positions recently computed by |EvaluateBodyPositionsLocked|, indexed
+  // by a hash of their time.  Concurrent integrations (e.g., of vessels on a
+  // thread pool, or of prognostications) tend to evaluate the bodies at the
+  // same times, so they share the entries.  Once the trajectories cover a
+  // time, their values at that time never change, so the cache never needs to
+  // be invalidated.  Empty for a mock.
+  mutable std::vector<BodyPositionsCacheEntry> body_positions_cache_;
+  mutable std::atomic<std::int64_t> body_positions_cache_hits_ = 0;
+  mutable std::atomic<std::int64_t> body_positions_cache_misses_ = 0;
+
+  std::atomic<int> concurrency_threshold_ = default_concurrency_threshold;
 };
 
 }  // namespace internal
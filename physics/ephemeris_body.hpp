@@ -3,9 +3,13 @@
 #include "physics/ephemeris.hpp"
 
 #include <algorithm>
+#include <array>
+#include <deque>
 #include <functional>
+#include <future>
 #include <limits>
 #include <optional>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -16,12 +20,14 @@
 #include "base/macros.hpp"
 #include "base/map_util.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/r3_element.hpp"
 #include "geometry/symmetric_bilinear_form.hpp"
 #include "integrators/integrators.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
 #include "numerics/hermite3.hpp"
+#include "physics/barnes_hut.hpp"
 #include "physics/continuous_trajectory.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
@@ -40,6 +46,7 @@ using namespace principia::astronomy::_epoch;
 using namespace principia::base::_jthread;
 using namespace principia::base::_map_util;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::base::_traits;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_grassmann;
@@ -53,6 +60,7 @@ using namespace principia::integrators::_ordinary_differential_equations;
 using namespace principia::numerics::_double_precision;
 using namespace principia::numerics::_hermite3;
 using namespace principia::numerics::_root_finders;
+using namespace principia::physics::_barnes_hut;
 using namespace principia::physics::_oblate_body;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
@@ -64,10 +72,26 @@ using namespace std::chrono_literals;
 constexpr Length pre_ἐρατοσθένης_default_ephemeris_fitting_tolerance =
     1 * Milli(Metre);
 constexpr Time max_time_between_checkpoints = 180 * Day;
+// One checkpoint out of this number is stored in full, the others are stored as
+// deltas with respect to the previous checkpoint.
+constexpr std::int64_t checkpoint_keyframe_interval = 16;
 // Below this threshold detect a collision to prevent the integrator and the
 // downsampling from going postal.
 constexpr double min_radius_tolerance = 0.99;
 
+// Below this number of massless bodies, the structure-of-arrays conversion is
+// not worth it, and we use the scalar code, which also ensures that the
+// trajectory of a single vessel doesn't depend on the instruction set.
+constexpr std::size_t min_massless_bodies_for_vectorization = 4;
+
+// The largest number of nodes of a |GeopotentialGrid|, i.e., about 24 MiB per
+// oblate body.
+constexpr std::int64_t geopotential_grid_max_nodes = 1 << 20;
+
+// The number of entries of the cache of body positions.  Large enough for the
+// times evaluated by a few dozen concurrent integrations to coexist.
+constexpr int body_positions_cache_size = 64;
+
 inline absl::Status CollisionDetected() {
   return absl::OutOfRangeError("Collision detected");
 }
@@ -75,9 +99,15 @@ inline absl::Status CollisionDetected() {
 template<typename Frame>
 Ephemeris<Frame>::AccuracyParameters::AccuracyParameters(
     Length const& fitting_tolerance,
-    double const geopotential_tolerance)
+    double const geopotential_tolerance,
+    double const opening_angle,
+    bool const use_geopotential_grids)
     : fitting_tolerance_(fitting_tolerance),
-      geopotential_tolerance_(geopotential_tolerance) {}
+      geopotential_tolerance_(geopotential_tolerance),
+      opening_angle_(opening_angle),
+      use_geopotential_grids_(use_geopotential_grids) {
+  CHECK_GE(opening_angle_, 0);
+}
 
 template<typename Frame>
 void Ephemeris<Frame>::AccuracyParameters::WriteToMessage(
@@ -85,6 +115,12 @@ void Ephemeris<Frame>::AccuracyParameters::WriteToMessage(
     const {
   fitting_tolerance_.WriteToMessage(message->mutable_fitting_tolerance());
   message->set_geopotential_tolerance(geopotential_tolerance_);
+  if (opening_angle_ > 0) {
+    message->set_opening_angle(opening_angle_);
+  }
+  if (use_geopotential_grids_) {
+    message->set_use_geopotential_grids(true);
+  }
 }
 
 template<typename Frame>
@@ -93,7 +129,9 @@ Ephemeris<Frame>::AccuracyParameters::ReadFromMessage(
     serialization::Ephemeris::AccuracyParameters const& message) {
   return AccuracyParameters(
       Length::ReadFromMessage(message.fitting_tolerance()),
-      message.geopotential_tolerance());
+      message.geopotential_tolerance(),
+      message.opening_angle(),
+      message.use_geopotential_grids());
 }
 
 template<typename Frame>
@@ -108,7 +146,8 @@ Ephemeris<Frame>::Ephemeris(
       checkpointer_(
           make_not_null_unique<Checkpointer<serialization::Ephemeris>>(
               MakeCheckpointerWriter(),
-              MakeCheckpointerReader())),
+              MakeCheckpointerReader(),
+              checkpoint_keyframe_interval)),
       reanimator_(
           [this](Instant const& desired_t_min) {
             return Reanimate(desired_t_min);
@@ -163,6 +202,21 @@ Ephemeris<Frame>::Ephemeris(
     }
   }
 
+  geopotential_grids_.resize(number_of_oblate_bodies_);
+  if (accuracy_parameters_.use_geopotential_grids_) {
+    for (int b = 0; b < number_of_oblate_bodies_; ++b) {
+      geopotential_grids_[b] = MakeGeopotentialGrid(
+          dynamic_cast_not_null<OblateBody<Frame> const*>(bodies_[b].get()),
+          geopotentials_[b]);
+    }
+  }
+
+  body_positions_cache_ =
+      std::vector<BodyPositionsCacheEntry>(body_positions_cache_size);
+  for (auto& entry : body_positions_cache_) {
+    entry.coordinates = std::vector<std::atomic<double>>(3 * bodies_.size());
+  }
+
   absl::ReaderMutexLock l(&lock_);  // For locking checks.
   instance_ = fixed_step_parameters_.integrator().NewInstance(
       problem,
@@ -198,6 +252,54 @@ bool Ephemeris<Frame>::empty() const {
   return false;
 }
 
+template<typename Frame>
+std::vector<Position<Frame>> Ephemeris<Frame>::EvaluateAllPositions(
+    Instant const& t) const {
+  std::vector<Position<Frame>> body_positions;
+  {
+    absl::ReaderMutexLock l(&lock_);
+    EvaluateBodyPositionsLocked(t, body_positions);
+  }
+  std::vector<Position<Frame>> positions(bodies_.size());
+  for (int b = 0; b < bodies_.size(); ++b) {
+    positions[FindOrDie(unowned_bodies_indices_, bodies_[b].get())] =
+        body_positions[b];
+  }
+  return positions;
+}
+
+template<typename Frame>
+std::vector<DegreesOfFreedom<Frame>>
+Ephemeris<Frame>::EvaluateAllDegreesOfFreedom(Instant const& t) const {
+  std::vector<DegreesOfFreedom<Frame>> body_degrees_of_freedom;
+  {
+    absl::ReaderMutexLock l(&lock_);
+    body_degrees_of_freedom = EvaluateBodyDegreesOfFreedomLocked(t);
+  }
+  std::vector<DegreesOfFreedom<Frame>> degrees_of_freedom(
+      bodies_.size(), DegreesOfFreedom<Frame>(Frame::origin, Velocity<Frame>()));
+  for (int b = 0; b < bodies_.size(); ++b) {
+    degrees_of_freedom[FindOrDie(unowned_bodies_indices_, bodies_[b].get())] =
+        body_degrees_of_freedom[b];
+  }
+  return degrees_of_freedom;
+}
+
+template<typename Frame>
+typename Ephemeris<Frame>::BodyPositionsCacheStatistics
+Ephemeris<Frame>::body_positions_cache_statistics() const {
+  BodyPositionsCacheStatistics statistics;
+  statistics.hits = body_positions_cache_hits_.load(std::memory_order_relaxed);
+  statistics.misses =
+      body_positions_cache_misses_.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::SetConcurrencyThreshold(int const threshold) {
+  concurrency_threshold_.store(threshold, std::memory_order_relaxed);
+}
+
 template<typename Frame>
 Instant Ephemeris<Frame>::t_min() const {
   absl::ReaderMutexLock l(&lock_);
@@ -463,18 +565,15 @@ JacobianOfAcceleration<Frame> Ephemeris<Frame>::ComputeJacobianOnMassiveBody(
   // "locked" method of each trajectory.
   {
     absl::ReaderMutexLock l(&lock_);
-    positions.reserve(bodies_.size());
-    for (int b = 0; b < bodies_.size(); ++b) {
-      auto const& current_body = bodies_[b];
-      auto const& current_body_trajectory = trajectories_[b];
-      if (current_body.get() == body) {
-        CHECK_EQ(-1, b1);
-        b1 = b;
-      }
-      positions.push_back(current_body_trajectory->EvaluatePositionLocked(t));
+    EvaluateBodyPositionsLocked(t, positions);
+  }
+  for (int b = 0; b < bodies_.size(); ++b) {
+    if (bodies_[b].get() == body) {
+      CHECK_EQ(-1, b1);
+      b1 = b;
     }
-    CHECK_LE(0, b1);
   }
+  CHECK_LE(0, b1);
 
   ComputeJacobianByMassiveBodyOnMassiveBodies(
       /*body1=*/*body, b1,
@@ -505,19 +604,15 @@ ComputeGravitationalJerkOnMassiveBody(not_null<MassiveBody const*> body,
   // the "locked" method of each trajectory.
   {
     absl::ReaderMutexLock l(&lock_);
-    degrees_of_freedom.reserve(bodies_.size());
-    for (int b = 0; b < bodies_.size(); ++b) {
-      auto const& current_body = bodies_[b];
-      auto const& current_body_trajectory = trajectories_[b];
-      if (current_body.get() == body) {
-        CHECK_EQ(-1, b1);
-        b1 = b;
-      }
-      degrees_of_freedom.push_back(
-          current_body_trajectory->EvaluateDegreesOfFreedomLocked(t));
+    degrees_of_freedom = EvaluateBodyDegreesOfFreedomLocked(t);
+  }
+  for (int b = 0; b < bodies_.size(); ++b) {
+    if (bodies_[b].get() == body) {
+      CHECK_EQ(-1, b1);
+      b1 = b;
     }
-    CHECK_LE(0, b1);
   }
+  CHECK_LE(0, b1);
 
   ComputeGravitationalJerkByMassiveBodyOnMassiveBodies(
       /*body1=*/*body, b1,
@@ -575,18 +670,15 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationOnMassiveBody(
   // "locked" method of each trajectory.
   {
     absl::ReaderMutexLock l(&lock_);
-    positions.reserve(bodies_.size());
-    for (int b = 0; b < bodies_.size(); ++b) {
-      auto const& current_body = bodies_[b];
-      auto const& current_body_trajectory = trajectories_[b];
-      if (current_body.get() == body) {
-        CHECK_EQ(-1, b1);
-        b1 = b;
-      }
-      positions.push_back(current_body_trajectory->EvaluatePositionLocked(t));
+    EvaluateBodyPositionsLocked(t, positions);
+  }
+  for (int b = 0; b < bodies_.size(); ++b) {
+    if (bodies_[b].get() == body) {
+      CHECK_EQ(-1, b1);
+      b1 = b;
     }
-    CHECK_LE(0, b1);
   }
+  CHECK_LE(0, b1);
 
   if (body_is_oblate) {
     ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies<
@@ -805,17 +897,37 @@ not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
                        accuracy_parameters,
                        fixed_step_parameters);
 
+  // The trajectories are independent of each other, and reading their
+  // polynomials is expensive, so they are deserialized in parallel.
+  std::vector<std::unique_ptr<ContinuousTrajectory<Frame>>>
+      deserialized_trajectories(message.trajectory_size());
+  {
+    ThreadPool<void> pool(
+        /*pool_size=*/std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < message.trajectory_size(); ++i) {
+      futures.push_back(pool.Add(
+          [&deserialized_trajectory = deserialized_trajectories[i],
+           &desired_t_min,
+           &trajectory = message.trajectory(i)]() {
+            deserialized_trajectory =
+                ContinuousTrajectory<Frame>::ReadFromMessage(desired_t_min,
+                                                             trajectory);
+          }));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+  }
+
   int index = 0;
   ephemeris->bodies_to_trajectories_.clear();
   ephemeris->trajectories_.clear();
-  for (auto const& trajectory : message.trajectory()) {
+  for (auto& deserialized_trajectory : deserialized_trajectories) {
     not_null<MassiveBody const*> const body = ephemeris->bodies_[index].get();
-    not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>
-        deserialized_trajectory = ContinuousTrajectory<Frame>::ReadFromMessage(
-            desired_t_min, trajectory);
     ephemeris->trajectories_.push_back(deserialized_trajectory.get());
     ephemeris->bodies_to_trajectories_.emplace(
-        body, std::move(deserialized_trajectory));
+        body, check_not_null(std::move(deserialized_trajectory)));
     ++index;
   }
   CHECK_LT(0, index) << "Empty ephemeris";
@@ -834,13 +946,15 @@ not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
         Checkpointer<serialization::Ephemeris>::ReadFromMessage(
             ephemeris->MakeCheckpointerWriter(),
             ephemeris->MakeCheckpointerReader(),
-            serialized_ephemeris.checkpoint());
+            serialized_ephemeris.checkpoint(),
+            checkpoint_keyframe_interval);
   } else {
     ephemeris->checkpointer_ =
         Checkpointer<serialization::Ephemeris>::ReadFromMessage(
             ephemeris->MakeCheckpointerWriter(),
             ephemeris->MakeCheckpointerReader(),
-            message.checkpoint());
+            message.checkpoint(),
+            checkpoint_keyframe_interval);
   }
 
   // The checkpoint at or before |desired_t_min| will result in a |t_min()|
@@ -941,30 +1055,92 @@ absl::Status Ephemeris<Frame>::Reanimate(Instant const desired_t_min) {
     checkpoints = checkpointer_->all_checkpoints_between(
         oldest_checkpoint_to_reanimate, oldest_reanimated_checkpoint_);
   }
+  if (checkpoints.size() < 2) {
+    return absl::OkStatus();
+  }
+
+  // A segment between two consecutive checkpoints, reanimated on the pool.
+  struct Segment {
+    Instant t_initial;
+    Instant t_final;
+    std::vector<not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>>
+        trajectories;
+    std::future<absl::Status> status;
+  };
+
+  // The threads of the pool must honour the stop requests made to the
+  // |reanimator_|.
+  stop_token const reanimator_stop_token =
+      this_stoppable_thread::get_stop_token();
+
+  // The segments are independent so they are integrated in parallel, but they
+  // must be prepended to the trajectories going backwards in time.  To bound
+  // the memory taken by the segments that are waiting to be prepended, no more
+  // segments than there are threads in the pool are in flight at any one time.
+  // The segments are stored in a deque so that the tasks may keep references
+  // to them.  The pool is declared after the deque so that its threads are
+  // joined before the segments are destroyed, including when we return early
+  // because of an error.
+  std::int64_t const pool_size = std::min<std::int64_t>(
+      checkpoints.size() - 1,
+      std::max(1u, std::thread::hardware_concurrency()));
+  std::deque<Segment> segments;
+  ThreadPool<absl::Status> pool(pool_size);
+
+  // Waits for the reanimation of the most recent segment in flight, stitches
+  // its trajectories to the ones in this ephemeris and records that we will
+  // not reanimate its checkpoint again.  Don't proceed in case of error, we
+  // would run into a gap when trying to stitch the trajectories.
+  auto const stitch_most_recent_segment = [this, &segments]() {
+    Segment& segment = segments.front();
+    RETURN_IF_ERROR(segment.status.get());
+    {
+      absl::MutexLock l(&lock_);
+      for (int i = 0; i < trajectories_.size(); ++i) {
+        trajectories_[i]->Prepend(std::move(*segment.trajectories[i]));
+      }
+      oldest_reanimated_checkpoint_ = segment.t_initial;
+    }
+    segments.pop_front();
+    return absl::OkStatus();
+  };
 
-  // This loop integrates all the segments defined by the checkpoints, going
-  // backwards in time.  The last checkpoint is not restored, it just serves as
-  // a limit.
+  // This loop starts the reanimation of all the segments defined by the
+  // checkpoints, going backwards in time.  The last checkpoint is not restored,
+  // it just serves as a limit.
   std::optional<Instant> following_checkpoint;
   for (auto it = checkpoints.crbegin(); it != checkpoints.crend(); ++it) {
     Instant const& checkpoint = *it;
     if (following_checkpoint.has_value()) {
-      RETURN_IF_ERROR(checkpointer_->ReadFromCheckpointAt(
-          checkpoint,
-          [this,
-           t_final = following_checkpoint.value(),
-           t_initial = checkpoint](
-              serialization::Ephemeris::Checkpoint const& message) {
-            if constexpr (is_serializable_v<Frame>) {
-              return ReanimateOneCheckpoint(message, t_initial, t_final);
-            } else {
-              return absl::UnknownError(
-                  "No reanimation for non-serializable frames");
-            }
-          }));
+      if (segments.size() == pool_size) {
+        RETURN_IF_ERROR(stitch_most_recent_segment());
+      }
+      Segment& segment = segments.emplace_back();
+      segment.t_initial = checkpoint;
+      segment.t_final = following_checkpoint.value();
+      segment.status = pool.Add([this, reanimator_stop_token, &segment]() {
+        this_stoppable_thread::StopTokenSetter setter(reanimator_stop_token);
+        return checkpointer_->ReadFromCheckpointAt(
+            segment.t_initial,
+            [this, &segment](
+                serialization::Ephemeris::Checkpoint const& message) {
+              if constexpr (is_serializable_v<Frame>) {
+                return ReanimateOneCheckpoint(message,
+                                              segment.t_initial,
+                                              segment.t_final,
+                                              segment.trajectories);
+              } else {
+                return absl::UnknownError(
+                    "No reanimation for non-serializable frames");
+              }
+            });
+      });
     }
     following_checkpoint = checkpoint;
   }
+  while (!segments.empty()) {
+    RETURN_IF_ERROR(stitch_most_recent_segment());
+  }
   return absl::OkStatus();
 }
 
@@ -972,13 +1148,14 @@ template<typename Frame>
 absl::Status Ephemeris<Frame>::ReanimateOneCheckpoint(
     serialization::Ephemeris::Checkpoint const& message,
     Instant const& t_initial,
-    Instant const& t_final) {
+    Instant const& t_final,
+    std::vector<not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>>&
+        trajectories) {
   LOG(INFO) << "Reanimating segment from " << t_initial << " to " << t_final;
+  CHECK(trajectories.empty());
 
   // Create new trajectories and initialize them from the checkpoint at
   // t_initial.
-  std::vector<not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>>
-      trajectories;
   for (int i = 0; i < trajectories_.size(); ++i) {
     trajectories.emplace_back(std::make_unique<ContinuousTrajectory<Frame>>(
         fixed_step_parameters_.step(),
@@ -1004,21 +1181,8 @@ absl::Status Ephemeris<Frame>::ReanimateOneCheckpoint(
 
   // Do the integration.  After this step the t_max() of the trajectories may
   // be before t_final because there may be last_points_ that haven't been put
-  // in a series.  Don't proceed in case of error, we would run into a gap when
-  // trying to stitch the trajectories.
-  RETURN_IF_ERROR(instance->Solve(t_final));
-
-  // Stitch the local trajectories to the ones in this ephemeris and record that
-  // we will not reanimate this checkpoint again.
-  {
-    absl::MutexLock l(&lock_);
-    for (int i = 0; i < trajectories_.size(); ++i) {
-      trajectories_[i]->Prepend(std::move(*trajectories[i]));
-    }
-    oldest_reanimated_checkpoint_ = t_initial;
-  }
-
-  return absl::OkStatus();
+  // in a series.
+  return instance->Solve(t_final);
 }
 
 template<typename Frame>
@@ -1075,10 +1239,17 @@ void Ephemeris<Frame>::AppendMasslessBodiesStateToTrajectories(
   Instant const time = state.time.value;
   int index = 0;
   for (auto& trajectory : trajectories) {
-    trajectory->Append(
-        time,
-        DegreesOfFreedom<Frame>(state.positions[index].value,
-                                state.velocities[index].value)).IgnoreError();
+    DegreesOfFreedom<Frame> const degrees_of_freedom(
+        state.positions[index].value, state.velocities[index].value);
+    // Record the accelerations if the integrator produced them, so that the
+    // trajectory may be interpolated with a higher degree.
+    if (state.accelerations.empty()) {
+      trajectory->Append(time, degrees_of_freedom).IgnoreError();
+    } else {
+      trajectory->Append(time,
+                         degrees_of_freedom,
+                         state.accelerations[index]).IgnoreError();
+    }
     ++index;
   }
 }
@@ -1125,6 +1296,85 @@ Instant Ephemeris<Frame>::t_max_locked() const {
   return t_max;
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::EvaluateBodyPositionsLocked(
+    Instant const& t,
+    std::vector<Position<Frame>>& positions) const {
+  lock_.AssertReaderHeld();
+  positions.clear();
+  positions.reserve(trajectories_.size());
+  double const t_in_seconds = (t - Instant()) / Second;
+  BodyPositionsCacheEntry& entry =
+      body_positions_cache_[std::hash<double>()(t_in_seconds) %
+                            body_positions_cache_.size()];
+
+  // Try to read the positions from the cache.
+  std::uint64_t const sequence =
+      entry.sequence.load(std::memory_order_acquire);
+  if (sequence % 2 == 0 &&
+      entry.t.load(std::memory_order_relaxed) == t_in_seconds) {
+    for (int b = 0; b < trajectories_.size(); ++b) {
+      positions.push_back(
+          Frame::origin +
+          Displacement<Frame>(
+              {entry.coordinates[3 * b].load(std::memory_order_relaxed) *
+                   Metre,
+               entry.coordinates[3 * b + 1].load(std::memory_order_relaxed) *
+                   Metre,
+               entry.coordinates[3 * b + 2].load(std::memory_order_relaxed) *
+                   Metre}));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (entry.sequence.load(std::memory_order_relaxed) == sequence) {
+      body_positions_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    // A writer overwrote the entry while we were reading it.
+    positions.clear();
+  }
+  body_positions_cache_misses_.fetch_add(1, std::memory_order_relaxed);
+
+  std::int64_t const index = trajectories_.front()->PolynomialIndexLocked(t);
+  for (auto const trajectory : trajectories_) {
+    positions.push_back(trajectory->EvaluatePositionLocked(t, index));
+  }
+
+  // Try to write the positions to the cache.  If another thread is writing the
+  // same entry, give up, it is only a cache.
+  std::uint64_t expected = entry.sequence.load(std::memory_order_relaxed);
+  if (expected % 2 == 0 &&
+      entry.sequence.compare_exchange_strong(expected,
+                                             expected + 1,
+                                             std::memory_order_relaxed)) {
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.t.store(t_in_seconds, std::memory_order_relaxed);
+    for (int b = 0; b < positions.size(); ++b) {
+      auto const coordinates = (positions[b] - Frame::origin).coordinates();
+      entry.coordinates[3 * b].store(coordinates.x / Metre,
+                                     std::memory_order_relaxed);
+      entry.coordinates[3 * b + 1].store(coordinates.y / Metre,
+                                         std::memory_order_relaxed);
+      entry.coordinates[3 * b + 2].store(coordinates.z / Metre,
+                                         std::memory_order_relaxed);
+    }
+    entry.sequence.store(expected + 2, std::memory_order_release);
+  }
+}
+
+template<typename Frame>
+std::vector<DegreesOfFreedom<Frame>>
+Ephemeris<Frame>::EvaluateBodyDegreesOfFreedomLocked(Instant const& t) const {
+  lock_.AssertReaderHeld();
+  std::vector<DegreesOfFreedom<Frame>> degrees_of_freedom;
+  degrees_of_freedom.reserve(trajectories_.size());
+  std::int64_t const index = trajectories_.front()->PolynomialIndexLocked(t);
+  for (auto const trajectory : trajectories_) {
+    degrees_of_freedom.push_back(
+        trajectory->EvaluateDegreesOfFreedomLocked(t, index));
+  }
+  return degrees_of_freedom;
+}
+
 template<typename Frame>
 template<typename MassiveBodyConstPtr>
 void Ephemeris<Frame>::ComputeJacobianByMassiveBodyOnMassiveBodies(
@@ -1277,12 +1527,11 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
     Instant const& t,
     MassiveBody const& body1,
     std::size_t const b1,
+    Position<Frame> const& position1,
     std::vector<Position<Frame>> const& positions,
     std::vector<Vector<Acceleration, Frame>>& accelerations) const {
   lock_.AssertReaderHeld();
   GravitationalParameter const& μ1 = body1.gravitational_parameter();
-  auto const& trajectory1 = *trajectories_[b1];
-  Position<Frame> const position1 = trajectory1.EvaluatePositionLocked(t);
   Length const body1_collision_radius =
       min_radius_tolerance * body1.min_radius();
   // TODO(phl): Use std::to_underlying when we have C++23.
@@ -1306,19 +1555,24 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
     auto const μ1_over_Δq³ = μ1 * one_over_Δq³;
     accelerations[b2] += Δq * μ1_over_Δq³;
 
-    if (body1_is_oblate) {
+    if (body1_is_oblate && positions.size() == 1) {
+      auto const& geopotential_grid = geopotential_grids_[b1];
       Vector<Quotient<Acceleration,
                       GravitationalParameter>, Frame> const
           spherical_harmonics_effect =
-              geopotentials_[b1].GeneralSphericalHarmonicsAcceleration(
-                  t,
-                  -Δq,
-                  Δq_norm,
-                  Δq²,
-                  one_over_Δq³);
+              geopotential_grid.has_value()
+                  ? geopotential_grid->GeneralSphericalHarmonicsAcceleration(
+                        t, -Δq, Δq_norm, Δq², one_over_Δq³)
+                  : geopotentials_[b1].GeneralSphericalHarmonicsAcceleration(
+                        t, -Δq, Δq_norm, Δq², one_over_Δq³);
       accelerations[b2] += μ1 * spherical_harmonics_effect;
     }
   }
+
+  if (body1_is_oblate && positions.size() > 1) {
+    AccumulateSphericalHarmonicsAccelerationsOnMasslessBodies(
+        t, μ1, b1, position1, positions, accelerations);
+  }
   return error;
 }
 
@@ -1328,12 +1582,11 @@ void Ephemeris<Frame>::ComputeGravitationalPotentialsOfMassiveBody(
     Instant const& t,
     MassiveBody const& body1,
     std::size_t b1,
+    Position<Frame> const& position1,
     std::vector<Position<Frame>> const& positions,
     std::vector<SpecificEnergy>& potentials) const {
   lock_.AssertReaderHeld();
   GravitationalParameter const& μ1 = body1.gravitational_parameter();
-  auto const& trajectory1 = *trajectories_[b1];
-  Position<Frame> const position1 = trajectory1.EvaluatePositionLocked(t);
 
   for (std::size_t b2 = 0; b2 < positions.size(); ++b2) {
     // A vector from the center of |b2| to the center of |b1|.
@@ -1392,25 +1645,219 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationBetweenAllMassiveBodies(
         /*b2_end=*/number_of_oblate_bodies_ + number_of_spherical_bodies_,
         positions, accelerations, geopotentials_);
   }
-  for (std::size_t b1 = number_of_oblate_bodies_;
-       b1 < number_of_oblate_bodies_ +
-            number_of_spherical_bodies_;
-       ++b1) {
-    MassiveBody const& body1 = *bodies_[b1];
-    ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies<
-        /*body1_is_oblate=*/false,
-        /*body2_is_oblate=*/false>(
-        t,
-        body1, b1,
-        /*bodies2=*/bodies_,
-        /*b2_begin=*/b1 + 1,
-        /*b2_end=*/number_of_oblate_bodies_ + number_of_spherical_bodies_,
-        positions, accelerations, geopotentials_);
+  if (accuracy_parameters_.opening_angle_ > 0) {
+    ComputeGravitationalAccelerationsBetweenSphericalBodiesApproximately(
+        positions, accelerations);
+  } else if (number_of_spherical_bodies_ >=
+             concurrency_threshold_.load(std::memory_order_relaxed)) {
+    ComputeGravitationalAccelerationsBetweenSphericalBodiesConcurrently(
+        positions, accelerations);
+  } else if (UseAVX) {
+    ComputeGravitationalAccelerationsBetweenSphericalBodies(positions,
+                                                            accelerations);
+  } else {
+    for (std::size_t b1 = number_of_oblate_bodies_;
+         b1 < number_of_oblate_bodies_ +
+              number_of_spherical_bodies_;
+         ++b1) {
+      MassiveBody const& body1 = *bodies_[b1];
+      ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies<
+          /*body1_is_oblate=*/false,
+          /*body2_is_oblate=*/false>(
+          t,
+          body1, b1,
+          /*bodies2=*/bodies_,
+          /*b2_begin=*/b1 + 1,
+          /*b2_end=*/number_of_oblate_bodies_ + number_of_spherical_bodies_,
+          positions, accelerations, geopotentials_);
+    }
   }
 
   return absl::OkStatus();
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::ComputeGravitationalAccelerationsBetweenSphericalBodies(
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  // This function may be called concurrently by the planetary integrator and
+  // by the reanimator, hence the thread-local storage.
+  thread_local PointMassArrays arrays;
+  arrays.Reset(number_of_spherical_bodies_);
+  for (std::int64_t i = 0; i < number_of_spherical_bodies_; ++i) {
+    std::size_t const b = number_of_oblate_bodies_ + i;
+    auto const coordinates = (positions[b] - Frame::origin).coordinates();
+    arrays.x[i] = coordinates.x / si::Unit<Length>;
+    arrays.y[i] = coordinates.y / si::Unit<Length>;
+    arrays.z[i] = coordinates.z / si::Unit<Length>;
+    arrays.μ[i] = bodies_[b]->gravitational_parameter() /
+                  si::Unit<GravitationalParameter>;
+  }
+
+  for (std::int64_t i1 = 0; i1 < number_of_spherical_bodies_; ++i1) {
+    AccumulateMutualAccelerations(/*b1=*/i1,
+                                  /*b2_begin=*/i1 + 1,
+                                  /*b2_end=*/number_of_spherical_bodies_,
+                                  arrays);
+  }
+
+  for (std::int64_t i = 0; i < number_of_spherical_bodies_; ++i) {
+    std::size_t const b = number_of_oblate_bodies_ + i;
+    accelerations[b] += Vector<Acceleration, Frame>(
+        {arrays.ax[i] * si::Unit<Acceleration>,
+         arrays.ay[i] * si::Unit<Acceleration>,
+         arrays.az[i] * si::Unit<Acceleration>});
+  }
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::
+ComputeGravitationalAccelerationsBetweenSphericalBodiesConcurrently(
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  // The number of blocks is fixed, not derived from the number of threads, so
+  // that the order of the summations, and therefore the result, is the same
+  // on all machines.
+  constexpr int blocks = 16;
+
+  // The workers are shared by all the ephemerides.  Their tasks never add tasks
+  // to the pool, so there is no risk of deadlock.  The pool is leaked to avoid
+  // joining its threads at exit.
+  static auto* const pool = new ThreadPool<void>(
+      /*pool_size=*/std::max(1u, std::thread::hardware_concurrency()));
+
+  // This function may be called concurrently by the planetary integrator and
+  // by the reanimator, hence the thread-local storage.  Each block has its own
+  // arrays, so that its partial sums don't interfere with those of the other
+  // blocks.  Note that the tasks must not refer to the thread-local variable
+  // directly, as they run on other threads.
+  thread_local std::vector<PointMassArrays> arrays_of_blocks(blocks);
+  not_null<std::vector<PointMassArrays>*> const block_arrays =
+      &arrays_of_blocks;
+
+  std::int64_t const n = number_of_spherical_bodies_;
+  PointMassArrays& first_arrays = arrays_of_blocks.front();
+  first_arrays.Reset(n);
+  for (std::int64_t i = 0; i < n; ++i) {
+    std::size_t const b = number_of_oblate_bodies_ + i;
+    auto const coordinates = (positions[b] - Frame::origin).coordinates();
+    first_arrays.x[i] = coordinates.x / si::Unit<Length>;
+    first_arrays.y[i] = coordinates.y / si::Unit<Length>;
+    first_arrays.z[i] = coordinates.z / si::Unit<Length>;
+    first_arrays.μ[i] = bodies_[b]->gravitational_parameter() /
+                        si::Unit<GravitationalParameter>;
+  }
+  for (int block = 1; block < blocks; ++block) {
+    PointMassArrays& arrays = arrays_of_blocks[block];
+    arrays.Reset(n);
+    arrays.x = first_arrays.x;
+    arrays.y = first_arrays.y;
+    arrays.z = first_arrays.z;
+    arrays.μ = first_arrays.μ;
+  }
+
+  // Body |i1| interacts with the |n - 1 - i1| bodies that follow it.  Split the
+  // bodies in ranges of consecutive |i1| having roughly the same number of
+  // interactions.  Block |block| processes the range
+  // [block_begins[block], block_begins[block + 1][, which may be empty.
+  std::array<std::int64_t, blocks + 1> block_begins;
+  block_begins.front() = 0;
+  block_begins.back() = n;
+  {
+    std::int64_t const total_interactions = n * (n - 1) / 2;
+    std::int64_t interactions = 0;
+    int block = 1;
+    for (std::int64_t i1 = 0; i1 < n && block < blocks; ++i1) {
+      interactions += n - 1 - i1;
+      if (interactions * blocks >= block * total_interactions) {
+        block_begins[block++] = i1 + 1;
+      }
+    }
+    for (; block < blocks; ++block) {
+      block_begins[block] = n;
+    }
+  }
+
+  auto const accumulate_block = [block_arrays, &block_begins, n](
+                                    int const block) {
+    PointMassArrays& arrays = (*block_arrays)[block];
+    for (std::int64_t i1 = block_begins[block];
+         i1 < block_begins[block + 1];
+         ++i1) {
+      AccumulateMutualAccelerations(/*b1=*/i1,
+                                    /*b2_begin=*/i1 + 1,
+                                    /*b2_end=*/n,
+                                    arrays);
+    }
+  };
+
+  // The first block is processed on this thread, which would otherwise be
+  // idle.
+  std::vector<std::future<void>> futures;
+  futures.reserve(blocks - 1);
+  for (int block = 1; block < blocks; ++block) {
+    if (block_begins[block] < block_begins[block + 1]) {
+      futures.push_back(pool->Add([&accumulate_block, block]() {
+        accumulate_block(block);
+      }));
+    }
+  }
+  accumulate_block(0);
+  for (auto const& future : futures) {
+    future.wait();
+  }
+
+  // Add the partial sums in the order of the blocks.
+  for (std::int64_t i = 0; i < n; ++i) {
+    double ax = 0;
+    double ay = 0;
+    double az = 0;
+    for (auto const& arrays : arrays_of_blocks) {
+      ax += arrays.ax[i];
+      ay += arrays.ay[i];
+      az += arrays.az[i];
+    }
+    std::size_t const b = number_of_oblate_bodies_ + i;
+    accelerations[b] += Vector<Acceleration, Frame>(
+        {ax * si::Unit<Acceleration>,
+         ay * si::Unit<Acceleration>,
+         az * si::Unit<Acceleration>});
+  }
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::
+ComputeGravitationalAccelerationsBetweenSphericalBodiesApproximately(
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  // This function may be called concurrently by the planetary integrator and
+  // by the reanimator, hence the thread-local storage.  The tree is rebuilt for
+  // each evaluation, but its storage is reused.
+  thread_local PointMassArrays arrays;
+  thread_local BarnesHutTree tree;
+  arrays.Reset(number_of_spherical_bodies_);
+  for (std::int64_t i = 0; i < number_of_spherical_bodies_; ++i) {
+    std::size_t const b = number_of_oblate_bodies_ + i;
+    auto const coordinates = (positions[b] - Frame::origin).coordinates();
+    arrays.x[i] = coordinates.x / si::Unit<Length>;
+    arrays.y[i] = coordinates.y / si::Unit<Length>;
+    arrays.z[i] = coordinates.z / si::Unit<Length>;
+    arrays.μ[i] = bodies_[b]->gravitational_parameter() /
+                  si::Unit<GravitationalParameter>;
+  }
+
+  tree.Build(arrays);
+  tree.AccumulateAccelerations(accuracy_parameters_.opening_angle_, arrays);
+
+  for (std::int64_t i = 0; i < number_of_spherical_bodies_; ++i) {
+    std::size_t const b = number_of_oblate_bodies_ + i;
+    accelerations[b] += Vector<Acceleration, Frame>(
+        {arrays.ax[i] * si::Unit<Acceleration>,
+         arrays.ay[i] * si::Unit<Acceleration>,
+         arrays.az[i] * si::Unit<Acceleration>});
+  }
+}
+
 template<typename Frame>
 absl::StatusCode
 Ephemeris<Frame>::
@@ -1426,12 +1873,21 @@ ComputeGravitationalAccelerationByAllMassiveBodiesOnMasslessBodies(
 
   // Locking ensures that we see a consistent state of all the trajectories.
   absl::ReaderMutexLock l(&lock_);
+  // This function may be called concurrently for different vessels, hence the
+  // thread-local storage.
+  thread_local std::vector<Position<Frame>> body_positions;
+  EvaluateBodyPositionsLocked(t, body_positions);
+  if (UseAVX && positions.size() >= min_massless_bodies_for_vectorization) {
+    error |= ComputeGravitationalAccelerationsOnMasslessBodiesVectorized(
+        t, body_positions, positions, accelerations);
+    return static_cast<absl::StatusCode>(error);
+  }
   for (std::size_t b1 = 0; b1 < number_of_oblate_bodies_; ++b1) {
     MassiveBody const& body1 = *bodies_[b1];
     error |= ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies<
                  /*body1_is_oblate=*/true>(
                  t,
-                 body1, b1,
+                 body1, b1, body_positions[b1],
                  positions,
                  accelerations);
   }
@@ -1443,13 +1899,107 @@ ComputeGravitationalAccelerationByAllMassiveBodiesOnMasslessBodies(
     error |= ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies<
                  /*body1_is_oblate=*/false>(
                  t,
-                 body1, b1,
+                 body1, b1, body_positions[b1],
                  positions,
                  accelerations);
   }
   return static_cast<absl::StatusCode>(error);
 }
 
+template<typename Frame>
+std::underlying_type_t<absl::StatusCode>
+Ephemeris<Frame>::
+ComputeGravitationalAccelerationsOnMasslessBodiesVectorized(
+    Instant const& t,
+    std::vector<Position<Frame>> const& body_positions,
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  lock_.AssertReaderHeld();
+  // TODO(phl): Use std::to_underlying when we have C++23.
+  auto error = static_cast<std::underlying_type_t<absl::StatusCode>>(
+      absl::StatusCode::kOk);
+
+  // This function may be called concurrently for different vessels, hence the
+  // thread-local storage.
+  thread_local PointMassArrays arrays;
+  arrays.Reset(positions.size());
+  for (std::size_t b2 = 0; b2 < positions.size(); ++b2) {
+    auto const coordinates = (positions[b2] - Frame::origin).coordinates();
+    arrays.x[b2] = coordinates.x / si::Unit<Length>;
+    arrays.y[b2] = coordinates.y / si::Unit<Length>;
+    arrays.z[b2] = coordinates.z / si::Unit<Length>;
+  }
+
+  for (std::size_t b1 = 0;
+       b1 < number_of_oblate_bodies_ + number_of_spherical_bodies_;
+       ++b1) {
+    MassiveBody const& body1 = *bodies_[b1];
+    GravitationalParameter const& μ1 = body1.gravitational_parameter();
+    Position<Frame> const& position1 = body_positions[b1];
+    auto const coordinates1 = (position1 - Frame::origin).coordinates();
+    Length const body1_collision_radius =
+        min_radius_tolerance * body1.min_radius();
+    bool const collision = AccumulateAccelerationsByPointMass(
+        coordinates1.x / si::Unit<Length>,
+        coordinates1.y / si::Unit<Length>,
+        coordinates1.z / si::Unit<Length>,
+        μ1 / si::Unit<GravitationalParameter>,
+        body1_collision_radius / si::Unit<Length>,
+        arrays);
+    error |= collision
+                 ? static_cast<std::underlying_type_t<absl::StatusCode>>(
+                       absl::StatusCode::kOutOfRange)
+                 : static_cast<std::underlying_type_t<absl::StatusCode>>(
+                       absl::StatusCode::kOk);
+
+    if (b1 < number_of_oblate_bodies_) {
+      AccumulateSphericalHarmonicsAccelerationsOnMasslessBodies(
+          t, μ1, b1, position1, positions, accelerations);
+    }
+  }
+
+  for (std::size_t b2 = 0; b2 < positions.size(); ++b2) {
+    accelerations[b2] += Vector<Acceleration, Frame>(
+        {arrays.ax[b2] * si::Unit<Acceleration>,
+         arrays.ay[b2] * si::Unit<Acceleration>,
+         arrays.az[b2] * si::Unit<Acceleration>});
+  }
+  return error;
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::AccumulateSphericalHarmonicsAccelerationsOnMasslessBodies(
+    Instant const& t,
+    GravitationalParameter const& μ1,
+    std::size_t const b1,
+    Position<Frame> const& position1,
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  lock_.AssertReaderHeld();
+  // This function may be called concurrently for different vessels, hence the
+  // thread-local storage.
+  thread_local std::vector<Displacement<Frame>> displacements;
+  thread_local std::vector<
+      Vector<Quotient<Acceleration, GravitationalParameter>, Frame>>
+      spherical_harmonics_effects;
+  displacements.clear();
+  for (std::size_t b2 = 0; b2 < positions.size(); ++b2) {
+    // A vector from the center of |b1| to the center of |b2|, i.e., |-Δq|.
+    displacements.push_back(positions[b2] - position1);
+  }
+  if (auto const& geopotential_grid = geopotential_grids_[b1];
+      geopotential_grid.has_value()) {
+    geopotential_grid->GeneralSphericalHarmonicsAccelerations(
+        t, displacements, spherical_harmonics_effects);
+  } else {
+    geopotentials_[b1].GeneralSphericalHarmonicsAccelerations(
+        t, displacements, spherical_harmonics_effects);
+  }
+  for (std::size_t b2 = 0; b2 < positions.size(); ++b2) {
+    accelerations[b2] += μ1 * spherical_harmonics_effects[b2];
+  }
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::ComputeGravitationalPotentialsOfAllMassiveBodies(
     Instant const& t,
@@ -1460,11 +2010,13 @@ void Ephemeris<Frame>::ComputeGravitationalPotentialsOfAllMassiveBodies(
 
   // Locking ensures that we see a consistent state of all the trajectories.
   absl::ReaderMutexLock l(&lock_);
+  std::vector<Position<Frame>> body_positions;
+  EvaluateBodyPositionsLocked(t, body_positions);
   for (std::size_t b1 = 0; b1 < number_of_oblate_bodies_; ++b1) {
     MassiveBody const& body1 = *bodies_[b1];
     ComputeGravitationalPotentialsOfMassiveBody</*body1_is_oblate=*/true>(
         t,
-        body1, b1,
+        body1, b1, body_positions[b1],
         positions,
         potentials);
   }
@@ -1475,7 +2027,7 @@ void Ephemeris<Frame>::ComputeGravitationalPotentialsOfAllMassiveBodies(
     MassiveBody const& body1 = *bodies_[b1];
     ComputeGravitationalPotentialsOfMassiveBody</*body1_is_oblate=*/false>(
         t,
-        body1, b1,
+        body1, b1, body_positions[b1],
         positions,
         potentials);
   }
@@ -1563,6 +2115,29 @@ absl::Status Ephemeris<Frame>::FlowODEWithAdaptiveStep(
   }
 }
 
+template<typename Frame>
+std::optional<GeopotentialGrid<Frame>> Ephemeris<Frame>::MakeGeopotentialGrid(
+    not_null<OblateBody<Frame> const*> const body,
+    Geopotential<Frame> const& geopotential) const {
+  // The grid covers the shell where the harmonics of degree 3 and above
+  // contribute.  Beyond it, the exact geopotential is cheap.
+  auto const& degree_damping = geopotential.degree_damping();
+  if (degree_damping.size() <= 3) {
+    return std::nullopt;
+  }
+  Length const inner_radius = body->min_radius();
+  Length const outer_radius = degree_damping[3].outer_threshold();
+  if (!IsFinite(outer_radius) || outer_radius <= inner_radius) {
+    return std::nullopt;
+  }
+  return GeopotentialGrid<Frame>::ForTolerance(
+      body,
+      accuracy_parameters_.geopotential_tolerance_,
+      inner_radius,
+      outer_radius,
+      geopotential_grid_max_nodes);
+}
+
 template<typename Frame>
 double Ephemeris<Frame>::ToleranceToErrorRatio(
     Length const& length_integration_tolerance,
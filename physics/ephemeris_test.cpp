@@ -1,5 +1,6 @@
 #include "physics/ephemeris.hpp"
 
+#include <cmath>
 #include <limits>
 #include <map>
 #include <optional>
@@ -1156,6 +1157,152 @@ TEST_P(EphemerisTest, ComputeGravitationalPotential) {
   }
 }
 
+TEST_P(EphemerisTest, EvaluateAll) {
+  auto ephemeris = solar_system_.MakeEphemeris(
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<ICRS>::FixedStepParameters(integrator(),
+                                           /*step=*/10 * Minute));
+  EXPECT_OK(ephemeris->Prolong(t0_ + 1 * Day));
+
+  auto const& bodies = ephemeris->bodies();
+  for (Instant t = t0_; t <= ephemeris->t_max(); t += 17 * Minute) {
+    std::vector<Position<ICRS>> const positions =
+        ephemeris->EvaluateAllPositions(t);
+    std::vector<DegreesOfFreedom<ICRS>> const degrees_of_freedom =
+        ephemeris->EvaluateAllDegreesOfFreedom(t);
+    ASSERT_EQ(bodies.size(), positions.size());
+    ASSERT_EQ(bodies.size(), degrees_of_freedom.size());
+    for (int i = 0; i < bodies.size(); ++i) {
+      auto const trajectory = ephemeris->trajectory(bodies[i]);
+      EXPECT_EQ(trajectory->EvaluatePosition(t), positions[i]) << i;
+      EXPECT_EQ(trajectory->EvaluateDegreesOfFreedom(t),
+                degrees_of_freedom[i]) << i;
+    }
+    // The second evaluation at the same time hits the cache.
+    auto const statistics = ephemeris->body_positions_cache_statistics();
+    EXPECT_EQ(positions, ephemeris->EvaluateAllPositions(t));
+    EXPECT_EQ(statistics.hits + 1,
+              ephemeris->body_positions_cache_statistics().hits);
+    EXPECT_EQ(statistics.misses,
+              ephemeris->body_positions_cache_statistics().misses);
+  }
+}
+
+TEST_P(EphemerisTest, ConcurrentAccelerations) {
+  // The solar system has fewer bodies than the default threshold, so the first
+  // ephemeris computes the accelerations sequentially, while the other two
+  // compute them concurrently.
+  std::vector<not_null<std::unique_ptr<Ephemeris<ICRS>>>> ephemerides;
+  for (int i = 0; i < 3; ++i) {
+    ephemerides.push_back(solar_system_.MakeEphemeris(
+        /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
+                                 /*geopotential_tolerance=*/0x1p-24},
+        Ephemeris<ICRS>::FixedStepParameters(integrator(),
+                                             /*step=*/10 * Minute)));
+  }
+  ephemerides[1]->SetConcurrencyThreshold(0);
+  ephemerides[2]->SetConcurrencyThreshold(0);
+  for (auto const& ephemeris : ephemerides) {
+    EXPECT_OK(ephemeris->Prolong(t0_ + 10 * Day));
+  }
+
+  Instant const t = t0_ + 10 * Day;
+  std::vector<Position<ICRS>> const sequential_positions =
+      ephemerides[0]->EvaluateAllPositions(t);
+  std::vector<Position<ICRS>> const concurrent_positions =
+      ephemerides[1]->EvaluateAllPositions(t);
+  // The concurrent computation is deterministic.
+  EXPECT_EQ(concurrent_positions, ephemerides[2]->EvaluateAllPositions(t));
+  // It only differs from the sequential one by the order of the summations.
+  for (int i = 0; i < sequential_positions.size(); ++i) {
+    EXPECT_THAT(AbsoluteError(sequential_positions[i],
+                              concurrent_positions[i]),
+                Lt(1 * Metre)) << ephemerides[0]->bodies()[i]->name();
+  }
+}
+
+// A Sun with a belt of massive asteroids, integrated with the Barnes-Hut
+// approximation and exactly.
+TEST_P(EphemerisTest, OpeningAngle) {
+  int const number_of_asteroids = 100;
+  double const opening_angle = 0.5;
+  auto const make_ephemeris = [this](double const opening_angle) {
+    std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+    std::vector<DegreesOfFreedom<ICRS>> initial_state;
+    bodies.push_back(make_not_null_unique<MassiveBody>(
+        MassiveBody::Parameters(SolarGravitationalParameter)));
+    initial_state.emplace_back(ICRS::origin, ICRS::unmoving);
+    for (int i = 0; i < number_of_asteroids; ++i) {
+      // Spread the asteroids using the golden angle, at radii between 2.2 and
+      // 3.2 ua, with a mass similar to that of Vesta.
+      Angle const θ = i * π * (3 - std::sqrt(5.0)) * Radian;
+      Length const r =
+          (2.2 + static_cast<double>(i) / number_of_asteroids) *
+          AstronomicalUnit;
+      Speed const v = Sqrt(SolarGravitationalParameter / r);
+      bodies.push_back(make_not_null_unique<MassiveBody>(
+          MassiveBody::Parameters(1e-10 * SolarGravitationalParameter)));
+      initial_state.emplace_back(
+          ICRS::origin +
+              Displacement<ICRS>({r * Cos(θ), r * Sin(θ), 0 * Metre}),
+          Velocity<ICRS>({-v * Sin(θ), v * Cos(θ), 0 * Metre / Second}));
+    }
+    return make_not_null_unique<Ephemeris<ICRS>>(
+        std::move(bodies),
+        initial_state,
+        t0_,
+        Ephemeris<ICRS>::AccuracyParameters(
+            /*fitting_tolerance=*/1 * Metre,
+            /*geopotential_tolerance=*/0x1p-24,
+            opening_angle),
+        Ephemeris<ICRS>::FixedStepParameters(integrator(),
+                                             /*step=*/1 * Day));
+  };
+
+  auto const exact_ephemeris = make_ephemeris(/*opening_angle=*/0);
+  auto const approximate_ephemeris = make_ephemeris(opening_angle);
+  Instant const t = t0_ + 1 * JulianYear;
+  EXPECT_OK(exact_ephemeris->Prolong(t));
+  EXPECT_OK(approximate_ephemeris->Prolong(t));
+
+  // The approximation is used, but the trajectories are close to the exact
+  // ones.
+  std::vector<Position<ICRS>> const exact_positions =
+      exact_ephemeris->EvaluateAllPositions(t);
+  std::vector<Position<ICRS>> const approximate_positions =
+      approximate_ephemeris->EvaluateAllPositions(t);
+  EXPECT_NE(exact_positions, approximate_positions);
+  for (int i = 0; i < exact_positions.size(); ++i) {
+    EXPECT_THAT(AbsoluteError(exact_positions[i], approximate_positions[i]),
+                Lt(10 * Kilo(Metre))) << i;
+  }
+
+  // The opening angle is serialized, and the deserialized ephemeris is
+  // prolonged with the same approximation.
+  serialization::Ephemeris message;
+  approximate_ephemeris->WriteToMessage(&message);
+  EXPECT_EQ(opening_angle, message.accuracy_parameters().opening_angle());
+  auto const ephemeris_read = Ephemeris<ICRS>::ReadFromMessage(
+      /*desired_t_min=*/InfiniteFuture,
+      message);
+  serialization::Ephemeris second_message;
+  ephemeris_read->WriteToMessage(&second_message);
+  EXPECT_THAT(message, EqualsProto(second_message));
+
+  Instant const t_max = approximate_ephemeris->t_max();
+  EXPECT_OK(ephemeris_read->Prolong(t_max));
+  EXPECT_OK(approximate_ephemeris->Prolong(t_max + 10 * Day));
+  EXPECT_OK(ephemeris_read->Prolong(t_max + 10 * Day));
+  EXPECT_EQ(approximate_ephemeris->EvaluateAllPositions(t_max + 10 * Day),
+            ephemeris_read->EvaluateAllPositions(t_max + 10 * Day));
+
+  // Without an opening angle the field is absent.
+  serialization::Ephemeris exact_message;
+  exact_ephemeris->WriteToMessage(&exact_message);
+  EXPECT_FALSE(exact_message.accuracy_parameters().has_opening_angle());
+}
+
 TEST_P(EphemerisTest, ComputeApsidesContinuousTrajectory) {
   SolarSystem<ICRS> solar_system(
       SOLUTION_DIR / "astronomy" / "test_gravity_model_two_bodies.proto.txt",
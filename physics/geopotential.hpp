@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "base/not_null.hpp"
@@ -46,6 +47,20 @@ class Geopotential {
       Square<Length> const& r²,
       Exponentiation<Length, -3> const& one_over_r³) const;
 
+  // Same as above for a batch of displacements |r| at the same time |t|.  The
+  // orientation of the body is only computed once.  The displacements that use
+  // the same harmonics are evaluated |batch_lanes| at a time, with the
+  // recurrences for the longitude terms and the Legendre functions computed on
+  // a structure-of-arrays representation so that they are vectorized across
+  // the displacements.  The result agrees with the above function to a few
+  // ULPs, the difference coming from the order of the summations.  On return,
+  // |accelerations| has the same size as |r|.
+  void GeneralSphericalHarmonicsAccelerations(
+      Instant const& t,
+      std::vector<Displacement<Frame>> const& r,
+      std::vector<Vector<Quotient<Acceleration, GravitationalParameter>,
+                         Frame>>& accelerations) const;
+
   Quotient<SpecificEnergy, GravitationalParameter>
   GeneralSphericalHarmonicsPotential(
       Instant const& t,
@@ -76,9 +91,24 @@ class Geopotential {
 
   using UnitVector = Vector<double, Frame>;
 
+  // The equatorial axes of the body used to compute the longitude.  In the
+  // zonal case they may be any pair of orthogonal equatorial vectors.
+  struct EquatorialAxes {
+    UnitVector x̂;
+    UnitVector ŷ;
+  };
+
   // Holds precomputed data for one evaluation of the acceleration.
   struct Precomputations;
 
+  // The number of displacements evaluated together by
+  // |GeneralSphericalHarmonicsAccelerations|.
+  static constexpr int batch_lanes = 8;
+
+  // Holds precomputed data for the evaluation of the acceleration at
+  // |batch_lanes| displacements, in structure-of-arrays form.
+  struct BatchPrecomputations;
+
   // Helper templates for iterating over the degrees/orders of the geopotential.
   template<int degree, int order>
   class DegreeNOrderM;
@@ -94,6 +124,36 @@ class Geopotential {
   // |degree_damping_[1].outer_threshold()| are infinite, |limiting_degree > 1|.
   int LimitingDegree(Length const& r_norm) const;
 
+  // True if only the zonal harmonics contribute at distance |r_norm|.
+  bool IsZonal(Length const& r_norm) const;
+
+  // The axes to use in the zonal case, which don't depend on time, and the
+  // axes of the surface frame at time |t|, which are expensive to compute.
+  EquatorialAxes ZonalAxes() const;
+  EquatorialAxes SurfaceAxes(Instant const& t) const;
+
+  // The implementation of |GeneralSphericalHarmonicsAcceleration| for a
+  // non-NaN |r_norm|, with the axes already computed.
+  Vector<ReducedAcceleration, Frame> SphericalHarmonicsAcceleration(
+      EquatorialAxes const& axes,
+      Displacement<Frame> const& r,
+      Length const& r_norm,
+      Square<Length> const& r²,
+      Exponentiation<Length, -3> const& one_over_r³) const;
+
+  // Sets the elements |indices[0, size[| of |accelerations| to the
+  // accelerations at the corresponding elements of |r|, which must all have
+  // the same |max_degree| (greater than 1) and zonality.  |size| must not
+  // exceed |batch_lanes|.
+  void SphericalHarmonicsAccelerationsBatch(
+      EquatorialAxes const& axes,
+      bool is_zonal,
+      int max_degree,
+      std::vector<Displacement<Frame>> const& r,
+      std::int64_t const* indices,
+      int size,
+      std::vector<Vector<ReducedAcceleration, Frame>>& accelerations) const;
+
   not_null<OblateBody<Frame> const*> body_;
 
   // The contribution from the harmonics of degree n is damped by
@@ -3,7 +3,10 @@
 #include "physics/geopotential.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <compare>
+#include <optional>
 #include <queue>
 #include <vector>
 
@@ -16,6 +19,7 @@
 #include "numerics/polynomial_evaluators.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
 
 namespace principia {
 namespace physics {
@@ -32,6 +36,7 @@ using namespace principia::numerics::_polynomial_evaluators;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
 
 // The notation in this file follows documentation/Geopotential.pdf.
 
@@ -71,6 +76,43 @@ struct Geopotential<Frame>::Precomputations {
   FixedLowerTriangularMatrix<double, size> DmPn_of_sin_β{uninitialized};
 };
 
+template<typename Frame>
+struct Geopotential<Frame>::BatchPrecomputations {
+  static constexpr int size = OblateBody<Frame>::max_geopotential_degree + 1;
+
+  // One value per displacement.
+  using Lanes = std::array<double, batch_lanes>;
+  // The coordinates of one vector per displacement.
+  using VectorLanes = std::array<Lanes, 3>;
+
+  // These quantities are independent from n and m.  The vectors are expressed
+  // in the coordinates of |Frame|.
+  Lanes sin_β;
+  Lanes cos_β;
+  VectorLanes grad_𝔅_vector;
+  VectorLanes grad_𝔏_vector;
+
+  // These quantities depend on n but are independent from m.  They are in SI
+  // units.  The sectoral quantities are those of degree 2 damped by
+  // |sectoral_damping_|.
+  std::array<Lanes, size> σℜ_over_r;
+  std::array<VectorLanes, size> grad_σℜ;
+  Lanes sectoral_σℜ_over_r;
+  VectorLanes sectoral_grad_σℜ;
+
+  // These quantities depend on m but are independent from n.
+  std::array<Lanes, size> cos_mλ;  // 0 unused.
+  std::array<Lanes, size> sin_mλ;  // 0 unused.
+  std::array<Lanes, size> cos_β_to_the_m;
+
+  // The rows n - 2, n - 1 and n of DmPn_of_sin_β, with row n stored at index
+  // n % 3.  Only the columns m ≤ n of a row are meaningful.
+  std::array<std::array<Lanes, size>, 3> DmPn_of_sin_β;
+
+  // The result, in SI units.
+  VectorLanes acceleration;
+};
+
 template<typename Frame>
 template<int degree, int order>
 class Geopotential<Frame>::DegreeNOrderM {
@@ -108,7 +150,7 @@ template<int... degrees>
 class Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>> {
  public:
   static auto Acceleration(Geopotential<Frame> const& geopotential,
-                           Instant const& t,
+                           EquatorialAxes const& axes,
                            Displacement<Frame> const& r,
                            Length const& r_norm,
                            Square<Length> const& r²,
@@ -116,7 +158,7 @@ class Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>> {
       -> Vector<ReducedAcceleration, Frame>;
 
   static auto Potential(Geopotential<Frame> const& geopotential,
-                        Instant const& t,
+                        EquatorialAxes const& axes,
                         Displacement<Frame> const& r,
                         Length const& r_norm,
                         Square<Length> const& r²,
@@ -126,7 +168,7 @@ class Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>> {
  private:
   static void InitializePrecomputations(
       Geopotential<Frame> const& geopotential,
-      Instant const& t,
+      EquatorialAxes const& axes,
       Displacement<Frame> const& r,
       Length const& r_norm,
       Square<Length> const& r²,
@@ -509,21 +551,18 @@ template<typename Frame>
 template<int... degrees>
 auto Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>>::
 Acceleration(Geopotential<Frame> const& geopotential,
-             Instant const& t,
+             EquatorialAxes const& axes,
              Displacement<Frame> const& r,
              Length const& r_norm,
              Square<Length> const& r²,
              Exponentiation<Length, -3> const& one_over_r³)
     -> Vector<ReducedAcceleration, Frame> {
   constexpr int size = sizeof...(degrees);
-  OblateBody<Frame> const& body = *geopotential.body_;
-  const bool is_zonal =
-      body.is_zonal() ||
-      r_norm > geopotential.sectoral_damping_.outer_threshold();
+  bool const is_zonal = geopotential.IsZonal(r_norm);
 
   Precomputations precomputations;
   InitializePrecomputations(
-      geopotential, t, r, r_norm, r², one_over_r³, precomputations);
+      geopotential, axes, r, r_norm, r², one_over_r³, precomputations);
 
   // Force the evaluation by increasing degree using an initializer list.  In
   // the zonal case, no point in going beyond order 0.
@@ -546,21 +585,18 @@ template<typename Frame>
 template<int... degrees>
 auto Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>>::
 Potential(Geopotential<Frame> const& geopotential,
-          Instant const& t,
+          EquatorialAxes const& axes,
           Displacement<Frame> const& r,
           Length const& r_norm,
           Square<Length> const& r²,
           Exponentiation<Length, -3> const& one_over_r³)
     -> ReducedPotential {
   constexpr int size = sizeof...(degrees);
-  OblateBody<Frame> const& body = *geopotential.body_;
-  const bool is_zonal =
-      body.is_zonal() ||
-      r_norm > geopotential.sectoral_damping_.outer_threshold();
+  bool const is_zonal = geopotential.IsZonal(r_norm);
 
   Precomputations precomputations;
   InitializePrecomputations(
-      geopotential, t, r, r_norm, r², one_over_r³, precomputations);
+      geopotential, axes, r, r_norm, r², one_over_r³, precomputations);
 
   // Force the evaluation by increasing degree using an initializer list.  In
   // the zonal case, no point in going beyond order 0.
@@ -583,16 +619,13 @@ template<typename Frame>
 template<int... degrees>
 void Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>>::
 InitializePrecomputations(Geopotential<Frame> const& geopotential,
-                          Instant const& t,
+                          EquatorialAxes const& axes,
                           Displacement<Frame> const& r,
                           Length const& r_norm,
                           Square<Length> const& r²,
                           Exponentiation<Length, -3> const& one_over_r³,
                           Precomputations& precomputations) {
   OblateBody<Frame> const& body = *geopotential.body_;
-  const bool is_zonal =
-      body.is_zonal() ||
-      r_norm > geopotential.sectoral_damping_.outer_threshold();
 
   precomputations.r_norm = r_norm;
   precomputations.r² = r²;
@@ -616,20 +649,9 @@ InitializePrecomputations(Geopotential<Frame> const& geopotential,
 
   auto& DmPn_of_sin_β = precomputations.DmPn_of_sin_β;
 
-  // In the zonal case the rotation of the body is of no importance, so any pair
-  // of equatorial vectors will do.
-  UnitVector x̂;
-  UnitVector ŷ;
+  UnitVector const& x̂ = axes.x̂;
+  UnitVector const& ŷ = axes.ŷ;
   UnitVector const ẑ = body.polar_axis();
-  if (is_zonal) {
-    x̂ = body.equatorial();
-    ŷ = body.biequatorial();
-  } else {
-    auto const from_surface_frame =
-      body.template FromSurfaceFrame<SurfaceFrame>(t);
-    x̂ = from_surface_frame(x_);
-    ŷ = from_surface_frame(y_);
-  }
 
   Length const x = InnerProduct(r, x̂);
   Length const y = InnerProduct(r, ŷ);
@@ -742,7 +764,7 @@ Geopotential<Frame>::Geopotential(not_null<OblateBody<Frame> const*> body,
 #define PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(d)                     \
   case (d):                                                                    \
     return AllDegrees<std::make_integer_sequence<int, (d) + 1>>::Acceleration( \
-        *this, t, r, r_norm, r², one_over_r³)
+        *this, axes, r, r_norm, r², one_over_r³)
 
 template<typename Frame>
 Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
@@ -757,6 +779,378 @@ Geopotential<Frame>::GeneralSphericalHarmonicsAcceleration(
     // |r_norm| when finding the partition point below.
     return NaN<ReducedAcceleration> * Vector<double, Frame>{};
   }
+  return SphericalHarmonicsAcceleration(
+      IsZonal(r_norm) ? ZonalAxes() : SurfaceAxes(t),
+      r, r_norm, r², one_over_r³);
+}
+
+template<typename Frame>
+void Geopotential<Frame>::GeneralSphericalHarmonicsAccelerations(
+    Instant const& t,
+    std::vector<Displacement<Frame>> const& r,
+    std::vector<Vector<Quotient<Acceleration, GravitationalParameter>,
+                       Frame>>& accelerations) const {
+  accelerations.resize(r.size());
+
+  // The displacements are sorted by the harmonics that they use, i.e., by
+  // maximal degree and zonality, so that each batch evaluates the same
+  // recurrences for all its lanes.  This function may be called concurrently,
+  // hence the thread-local storage.
+  struct Key {
+    int max_degree;
+    bool is_zonal;
+    auto operator<=>(Key const&) const = default;
+  };
+  thread_local std::vector<Key> keys;
+  thread_local std::vector<std::int64_t> indices;
+  keys.resize(r.size());
+  indices.clear();
+  bool needs_surface_axes = false;
+  for (std::int64_t i = 0; i < r.size(); ++i) {
+    Length const r_norm = r[i].Norm();
+    if (r_norm != r_norm) {
+      accelerations[i] = NaN<ReducedAcceleration> * Vector<double, Frame>{};
+      continue;
+    }
+    // We have |max_degree > 0|.
+    int const max_degree = LimitingDegree(r_norm) - 1;
+    if (max_degree == 1) {
+      accelerations[i] = Vector<ReducedAcceleration, Frame>{};
+      continue;
+    }
+    keys[i] = {max_degree, IsZonal(r_norm)};
+    needs_surface_axes |= !keys[i].is_zonal;
+    indices.push_back(i);
+  }
+  std::sort(indices.begin(),
+            indices.end(),
+            [](std::int64_t const left, std::int64_t const right) {
+              return keys[left] < keys[right];
+            });
+
+  EquatorialAxes const zonal_axes = ZonalAxes();
+  std::optional<EquatorialAxes> surface_axes;
+  if (needs_surface_axes) {
+    surface_axes = SurfaceAxes(t);
+  }
+  for (std::int64_t begin = 0; begin < indices.size();) {
+    Key const& key = keys[indices[begin]];
+    std::int64_t end = begin + 1;
+    while (end < indices.size() && end - begin < batch_lanes &&
+           keys[indices[end]] == key) {
+      ++end;
+    }
+    EquatorialAxes const& axes = key.is_zonal ? zonal_axes : *surface_axes;
+    if (end - begin == 1) {
+      // Not worth filling the lanes for a single displacement.
+      std::int64_t const i = indices[begin];
+      Square<Length> const r² = r[i].Norm²();
+      Length const r_norm = Sqrt(r²);
+      Exponentiation<Length, -3> const one_over_r³ = r_norm / (r² * r²);
+      accelerations[i] =
+          SphericalHarmonicsAcceleration(axes, r[i], r_norm, r², one_over_r³);
+    } else {
+      SphericalHarmonicsAccelerationsBatch(axes,
+                                           key.is_zonal,
+                                           key.max_degree,
+                                           r,
+                                           &indices[begin],
+                                           end - begin,
+                                           accelerations);
+    }
+    begin = end;
+  }
+}
+
+template<typename Frame>
+void Geopotential<Frame>::SphericalHarmonicsAccelerationsBatch(
+    EquatorialAxes const& axes,
+    bool const is_zonal,
+    int const max_degree,
+    std::vector<Displacement<Frame>> const& r,
+    std::int64_t const* const indices,
+    int const size,
+    std::vector<Vector<ReducedAcceleration, Frame>>& accelerations) const {
+  using Lanes = typename BatchPrecomputations::Lanes;
+  using VectorLanes = typename BatchPrecomputations::VectorLanes;
+  using LegendreRow = std::array<Lanes, BatchPrecomputations::size>;
+  constexpr int L = batch_lanes;
+  if (max_degree >= BatchPrecomputations::size) {
+    LOG(FATAL) << "Unexpected degree " << max_degree << " " << body_->name();
+  }
+
+  // Too large for the stack of some of the threads that call us.
+  thread_local BatchPrecomputations precomputations;
+  auto& sin_β = precomputations.sin_β;
+  auto& cos_β = precomputations.cos_β;
+  auto& grad_𝔅_vector = precomputations.grad_𝔅_vector;
+  auto& grad_𝔏_vector = precomputations.grad_𝔏_vector;
+  auto& σℜ_over_r = precomputations.σℜ_over_r;
+  auto& grad_σℜ = precomputations.grad_σℜ;
+  auto& cos_mλ = precomputations.cos_mλ;
+  auto& sin_mλ = precomputations.sin_mλ;
+  auto& cos_β_to_the_m = precomputations.cos_β_to_the_m;
+  auto& acceleration = precomputations.acceleration;
+
+  OblateBody<Frame> const& body = *body_;
+  auto const& cos = body.cos();
+  auto const& sin = body.sin();
+  UnitVector const& x̂ = axes.x̂;
+  UnitVector const& ŷ = axes.ŷ;
+  UnitVector const ẑ = body.polar_axis();
+
+  // The quantities that depend on the radius are computed one displacement at
+  // a time as in |InitializePrecomputations| and
+  // |DegreeNAllOrders::Acceleration|, since the damping has branches.  The
+  // lanes beyond |size| repeat the last displacement, their results are
+  // discarded.
+  for (int l = 0; l < L; ++l) {
+    Displacement<Frame> const& rl = r[indices[std::min(l, size - 1)]];
+    Square<Length> const r² = rl.Norm²();
+    Length const r_norm = Sqrt(r²);
+    Exponentiation<Length, -3> const one_over_r³ = r_norm / (r² * r²);
+
+    Length const x = InnerProduct(rl, x̂);
+    Length const y = InnerProduct(rl, ŷ);
+    Length const z = InnerProduct(rl, ẑ);
+
+    Square<Length> const x²_plus_y² = x * x + y * y;
+    Length const r_equatorial = Sqrt(x²_plus_y²);
+
+    double cos_λ = 1;
+    double sin_λ = 0;
+    if (r_equatorial > Length{}) {
+      Inverse<Length> const one_over_r_equatorial = 1 / r_equatorial;
+      cos_λ = x * one_over_r_equatorial;
+      sin_λ = y * one_over_r_equatorial;
+    }
+
+    Inverse<Length> const one_over_r_norm = 1 / r_norm;
+    Vector<double, Frame> const r_normalized = rl * one_over_r_norm;
+
+    cos_β[l] = r_equatorial * one_over_r_norm;
+    sin_β[l] = z * one_over_r_norm;
+    cos_mλ[1][l] = cos_λ;
+    sin_mλ[1][l] = sin_λ;
+
+    auto const grad_𝔅 =
+        ((-sin_β[l] * cos_λ) * x̂ - (sin_β[l] * sin_λ) * ŷ + cos_β[l] * ẑ)
+            .coordinates();
+    auto const grad_𝔏 = (cos_λ * ŷ - sin_λ * x̂).coordinates();
+    grad_𝔅_vector[0][l] = grad_𝔅.x;
+    grad_𝔅_vector[1][l] = grad_𝔅.y;
+    grad_𝔅_vector[2][l] = grad_𝔅.z;
+    grad_𝔏_vector[0][l] = grad_𝔏.x;
+    grad_𝔏_vector[1][l] = grad_𝔏.y;
+    grad_𝔏_vector[2][l] = grad_𝔏.z;
+
+    FixedVector<Inverse<Square<Length>>, BatchPrecomputations::size>
+        ℜ_over_r{uninitialized};
+    ℜ_over_r[1] = body.reference_radius() * one_over_r³;
+    auto const store = [l](Inverse<Square<Length>> const& σℜ_over_r_n,
+                           Vector<Inverse<Square<Length>>, Frame> const&
+                               grad_σℜ_n,
+                           double& σℜ_over_r_lane,
+                           VectorLanes& grad_σℜ_lanes) {
+      constexpr auto unit = si::Unit<Inverse<Square<Length>>>;
+      auto const& coordinates = grad_σℜ_n.coordinates();
+      σℜ_over_r_lane = σℜ_over_r_n / unit;
+      grad_σℜ_lanes[0][l] = coordinates.x / unit;
+      grad_σℜ_lanes[1][l] = coordinates.y / unit;
+      grad_σℜ_lanes[2][l] = coordinates.z / unit;
+    };
+    for (int n = 2; n <= max_degree; ++n) {
+      int const h1 = n / 2;
+      int const h2 = n - h1;
+      ℜ_over_r[n] = ℜ_over_r[h1] * ℜ_over_r[h2] * r²;
+      auto const ℜʹ = -(n + 1) * ℜ_over_r[n];
+      Inverse<Square<Length>> σℜ_over_r_n;
+      Vector<Inverse<Square<Length>>, Frame> grad_σℜ_n;
+      degree_damping_[n].ComputeDampedRadialQuantities(r_norm,
+                                                       r²,
+                                                       r_normalized,
+                                                       ℜ_over_r[n],
+                                                       ℜʹ,
+                                                       σℜ_over_r_n,
+                                                       grad_σℜ_n);
+      store(σℜ_over_r_n, grad_σℜ_n, σℜ_over_r[n][l], grad_σℜ[n]);
+      if (n == 2 && !is_zonal) {
+        sectoral_damping_.ComputeDampedRadialQuantities(r_norm,
+                                                        r²,
+                                                        r_normalized,
+                                                        ℜ_over_r[n],
+                                                        ℜʹ,
+                                                        σℜ_over_r_n,
+                                                        grad_σℜ_n);
+        store(σℜ_over_r_n,
+              grad_σℜ_n,
+              precomputations.sectoral_σℜ_over_r[l],
+              precomputations.sectoral_grad_σℜ);
+      }
+    }
+  }
+
+  // From here on, the loops over the lanes have no branches and no
+  // dependencies between iterations, so they are vectorized.  The recurrences
+  // are the ones of |DegreeNOrderM::UpdatePrecomputations|.
+  int const max_order = is_zonal ? 0 : max_degree;
+  for (int l = 0; l < L; ++l) {
+    cos_β_to_the_m[0][l] = 1;
+    cos_β_to_the_m[1][l] = cos_β[l];
+  }
+  for (int m = 2; m <= max_order; ++m) {
+    // Compute the values for m * λ based on the values around m/2 * λ to
+    // reduce error accumulation.
+    int const h1 = m / 2;
+    int const h2 = m - h1;
+    if (h1 == h2) {
+      for (int l = 0; l < L; ++l) {
+        double const cos_hλ = cos_mλ[h1][l];
+        double const sin_hλ = sin_mλ[h1][l];
+        double const cos_β_to_the_h = cos_β_to_the_m[h1][l];
+        sin_mλ[m][l] = 2 * sin_hλ * cos_hλ;
+        cos_mλ[m][l] = (cos_hλ + sin_hλ) * (cos_hλ - sin_hλ);
+        cos_β_to_the_m[m][l] = cos_β_to_the_h * cos_β_to_the_h;
+      }
+    } else {
+      for (int l = 0; l < L; ++l) {
+        double const cos_h1λ = cos_mλ[h1][l];
+        double const sin_h1λ = sin_mλ[h1][l];
+        double const cos_h2λ = cos_mλ[h2][l];
+        double const sin_h2λ = sin_mλ[h2][l];
+        sin_mλ[m][l] = sin_h1λ * cos_h2λ + cos_h1λ * sin_h2λ;
+        cos_mλ[m][l] = cos_h1λ * cos_h2λ - sin_h1λ * sin_h2λ;
+        cos_β_to_the_m[m][l] = cos_β_to_the_m[h1][l] * cos_β_to_the_m[h2][l];
+      }
+    }
+  }
+
+  auto& DmPn_of_sin_β = precomputations.DmPn_of_sin_β;
+  for (int l = 0; l < L; ++l) {
+    DmPn_of_sin_β[0][0][l] = 1;
+    DmPn_of_sin_β[1][0][l] = sin_β[l];
+    DmPn_of_sin_β[1][1][l] = 1;
+  }
+  for (auto& coordinate : acceleration) {
+    coordinate.fill(0);
+  }
+
+  // Adds to |acceleration| the contributions of the orders in
+  // [m_begin, m_end] of degree |n|, whose Legendre functions are in |Pn|.
+  auto const accumulate_orders = [&](int const n,
+                                     int const m_begin,
+                                     int const m_end,
+                                     LegendreRow const& Pn,
+                                     Lanes const& σℜ_over_r_n,
+                                     VectorLanes const& grad_σℜ_n) {
+    // The factors of grad_σℜ, grad_𝔅_vector/σℜ_over_r and
+    // grad_𝔏_vector/σℜ_over_r, summed over the orders.
+    Lanes 𝔅𝔏{};
+    Lanes 𝔏_grad_𝔅{};
+    Lanes 𝔅_grad_𝔏{};
+    for (int m = m_begin; m <= m_end; ++m) {
+      double const normalization_factor = LegendreNormalizationFactor(n, m);
+      double const Cnm = cos(n, m);
+      double const Snm = sin(n, m);
+      for (int l = 0; l < L; ++l) {
+        double const 𝔅 = cos_β_to_the_m[m][l] * Pn[m][l];
+        double grad_𝔅_polynomials = 0;
+        if (m < n) {
+          grad_𝔅_polynomials =
+              cos_β[l] * cos_β_to_the_m[m][l] * Pn[m + 1][l];
+        }
+        double 𝔏 = Cnm;
+        if (m > 0) {
+          double const cos_β_to_the_m_minus_1 = cos_β_to_the_m[m - 1][l];
+          // Remove a singularity when m == 0 and cos_β == 0.
+          grad_𝔅_polynomials -=
+              m * sin_β[l] * cos_β_to_the_m_minus_1 * Pn[m][l];
+          𝔏 = Cnm * cos_mλ[m][l] + Snm * sin_mλ[m][l];
+          // Compensate a cos_β to remove a singularity when cos_β == 0.
+          𝔅_grad_𝔏[l] += normalization_factor *
+                         (cos_β_to_the_m_minus_1 * Pn[m][l] *  // 𝔅/cos_β
+                          m * (Snm * cos_mλ[m][l] - Cnm * sin_mλ[m][l]));
+        }
+        𝔅𝔏[l] += normalization_factor * (𝔅 * 𝔏);
+        𝔏_grad_𝔅[l] += normalization_factor * (𝔏 * grad_𝔅_polynomials);
+      }
+    }
+    for (int i = 0; i < 3; ++i) {
+      for (int l = 0; l < L; ++l) {
+        acceleration[i][l] +=
+            𝔅𝔏[l] * grad_σℜ_n[i][l] +
+            σℜ_over_r_n[l] * (𝔏_grad_𝔅[l] * grad_𝔅_vector[i][l] +
+                              𝔅_grad_𝔏[l] * grad_𝔏_vector[i][l]);
+      }
+    }
+  };
+
+  for (int n = 2; n <= max_degree; ++n) {
+    auto& Pn = DmPn_of_sin_β[n % 3];
+    auto const& Pn_1 = DmPn_of_sin_β[(n - 1) % 3];
+    auto const& Pn_2 = DmPn_of_sin_β[(n - 2) % 3];
+
+    // Recurrence relationship between the Legendre polynomials.
+    for (int l = 0; l < L; ++l) {
+      Pn[0][l] = ((2 * n - 1) * sin_β[l] * Pn_1[0][l] -
+                  (n - 1) * Pn_2[0][l]) /
+                 n;
+    }
+    // Recurrence relationship between the associated Legendre polynomials.
+    // Account for the fact that DmPn_of_sin_β is identically zero if m > n.
+    // In the zonal case, only the order 0 and its derivative are needed.
+    for (int m = 0; m < std::min(n, max_order + 1); ++m) {
+      if (m == n - 1) {
+        for (int l = 0; l < L; ++l) {
+          Pn[m + 1][l] = ((2 * n - 1) * (m + 1) * Pn_1[m][l]) / n;
+        }
+      } else if (m == n - 2) {
+        for (int l = 0; l < L; ++l) {
+          Pn[m + 1][l] = ((2 * n - 1) * (sin_β[l] * Pn_1[m + 1][l] +
+                                         (m + 1) * Pn_1[m][l])) /
+                         n;
+        }
+      } else {
+        for (int l = 0; l < L; ++l) {
+          Pn[m + 1][l] = ((2 * n - 1) * (sin_β[l] * Pn_1[m + 1][l] +
+                                         (m + 1) * Pn_1[m][l]) -
+                          (n - 1) * Pn_2[m + 1][l]) /
+                         n;
+        }
+      }
+    }
+
+    if (n == 2 && !is_zonal) {
+      // J2 is damped by the degree damping, C22 and S22 by the sectoral
+      // damping.  The order 1 is known to be 0.
+      accumulate_orders(n, 0, 0, Pn, σℜ_over_r[n], grad_σℜ[n]);
+      accumulate_orders(n,
+                        2,
+                        2,
+                        Pn,
+                        precomputations.sectoral_σℜ_over_r,
+                        precomputations.sectoral_grad_σℜ);
+    } else {
+      accumulate_orders(n, 0, max_order, Pn, σℜ_over_r[n], grad_σℜ[n]);
+    }
+  }
+
+  for (int l = 0; l < size; ++l) {
+    accelerations[indices[l]] = Vector<ReducedAcceleration, Frame>(
+        {acceleration[0][l] * si::Unit<ReducedAcceleration>,
+         acceleration[1][l] * si::Unit<ReducedAcceleration>,
+         acceleration[2][l] * si::Unit<ReducedAcceleration>});
+  }
+}
+
+template<typename Frame>
+auto Geopotential<Frame>::SphericalHarmonicsAcceleration(
+    EquatorialAxes const& axes,
+    Displacement<Frame> const& r,
+    Length const& r_norm,
+    Square<Length> const& r²,
+    Exponentiation<Length, -3> const& one_over_r³) const
+    -> Vector<ReducedAcceleration, Frame> {
   // We have |max_degree > 0|.
   int const max_degree = LimitingDegree(r_norm) - 1;
   switch (max_degree) {
@@ -824,7 +1218,7 @@ Geopotential<Frame>::GeneralSphericalHarmonicsAcceleration(
 #define PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(d)                     \
   case (d):                                                                 \
     return AllDegrees<std::make_integer_sequence<int, (d) + 1>>::Potential( \
-        *this, t, r, r_norm, r², one_over_r³)
+        *this, axes, r, r_norm, r², one_over_r³)
 
 template<typename Frame>
 Quotient<SpecificEnergy, GravitationalParameter>
@@ -839,6 +1233,7 @@ Geopotential<Frame>::GeneralSphericalHarmonicsPotential(
     // |r_norm| when finding the partition point below.
     return NaN<ReducedPotential>;
   }
+  EquatorialAxes const axes = IsZonal(r_norm) ? ZonalAxes() : SurfaceAxes(t);
   // We have |max_degree > 0|.
   int const max_degree = LimitingDegree(r_norm) - 1;
   switch (max_degree) {
@@ -925,6 +1320,26 @@ int Geopotential<Frame>::LimitingDegree(Length const& r_norm) const {
          degree_damping_.begin();
 }
 
+template<typename Frame>
+bool Geopotential<Frame>::IsZonal(Length const& r_norm) const {
+  return body_->is_zonal() || r_norm > sectoral_damping_.outer_threshold();
+}
+
+template<typename Frame>
+auto Geopotential<Frame>::ZonalAxes() const -> EquatorialAxes {
+  // In the zonal case the rotation of the body is of no importance, so any pair
+  // of equatorial vectors will do.
+  return {body_->equatorial(), body_->biequatorial()};
+}
+
+template<typename Frame>
+auto Geopotential<Frame>::SurfaceAxes(Instant const& t) const
+    -> EquatorialAxes {
+  auto const from_surface_frame =
+      body_->template FromSurfaceFrame<SurfaceFrame>(t);
+  return {from_surface_frame(x_), from_surface_frame(y_)};
+}
+
 template<typename Frame>
 const Vector<double, typename Geopotential<Frame>::SurfaceFrame>
     Geopotential<Frame>::x_({1, 0, 0});
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/rotation.hpp"
+#include "geometry/space.hpp"
+#include "physics/geopotential.hpp"
+#include "physics/oblate_body.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace physics {
+namespace _geopotential_grid {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_frame;
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_rotation;
+using namespace principia::geometry::_space;
+using namespace principia::physics::_geopotential;
+using namespace principia::physics::_oblate_body;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+
+// An approximation of the |Geopotential| of a body in a spherical shell around
+// it, for use when the spherical harmonics are too expensive to evaluate at
+// each step, e.g., for long predictions in low orbit around a body with a
+// high-degree model.  The accelerations are precomputed at construction on a
+// grid in (radius, latitude, longitude) in the surface frame of the body and
+// evaluated by tricubic Lagrange interpolation, which costs 64 table lookups
+// irrespective of the degree of the model.  The latitudes are taken at the
+// centres of the cells so that the stencils may be continued across the poles.
+// Outside of the shell, the geopotential is evaluated exactly.  In the outermost
+// radial cells of the shell the interpolated and exact accelerations are
+// blended so that the acceleration is continuous across the boundaries, which
+// matters to integrators with adaptive steps.
+// The error of the interpolation is not bounded rigorously: it is estimated by
+// sampling the centres of some cells, see |estimated_error|.
+// This class is immutable after construction and is therefore thread-safe.
+template<typename Frame>
+class GeopotentialGrid final {
+ public:
+  // Builds a grid for the geopotential of |body| with the given |tolerance|
+  // covering the shell between |inner_radius| and |outer_radius|.
+  // |longitude_divisions| must be even and at least 4; there are half as many
+  // latitude divisions.  |radial_divisions| must be at least 3.
+  GeopotentialGrid(not_null<OblateBody<Frame> const*> body,
+                   double tolerance,
+                   Length const& inner_radius,
+                   Length const& outer_radius,
+                   int longitude_divisions,
+                   int radial_divisions);
+
+  // Builds a grid whose |estimated_error()| is below |tolerance|, i.e., whose
+  // error is expected to be commensurate with the damping of the geopotential.
+  // The resolution is doubled in all dimensions until that error is reached or
+  // until the grid would have more than |max_nodes| nodes, in which case the
+  // last grid is returned and a warning is logged.  Returns |std::nullopt| if
+  // the initial grid would already have more than |max_nodes| nodes.
+  static std::optional<GeopotentialGrid> ForTolerance(
+      not_null<OblateBody<Frame> const*> body,
+      double tolerance,
+      Length const& inner_radius,
+      Length const& outer_radius,
+      std::int64_t max_nodes);
+
+  // Same contract as the member function of |Geopotential|.
+  Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
+  GeneralSphericalHarmonicsAcceleration(
+      Instant const& t,
+      Displacement<Frame> const& r,
+      Length const& r_norm,
+      Square<Length> const& r²,
+      Exponentiation<Length, -3> const& one_over_r³) const;
+
+  // Same contract as the member function of |Geopotential|.  The orientation
+  // of the body is only computed once for the entire batch.
+  void GeneralSphericalHarmonicsAccelerations(
+      Instant const& t,
+      std::vector<Displacement<Frame>> const& r,
+      std::vector<Vector<Quotient<Acceleration, GravitationalParameter>,
+                         Frame>>& accelerations) const;
+
+  // The largest error of the interpolation found at the centres of a sample of
+  // cells, relative to the central force.  This is an estimate, not a bound:
+  // the error may be larger at points that were not sampled.
+  double estimated_error() const;
+
+  Geopotential<Frame> const& geopotential() const;
+  std::int64_t number_of_nodes() const;
+
+ private:
+  // The frame of the surface of the celestial.
+  using SurfaceFrame = geometry::_frame::Frame<struct SurfaceFrameTag>;
+
+  using ReducedAcceleration = Quotient<Acceleration, GravitationalParameter>;
+
+  // The index of the first node of the stencil in some dimension, and the
+  // weights of the 4 nodes of the stencil.
+  struct Stencil {
+    int first;
+    std::array<double, 4> weights;
+  };
+
+  // The weights of the cubic Lagrange interpolation on the nodes {-1, 0, 1, 2}
+  // at abscissa |f|.
+  static std::array<double, 4> LagrangeWeights(double f);
+
+  // The weight of the interpolated acceleration at distance |r_norm|: 1 in the
+  // interior of the shell, 0 outside of it, and going smoothly from 0 to 1 in
+  // the outermost radial cells.  Returns 0 for NaN.
+  double InterpolationWeight(Length const& r_norm) const;
+
+  Vector<ReducedAcceleration, SurfaceFrame> Interpolate(
+      Displacement<SurfaceFrame> const& r) const;
+
+  // The number of nodes of a grid with the given divisions.
+  static std::int64_t NumberOfNodes(int longitude_divisions,
+                                    int radial_divisions);
+
+  // The number of nodes in each dimension.
+  int latitudes() const;
+  int longitudes() const;
+  int radii() const;
+
+  // The index in |accelerations_| of the first coordinate of the node with the
+  // given indices.
+  std::int64_t NodeIndex(int radius, int latitude, int longitude) const;
+
+  // The position of the point with the given (possibly fractional) indices.
+  Displacement<SurfaceFrame> GridDisplacement(double radius,
+                                              double latitude,
+                                              double longitude) const;
+
+  void ComputeAccelerations();
+  void EstimateError();
+
+  not_null<OblateBody<Frame> const*> body_;
+  Geopotential<Frame> geopotential_;
+
+  Length inner_radius_;
+  Length outer_radius_;
+  int longitude_divisions_;
+  int radial_divisions_;
+  Length radial_step_;
+  double angular_step_;  // In radians.
+
+  // The coordinates of the reduced accelerations in the surface frame, in SI
+  // units, node by node, radius-major and longitude-minor.
+  std::vector<double> accelerations_;
+
+  double estimated_error_ = 0;
+};
+
+}  // namespace internal
+
+using internal::GeopotentialGrid;
+
+}  // namespace _geopotential_grid
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/geopotential_grid_body.hpp"
@@ -0,0 +1,405 @@
+#pragma once
+
+#include "physics/geopotential_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include "geometry/r3_element.hpp"
+#include "glog/logging.h"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/numbers.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace physics {
+namespace _geopotential_grid {
+namespace internal {
+
+using namespace principia::geometry::_r3_element;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_si;
+
+template<typename Frame>
+GeopotentialGrid<Frame>::GeopotentialGrid(
+    not_null<OblateBody<Frame> const*> const body,
+    double const tolerance,
+    Length const& inner_radius,
+    Length const& outer_radius,
+    int const longitude_divisions,
+    int const radial_divisions)
+    : body_(body),
+      geopotential_(body, tolerance),
+      inner_radius_(inner_radius),
+      outer_radius_(outer_radius),
+      longitude_divisions_(longitude_divisions),
+      radial_divisions_(radial_divisions),
+      radial_step_((outer_radius - inner_radius) / radial_divisions),
+      angular_step_(2 * π / longitude_divisions) {
+  CHECK_LT(Length{}, inner_radius);
+  CHECK_LT(inner_radius, outer_radius);
+  CHECK_GE(longitude_divisions, 4);
+  CHECK_EQ(0, longitude_divisions % 2);
+  CHECK_GE(radial_divisions, 3);
+  ComputeAccelerations();
+  EstimateError();
+}
+
+template<typename Frame>
+std::optional<GeopotentialGrid<Frame>> GeopotentialGrid<Frame>::ForTolerance(
+    not_null<OblateBody<Frame> const*> const body,
+    double const tolerance,
+    Length const& inner_radius,
+    Length const& outer_radius,
+    std::int64_t const max_nodes) {
+  // Start with 4 nodes per wavelength of the highest harmonic, and radial
+  // cells about as thick as the angular cells are wide at |inner_radius|.
+  int longitude_divisions = 4 * (body->geopotential_degree() + 1);
+  Length const initial_cell_width =
+      inner_radius * 2 * π / longitude_divisions;
+  int radial_divisions = std::max(
+      3,
+      static_cast<int>(
+          std::ceil((outer_radius - inner_radius) / initial_cell_width)));
+  // Don't spend the time to compute the initial grid if it's too large.
+  if (NumberOfNodes(longitude_divisions, radial_divisions) > max_nodes) {
+    LOG(WARNING) << "Geopotential grid for " << body->name() << " would have "
+                 << NumberOfNodes(longitude_divisions, radial_divisions)
+                 << " nodes, more than " << max_nodes;
+    return std::nullopt;
+  }
+  for (;;) {
+    GeopotentialGrid grid(body,
+                          tolerance,
+                          inner_radius,
+                          outer_radius,
+                          longitude_divisions,
+                          radial_divisions);
+    if (grid.estimated_error() <= tolerance) {
+      return grid;
+    }
+    longitude_divisions *= 2;
+    radial_divisions *= 2;
+    if (NumberOfNodes(longitude_divisions, radial_divisions) > max_nodes) {
+      LOG(WARNING) << "Geopotential grid for " << body->name()
+                   << " has an estimated error of " << grid.estimated_error()
+                   << " above the tolerance " << tolerance << " with "
+                   << grid.number_of_nodes() << " nodes";
+      return grid;
+    }
+  }
+}
+
+template<typename Frame>
+Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
+GeopotentialGrid<Frame>::GeneralSphericalHarmonicsAcceleration(
+    Instant const& t,
+    Displacement<Frame> const& r,
+    Length const& r_norm,
+    Square<Length> const& r²,
+    Exponentiation<Length, -3> const& one_over_r³) const {
+  double const weight = InterpolationWeight(r_norm);
+  if (weight == 0) {
+    return geopotential_.GeneralSphericalHarmonicsAcceleration(
+        t, r, r_norm, r², one_over_r³);
+  }
+  auto const from_surface_frame =
+      body_->template FromSurfaceFrame<SurfaceFrame>(t);
+  auto const interpolated =
+      from_surface_frame(Interpolate(from_surface_frame.Inverse()(r)));
+  if (weight == 1) {
+    return interpolated;
+  }
+  auto const exact = geopotential_.GeneralSphericalHarmonicsAcceleration(
+      t, r, r_norm, r², one_over_r³);
+  return exact + weight * (interpolated - exact);
+}
+
+template<typename Frame>
+void GeopotentialGrid<Frame>::GeneralSphericalHarmonicsAccelerations(
+    Instant const& t,
+    std::vector<Displacement<Frame>> const& r,
+    std::vector<Vector<ReducedAcceleration, Frame>>& accelerations) const {
+  accelerations.resize(r.size());
+  // The displacements that need the exact acceleration, i.e., those outside of
+  // the shell or in its outermost cells, are handed to the geopotential in one
+  // batch.  This function may be called concurrently, hence the thread-local
+  // storage.
+  thread_local std::vector<std::size_t> exact_indices;
+  thread_local std::vector<double> exact_weights;
+  thread_local std::vector<Displacement<Frame>> exact_displacements;
+  thread_local std::vector<Vector<ReducedAcceleration, Frame>>
+      exact_accelerations;
+  exact_indices.clear();
+  exact_weights.clear();
+  exact_displacements.clear();
+
+  // Only computed if some displacement is in the shell.
+  std::optional<Rotation<SurfaceFrame, Frame>> from_surface_frame;
+  std::optional<Rotation<Frame, SurfaceFrame>> to_surface_frame;
+  for (std::size_t i = 0; i < r.size(); ++i) {
+    double const weight = InterpolationWeight(r[i].Norm());
+    if (weight > 0) {
+      if (!from_surface_frame.has_value()) {
+        from_surface_frame.emplace(
+            body_->template FromSurfaceFrame<SurfaceFrame>(t));
+        to_surface_frame.emplace(from_surface_frame->Inverse());
+      }
+      accelerations[i] =
+          (*from_surface_frame)(Interpolate((*to_surface_frame)(r[i])));
+    }
+    if (weight < 1) {
+      exact_indices.push_back(i);
+      exact_weights.push_back(weight);
+      exact_displacements.push_back(r[i]);
+    }
+  }
+
+  if (!exact_indices.empty()) {
+    geopotential_.GeneralSphericalHarmonicsAccelerations(
+        t, exact_displacements, exact_accelerations);
+    for (std::size_t j = 0; j < exact_indices.size(); ++j) {
+      auto& acceleration = accelerations[exact_indices[j]];
+      auto const& exact = exact_accelerations[j];
+      double const weight = exact_weights[j];
+      acceleration =
+          weight == 0 ? exact : exact + weight * (acceleration - exact);
+    }
+  }
+}
+
+template<typename Frame>
+double GeopotentialGrid<Frame>::estimated_error() const {
+  return estimated_error_;
+}
+
+template<typename Frame>
+Geopotential<Frame> const& GeopotentialGrid<Frame>::geopotential() const {
+  return geopotential_;
+}
+
+template<typename Frame>
+std::int64_t GeopotentialGrid<Frame>::number_of_nodes() const {
+  return NumberOfNodes(longitude_divisions_, radial_divisions_);
+}
+
+template<typename Frame>
+std::int64_t GeopotentialGrid<Frame>::NumberOfNodes(
+    int const longitude_divisions,
+    int const radial_divisions) {
+  return static_cast<std::int64_t>(radial_divisions + 1) *
+         (longitude_divisions / 2) * longitude_divisions;
+}
+
+template<typename Frame>
+std::array<double, 4> GeopotentialGrid<Frame>::LagrangeWeights(
+    double const f) {
+  double const f_plus_1 = f + 1;
+  double const f_minus_1 = f - 1;
+  double const f_minus_2 = f - 2;
+  return {-f * f_minus_1 * f_minus_2 / 6,
+          f_plus_1 * f_minus_1 * f_minus_2 / 2,
+          -f_plus_1 * f * f_minus_2 / 2,
+          f_plus_1 * f * f_minus_1 / 6};
+}
+
+template<typename Frame>
+double GeopotentialGrid<Frame>::InterpolationWeight(
+    Length const& r_norm) const {
+  // The distance to the closest boundary, in radial cells.  Note that the
+  // comparison is false for NaN, which is handled by the geopotential.
+  double const cells =
+      std::min(r_norm - inner_radius_, outer_radius_ - r_norm) / radial_step_;
+  if (!(cells > 0)) {
+    return 0;
+  } else if (cells >= 1) {
+    return 1;
+  } else {
+    // A smoothstep, so that the weight has a continuous derivative.
+    return cells * cells * (3 - 2 * cells);
+  }
+}
+
+template<typename Frame>
+auto GeopotentialGrid<Frame>::Interpolate(
+    Displacement<SurfaceFrame> const& r) const
+    -> Vector<ReducedAcceleration, SurfaceFrame> {
+  auto const& coordinates = r.coordinates();
+  Length const r_equatorial = Sqrt(Pow<2>(coordinates.x) +
+                                   Pow<2>(coordinates.y));
+  double const β = ArcTan(coordinates.z, r_equatorial) / Radian;
+  double const λ = ArcTan(coordinates.y, coordinates.x) / Radian;
+
+  // The radial stencil is shifted near the boundaries of the shell so that it
+  // doesn't extend beyond them.
+  double const radial_index = (r.Norm() - inner_radius_) / radial_step_;
+  int const radial_cell = std::clamp(
+      static_cast<int>(std::floor(radial_index)), 1, radial_divisions_ - 2);
+  Stencil const radial{radial_cell - 1,
+                       LagrangeWeights(radial_index - radial_cell)};
+
+  // The latitude stencil may extend across the poles, see below.
+  double const latitude_index = (β + π / 2) / angular_step_ - 0.5;
+  int const latitude_cell = std::clamp(
+      static_cast<int>(std::floor(latitude_index)), -1, latitudes() - 1);
+  Stencil const latitude{latitude_cell - 1,
+                         LagrangeWeights(latitude_index - latitude_cell)};
+
+  double const longitude_index = (λ + π) / angular_step_;
+  int const longitude_cell = std::clamp(
+      static_cast<int>(std::floor(longitude_index)), 0, longitudes() - 1);
+  Stencil const longitude{longitude_cell - 1,
+                          LagrangeWeights(longitude_index - longitude_cell)};
+
+  double x = 0;
+  double y = 0;
+  double z = 0;
+  for (int a = 0; a < 4; ++a) {
+    int const i = radial.first + a;
+    for (int b = 0; b < 4; ++b) {
+      // A node beyond a pole is the node on the other side of the pole at the
+      // opposite longitude.
+      int j = latitude.first + b;
+      int longitude_shift = 0;
+      if (j < 0) {
+        j = -1 - j;
+        longitude_shift = longitudes() / 2;
+      } else if (j >= latitudes()) {
+        j = 2 * latitudes() - 1 - j;
+        longitude_shift = longitudes() / 2;
+      }
+      double const radial_latitude_weight =
+          radial.weights[a] * latitude.weights[b];
+      for (int c = 0; c < 4; ++c) {
+        int const k = (longitude.first + c + longitude_shift + longitudes()) %
+                      longitudes();
+        double const weight = radial_latitude_weight * longitude.weights[c];
+        double const* const node = &accelerations_[NodeIndex(i, j, k)];
+        x += weight * node[0];
+        y += weight * node[1];
+        z += weight * node[2];
+      }
+    }
+  }
+  return Vector<ReducedAcceleration, SurfaceFrame>(
+      {x * si::Unit<ReducedAcceleration>,
+       y * si::Unit<ReducedAcceleration>,
+       z * si::Unit<ReducedAcceleration>});
+}
+
+template<typename Frame>
+int GeopotentialGrid<Frame>::latitudes() const {
+  return longitude_divisions_ / 2;
+}
+
+template<typename Frame>
+int GeopotentialGrid<Frame>::longitudes() const {
+  return longitude_divisions_;
+}
+
+template<typename Frame>
+int GeopotentialGrid<Frame>::radii() const {
+  return radial_divisions_ + 1;
+}
+
+template<typename Frame>
+std::int64_t GeopotentialGrid<Frame>::NodeIndex(int const radius,
+                                                int const latitude,
+                                                int const longitude) const {
+  return 3 * ((static_cast<std::int64_t>(radius) * latitudes() + latitude) *
+                  longitudes() +
+              longitude);
+}
+
+template<typename Frame>
+auto GeopotentialGrid<Frame>::GridDisplacement(double const radius,
+                                               double const latitude,
+                                               double const longitude) const
+    -> Displacement<SurfaceFrame> {
+  return Displacement<SurfaceFrame>(
+      RadiusLatitudeLongitude(
+          inner_radius_ + radius * radial_step_,
+          (-π / 2 + (latitude + 0.5) * angular_step_) * Radian,
+          (-π + longitude * angular_step_) * Radian).ToCartesian());
+}
+
+template<typename Frame>
+void GeopotentialGrid<Frame>::ComputeAccelerations() {
+  // The surface frame is sampled at an arbitrary instant.
+  Instant const t;
+  auto const from_surface_frame =
+      body_->template FromSurfaceFrame<SurfaceFrame>(t);
+  auto const to_surface_frame = from_surface_frame.Inverse();
+
+  std::vector<Displacement<Frame>> displacements;
+  displacements.reserve(number_of_nodes());
+  for (int i = 0; i < radii(); ++i) {
+    for (int j = 0; j < latitudes(); ++j) {
+      for (int k = 0; k < longitudes(); ++k) {
+        displacements.push_back(
+            from_surface_frame(GridDisplacement(i, j, k)));
+      }
+    }
+  }
+  std::vector<Vector<ReducedAcceleration, Frame>> accelerations;
+  geopotential_.GeneralSphericalHarmonicsAccelerations(
+      t, displacements, accelerations);
+
+  accelerations_.clear();
+  accelerations_.reserve(3 * number_of_nodes());
+  for (auto const& acceleration : accelerations) {
+    auto const coordinates =
+        to_surface_frame(acceleration).coordinates() /
+        si::Unit<ReducedAcceleration>;
+    accelerations_.push_back(coordinates.x);
+    accelerations_.push_back(coordinates.y);
+    accelerations_.push_back(coordinates.z);
+  }
+}
+
+template<typename Frame>
+void GeopotentialGrid<Frame>::EstimateError() {
+  // The interpolation error is largest far from the nodes, so we look at the
+  // centres of the cells.  Sampling them all would cost as much as computing
+  // the table again, so we take a bounded number of them.
+  Instant const t;
+  auto const from_surface_frame =
+      body_->template FromSurfaceFrame<SurfaceFrame>(t);
+  auto const to_surface_frame = from_surface_frame.Inverse();
+  int const radial_stride = std::max(1, radial_divisions_ / 8);
+  int const latitude_stride = std::max(1, latitudes() / 16);
+  int const longitude_stride = std::max(1, longitudes() / 32);
+
+  std::vector<Displacement<SurfaceFrame>> samples;
+  for (int i = 0; i < radial_divisions_; i += radial_stride) {
+    for (int j = 0; j < latitudes(); j += latitude_stride) {
+      for (int k = 0; k < longitudes(); k += longitude_stride) {
+        samples.push_back(GridDisplacement(i + 0.5, j + 0.5, k + 0.5));
+      }
+    }
+  }
+  std::vector<Displacement<Frame>> displacements;
+  displacements.reserve(samples.size());
+  for (auto const& sample : samples) {
+    displacements.push_back(from_surface_frame(sample));
+  }
+  std::vector<Vector<ReducedAcceleration, Frame>> accelerations;
+  geopotential_.GeneralSphericalHarmonicsAccelerations(
+      t, displacements, accelerations);
+
+  // The reduced central acceleration is 1 / r².
+  estimated_error_ = 0;
+  for (std::size_t s = 0; s < samples.size(); ++s) {
+    estimated_error_ = std::max(
+        estimated_error_,
+        (Interpolate(samples[s]) - to_surface_frame(accelerations[s])).Norm() *
+            samples[s].Norm²());
+  }
+}
+
+}  // namespace internal
+}  // namespace _geopotential_grid
+}  // namespace physics
+}  // namespace principia
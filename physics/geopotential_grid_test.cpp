@@ -0,0 +1,263 @@
+#include "physics/geopotential_grid.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "physics/geopotential.hpp"
+#include "physics/massive_body.hpp"
+#include "physics/oblate_body.hpp"
+#include "physics/rotating_body.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "serialization/geometry.pb.h"
+#include "serialization/physics.pb.h"
+#include "testing_utilities/numerics_matchers.hpp"
+
+namespace principia {
+namespace physics {
+
+using ::testing::Gt;
+using ::testing::Le;
+using ::testing::Lt;
+using namespace principia::geometry::_frame;
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::physics::_geopotential;
+using namespace principia::physics::_geopotential_grid;
+using namespace principia::physics::_massive_body;
+using namespace principia::physics::_oblate_body;
+using namespace principia::physics::_rotating_body;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_numerics_matchers;
+
+class GeopotentialGridTest : public ::testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      Inertial,
+                      Handedness::Right,
+                      serialization::Frame::TEST>;
+
+  // A body with random coefficients up to degree 8, of a magnitude similar to
+  // those of the Earth, with an inclined axis.
+  GeopotentialGridTest()
+      : body_(MassiveBody::Parameters(4e14 * si::Unit<GravitationalParameter>),
+              RotatingBody<World>::Parameters(
+                  /*mean_radius=*/6.4e6 * Metre,
+                  /*reference_angle=*/3 * Radian,
+                  /*reference_instant=*/Instant(),
+                  /*angular_frequency=*/7e-5 * Radian / Second,
+                  /*right_ascension_of_pole=*/0.3 * Radian,
+                  /*declination_of_pole=*/1.2 * Radian),
+              OblateBody<World>::Parameters::ReadFromMessage(
+                  RandomGeopotential(/*degree=*/8), 6.4e6 * Metre)) {}
+
+  static serialization::OblateBody::Geopotential RandomGeopotential(
+      int const degree) {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> distribution(-1e-6, 1e-6);
+    serialization::OblateBody::Geopotential message;
+    for (int n = 2; n <= degree; ++n) {
+      auto* const row = message.add_row();
+      row->set_degree(n);
+      for (int m = 0; m <= n; ++m) {
+        auto* const column = row->add_column();
+        column->set_order(m);
+        column->set_cos(n == 2 && m == 0 ? -1e-3 : distribution(random));
+        column->set_sin(m == 0 ? 0 : distribution(random));
+      }
+    }
+    return message;
+  }
+
+  template<typename Geopotential>
+  static Vector<Quotient<Acceleration, GravitationalParameter>, World>
+  GeneralSphericalHarmonicsAcceleration(Geopotential const& geopotential,
+                                        Instant const& t,
+                                        Displacement<World> const& r) {
+    auto const r² = r.Norm²();
+    auto const r_norm = Sqrt(r²);
+    auto const one_over_r³ = r_norm / (r² * r²);
+    return geopotential.GeneralSphericalHarmonicsAcceleration(
+        t, r, r_norm, r², one_over_r³);
+  }
+
+  // A random displacement whose norm is uniformly distributed in
+  // [min_radius, max_radius].
+  static Displacement<World> RandomDisplacement(Length const& min_radius,
+                                                Length const& max_radius,
+                                                std::mt19937_64& random) {
+    std::uniform_real_distribution<double> direction_distribution(-1, 1);
+    std::uniform_real_distribution<double> radius_distribution(
+        min_radius / Metre, max_radius / Metre);
+    Vector<double, World> const direction({direction_distribution(random),
+                                           direction_distribution(random),
+                                           direction_distribution(random)});
+    return radius_distribution(random) * Metre * direction / direction.Norm();
+  }
+
+  Length const inner_radius_ = 6.5e6 * Metre;
+  Length const outer_radius_ = 8e6 * Metre;
+  OblateBody<World> const body_;
+};
+
+TEST_F(GeopotentialGridTest, Interpolation) {
+  GeopotentialGrid<World> const grid(&body_,
+                                     /*tolerance=*/0,
+                                     inner_radius_,
+                                     outer_radius_,
+                                     /*longitude_divisions=*/128,
+                                     /*radial_divisions=*/16);
+  EXPECT_EQ(17 * 64 * 128, grid.number_of_nodes());
+  EXPECT_THAT(grid.estimated_error(), Lt(1e-7));
+
+  // The error relative to the central force is commensurate with the estimate
+  // everywhere in the shell, including near the poles and the boundaries.
+  std::mt19937_64 random(42);
+  Instant const t = Instant() + 1 * Hour;
+  double max_error = 0;
+  for (int i = 0; i < 1000; ++i) {
+    Displacement<World> const r =
+        RandomDisplacement(inner_radius_, outer_radius_, random);
+    auto const expected =
+        GeneralSphericalHarmonicsAcceleration(grid.geopotential(), t, r);
+    auto const actual = GeneralSphericalHarmonicsAcceleration(grid, t, r);
+    max_error = std::max(max_error, (actual - expected).Norm() * r.Norm²());
+  }
+  EXPECT_THAT(max_error, Le(2 * grid.estimated_error()));
+
+  // Outside of the shell the geopotential is used.
+  for (int i = 0; i < 100; ++i) {
+    Displacement<World> const r = RandomDisplacement(
+        outer_radius_, 2 * outer_radius_, random);
+    EXPECT_EQ(GeneralSphericalHarmonicsAcceleration(grid.geopotential(), t, r),
+              GeneralSphericalHarmonicsAcceleration(grid, t, r));
+  }
+}
+
+// The interpolated acceleration is blended into the exact one near the
+// boundaries of the shell, so there is no jump there.
+TEST_F(GeopotentialGridTest, Continuity) {
+  GeopotentialGrid<World> const grid(&body_,
+                                     /*tolerance=*/0,
+                                     inner_radius_,
+                                     outer_radius_,
+                                     /*longitude_divisions=*/32,
+                                     /*radial_divisions=*/4);
+  std::mt19937_64 random(42);
+  Instant const t = Instant() + 1 * Hour;
+  for (int i = 0; i < 100; ++i) {
+    Vector<double, World> const direction =
+        RandomDisplacement(1 * Metre, 1 * Metre, random) / Metre;
+    for (Length const& radius : {inner_radius_, outer_radius_}) {
+      for (double const ε : {-1e-9, 1e-9}) {
+        Displacement<World> const r = radius * (1 + ε) * direction;
+        auto const exact =
+            GeneralSphericalHarmonicsAcceleration(grid.geopotential(), t, r);
+        EXPECT_THAT(GeneralSphericalHarmonicsAcceleration(grid, t, r),
+                    RelativeErrorFrom(exact, Lt(1e-7))) << i;
+      }
+    }
+  }
+}
+
+TEST_F(GeopotentialGridTest, Batch) {
+  GeopotentialGrid<World> const grid(&body_,
+                                     /*tolerance=*/0,
+                                     inner_radius_,
+                                     outer_radius_,
+                                     /*longitude_divisions=*/32,
+                                     /*radial_divisions=*/4);
+
+  // The displacements are both inside and outside of the shell.
+  std::mt19937_64 random(42);
+  Instant const t = Instant() + 1 * Hour;
+  std::vector<Displacement<World>> displacements;
+  for (int i = 0; i < 100; ++i) {
+    displacements.push_back(
+        RandomDisplacement(0.5 * inner_radius_, 2 * outer_radius_, random));
+  }
+
+  std::vector<Vector<Quotient<Acceleration, GravitationalParameter>, World>>
+      accelerations;
+  grid.GeneralSphericalHarmonicsAccelerations(t, displacements, accelerations);
+  ASSERT_EQ(displacements.size(), accelerations.size());
+  // Outside of the shell the summations of the geopotential are not done in the
+  // same order.
+  for (int i = 0; i < displacements.size(); ++i) {
+    EXPECT_THAT(accelerations[i],
+                RelativeErrorFrom(GeneralSphericalHarmonicsAcceleration(
+                                      grid, t, displacements[i]),
+                                  Lt(1e-14))) << i;
+  }
+}
+
+TEST_F(GeopotentialGridTest, ForTolerance) {
+  double const tolerance = 0x1.0p-24;
+  auto const grid = GeopotentialGrid<World>::ForTolerance(&body_,
+                                                          tolerance,
+                                                          inner_radius_,
+                                                          outer_radius_,
+                                                          /*max_nodes=*/1e7);
+  ASSERT_TRUE(grid.has_value());
+  EXPECT_THAT(grid->estimated_error(), Le(tolerance));
+  EXPECT_EQ(13 * 72 * 144, grid->number_of_nodes());
+
+  // The previous refinement was not good enough.
+  GeopotentialGrid<World> const coarser_grid(&body_,
+                                             tolerance,
+                                             inner_radius_,
+                                             outer_radius_,
+                                             /*longitude_divisions=*/72,
+                                             /*radial_divisions=*/6);
+  EXPECT_THAT(coarser_grid.estimated_error(), Gt(tolerance));
+}
+
+TEST_F(GeopotentialGridTest, ForToleranceMaxNodes) {
+  double const tolerance = 0x1.0p-24;
+
+  // The refinement stops before exceeding the budget, even if the tolerance is
+  // not met.
+  std::int64_t const refined_nodes = 7 * 36 * 72;
+  auto const refined_grid =
+      GeopotentialGrid<World>::ForTolerance(&body_,
+                                            tolerance,
+                                            inner_radius_,
+                                            outer_radius_,
+                                            /*max_nodes=*/refined_nodes);
+  ASSERT_TRUE(refined_grid.has_value());
+  EXPECT_EQ(refined_nodes, refined_grid->number_of_nodes());
+  EXPECT_THAT(refined_grid->estimated_error(), Gt(tolerance));
+
+  // No grid is built if the initial one doesn't fit in the budget.
+  std::int64_t const initial_nodes = 4 * 18 * 36;
+  EXPECT_TRUE(GeopotentialGrid<World>::ForTolerance(&body_,
+                                                    tolerance,
+                                                    inner_radius_,
+                                                    outer_radius_,
+                                                    /*max_nodes=*/initial_nodes)
+                  .has_value());
+  EXPECT_FALSE(
+      GeopotentialGrid<World>::ForTolerance(&body_,
+                                            tolerance,
+                                            inner_radius_,
+                                            outer_radius_,
+                                            /*max_nodes=*/initial_nodes - 1)
+          .has_value());
+}
+
+}  // namespace physics
+}  // namespace principia
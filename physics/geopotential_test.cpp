@@ -843,5 +843,46 @@ TEST_F(GeopotentialTest, Potential) {
   }
 }
 
+TEST_F(GeopotentialTest, Batch) {
+  SolarSystem<ICRS> solar_system_2000(
+            SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+            SOLUTION_DIR / "astronomy" /
+                "sol_initial_state_jd_2451545_000000000.proto.txt");
+  auto earth_message = solar_system_2000.gravity_model_message("Earth");
+  auto const earth = solar_system_2000.MakeOblateBody(earth_message);
+  Geopotential<ICRS> const geopotential(earth.get(), /*tolerance=*/0x1.0p-24);
+  Instant const t = Instant() + 3 * Hour;
+
+  // The displacements span the range where the tesseral harmonics matter and
+  // the one where the geopotential is zonal.
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<double> log_length_distribution(6.5, 9);
+  std::uniform_real_distribution<double> direction_distribution(-1, 1);
+  std::vector<Displacement<ICRS>> displacements;
+  for (int i = 0; i < 100; ++i) {
+    Vector<double, ICRS> const direction({direction_distribution(random),
+                                          direction_distribution(random),
+                                          direction_distribution(random)});
+    displacements.push_back(std::pow(10, log_length_distribution(random)) *
+                            Metre * direction / direction.Norm());
+  }
+  displacements.push_back(NaN<Length> * Vector<double, ICRS>({1, 0, 0}));
+
+  std::vector<Vector<Quotient<Acceleration, GravitationalParameter>, ICRS>>
+      accelerations;
+  geopotential.GeneralSphericalHarmonicsAccelerations(
+      t, displacements, accelerations);
+  ASSERT_EQ(displacements.size(), accelerations.size());
+  // The summations are not done in the same order.
+  for (int i = 0; i < displacements.size() - 1; ++i) {
+    EXPECT_THAT(accelerations[i],
+                RelativeErrorFrom(GeneralSphericalHarmonicsAcceleration(
+                                      geopotential, t, displacements[i]),
+                                  Lt(1e-14))) << i;
+  }
+  auto const nan_acceleration = accelerations.back().coordinates().x;
+  EXPECT_NE(nan_acceleration, nan_acceleration);
+}
+
 }  // namespace physics
 }  // namespace principia
@@ -36,6 +36,14 @@ class MockEphemeris : public Ephemeris<Frame> {
               (not_null<MassiveBody const*> body),
               (const, override));
   MOCK_METHOD(bool, empty, (), (const, override));
+  MOCK_METHOD(std::vector<Position<Frame>>,
+              EvaluateAllPositions,
+              (Instant const& t),
+              (const, override));
+  MOCK_METHOD(std::vector<DegreesOfFreedom<Frame>>,
+              EvaluateAllDegreesOfFreedom,
+              (Instant const& t),
+              (const, override));
   MOCK_METHOD(Instant, t_min, (), (const, override));
   MOCK_METHOD(Instant, t_max, (), (const, override));
   MOCK_METHOD(FixedStepSizeIntegrator<NewtonianMotionEquation> const&,
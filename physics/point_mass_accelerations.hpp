@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "base/cpuid.hpp"
+#include "base/macros.hpp"
+
+namespace principia {
+namespace physics {
+namespace _point_mass_accelerations {
+namespace internal {
+
+using namespace principia::base::_cpuid;
+
+// As for FMA, with clang using AVX requires VEX-encoding everything; see #3019.
+#if PRINCIPIA_COMPILER_MSVC
+constexpr bool CanEmitAVXInstructions = true;
+#else
+constexpr bool CanEmitAVXInstructions = false;
+#endif
+
+// The vectorized code paths below may only be used if the corresponding flag
+// is true.
+#if PRINCIPIA_USE_AVX_IF_AVAILABLE
+inline bool const UseAVX = CanEmitAVXInstructions &&
+                           HasCPUFeatures(CPUFeatureFlags::AVX) &&
+                           OperatingSystemSupportsAVX();
+inline bool const UseAVX512 =
+    UseAVX &&
+    HasCPUFeatures(CPUExtendedFeatureFlags::AVX512F) &&
+    OperatingSystemSupportsAVX512();
+#else
+inline bool const UseAVX = false;
+inline bool const UseAVX512 = false;
+#endif
+
+// The positions, gravitational parameters and accelerations of a set of point
+// masses, in structure-of-arrays form.  All the quantities are expressed in SI
+// units.  This representation makes it possible to compute the interactions
+// between 4 (AVX) or 8 (AVX-512) pairs of bodies per instruction.  It is also
+// used for massless bodies, in which case the gravitational parameters are
+// ignored.
+struct PointMassArrays {
+  // Resizes all the arrays to |size| and zeroes the accelerations.
+  void Reset(std::int64_t size);
+
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> z;
+  std::vector<double> μ;
+  std::vector<double> ax;
+  std::vector<double> ay;
+  std::vector<double> az;
+};
+
+// Adds to the accelerations in |arrays| the point-mass gravitational
+// accelerations between the body with index |b1| and the bodies with indices
+// in [b2_begin, b2_end[, which must not contain |b1|.  Uses the widest vector
+// instructions available.  The accelerations of the bodies in
+// [b2_begin, b2_end[ are computed in the same way irrespective of the
+// instruction set, but the acceleration of |b1| may differ in the last bits
+// because the vectorized code paths change the order of the summation.
+inline void AccumulateMutualAccelerations(std::int64_t b1,
+                                          std::int64_t b2_begin,
+                                          std::int64_t b2_end,
+                                          PointMassArrays& arrays);
+
+// Adds to the accelerations in |arrays| the point-mass gravitational
+// acceleration exerted by a body with gravitational parameter |μ1| located at
+// (|x1|, |y1|, |z1|).  The gravitational parameters in |arrays| are ignored.
+// Returns true if and only if one of the bodies in |arrays| is not farther than
+// |collision_radius| from the massive body.  Uses the widest vector
+// instructions available; the accelerations are computed in the same way
+// irrespective of the instruction set.
+inline bool AccumulateAccelerationsByPointMass(double x1,
+                                               double y1,
+                                               double z1,
+                                               double μ1,
+                                               double collision_radius,
+                                               PointMassArrays& arrays);
+
+}  // namespace internal
+
+using internal::AccumulateAccelerationsByPointMass;
+using internal::AccumulateMutualAccelerations;
+using internal::CanEmitAVXInstructions;
+using internal::PointMassArrays;
+using internal::UseAVX;
+using internal::UseAVX512;
+
+}  // namespace _point_mass_accelerations
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/point_mass_accelerations_body.hpp"
@@ -0,0 +1,357 @@
+#pragma once
+
+#include "physics/point_mass_accelerations.hpp"
+
+#include <immintrin.h>
+
+#include <cmath>
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace physics {
+namespace _point_mass_accelerations {
+namespace internal {
+
+// Processes the bodies with indices in [b2_begin, b2_end[ one at a time.  This
+// is the same computation as
+// |Ephemeris::ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies|.
+inline void AccumulateMutualAccelerationsScalar(std::int64_t const b1,
+                                                std::int64_t const b2_begin,
+                                                std::int64_t const b2_end,
+                                                PointMassArrays& arrays) {
+  double const x1 = arrays.x[b1];
+  double const y1 = arrays.y[b1];
+  double const z1 = arrays.z[b1];
+  double const μ1 = arrays.μ[b1];
+  for (std::int64_t b2 = b2_begin; b2 < b2_end; ++b2) {
+    // A vector from the center of |b2| to the center of |b1|.
+    double const Δx = x1 - arrays.x[b2];
+    double const Δy = y1 - arrays.y[b2];
+    double const Δz = z1 - arrays.z[b2];
+
+    double const Δq² = Δx * Δx + Δy * Δy + Δz * Δz;
+    double const Δq_norm = std::sqrt(Δq²);
+    double const one_over_Δq³ = Δq_norm / (Δq² * Δq²);
+
+    double const μ1_over_Δq³ = μ1 * one_over_Δq³;
+    arrays.ax[b2] += Δx * μ1_over_Δq³;
+    arrays.ay[b2] += Δy * μ1_over_Δq³;
+    arrays.az[b2] += Δz * μ1_over_Δq³;
+
+    double const μ2_over_Δq³ = arrays.μ[b2] * one_over_Δq³;
+    arrays.ax[b1] -= Δx * μ2_over_Δq³;
+    arrays.ay[b1] -= Δy * μ2_over_Δq³;
+    arrays.az[b1] -= Δz * μ2_over_Δq³;
+  }
+}
+
+// Processes the bodies with indices in [b2_begin, b2_end[ 4 at a time and
+// returns the index of the first body that was not processed.
+inline std::int64_t AccumulateMutualAccelerationsAVX(
+    std::int64_t const b1,
+    std::int64_t const b2_begin,
+    std::int64_t const b2_end,
+    PointMassArrays& arrays) {
+  if constexpr (CanEmitAVXInstructions) {
+    __m256d const x1 = _mm256_set1_pd(arrays.x[b1]);
+    __m256d const y1 = _mm256_set1_pd(arrays.y[b1]);
+    __m256d const z1 = _mm256_set1_pd(arrays.z[b1]);
+    __m256d const μ1 = _mm256_set1_pd(arrays.μ[b1]);
+    __m256d ax1 = _mm256_setzero_pd();
+    __m256d ay1 = _mm256_setzero_pd();
+    __m256d az1 = _mm256_setzero_pd();
+    std::int64_t b2 = b2_begin;
+    for (; b2 + 4 <= b2_end; b2 += 4) {
+      __m256d const Δx = _mm256_sub_pd(x1, _mm256_loadu_pd(&arrays.x[b2]));
+      __m256d const Δy = _mm256_sub_pd(y1, _mm256_loadu_pd(&arrays.y[b2]));
+      __m256d const Δz = _mm256_sub_pd(z1, _mm256_loadu_pd(&arrays.z[b2]));
+
+      __m256d const Δq² = _mm256_add_pd(
+          _mm256_add_pd(_mm256_mul_pd(Δx, Δx), _mm256_mul_pd(Δy, Δy)),
+          _mm256_mul_pd(Δz, Δz));
+      __m256d const Δq_norm = _mm256_sqrt_pd(Δq²);
+      __m256d const one_over_Δq³ =
+          _mm256_div_pd(Δq_norm, _mm256_mul_pd(Δq², Δq²));
+
+      __m256d const μ1_over_Δq³ = _mm256_mul_pd(μ1, one_over_Δq³);
+      _mm256_storeu_pd(&arrays.ax[b2],
+                       _mm256_add_pd(_mm256_loadu_pd(&arrays.ax[b2]),
+                                     _mm256_mul_pd(Δx, μ1_over_Δq³)));
+      _mm256_storeu_pd(&arrays.ay[b2],
+                       _mm256_add_pd(_mm256_loadu_pd(&arrays.ay[b2]),
+                                     _mm256_mul_pd(Δy, μ1_over_Δq³)));
+      _mm256_storeu_pd(&arrays.az[b2],
+                       _mm256_add_pd(_mm256_loadu_pd(&arrays.az[b2]),
+                                     _mm256_mul_pd(Δz, μ1_over_Δq³)));
+
+      __m256d const μ2_over_Δq³ =
+          _mm256_mul_pd(_mm256_loadu_pd(&arrays.μ[b2]), one_over_Δq³);
+      ax1 = _mm256_sub_pd(ax1, _mm256_mul_pd(Δx, μ2_over_Δq³));
+      ay1 = _mm256_sub_pd(ay1, _mm256_mul_pd(Δy, μ2_over_Δq³));
+      az1 = _mm256_sub_pd(az1, _mm256_mul_pd(Δz, μ2_over_Δq³));
+    }
+
+    // Horizontal sums for the acceleration on |b1|.
+    auto const sum = [](__m256d const v) {
+      __m128d const pair = _mm_add_pd(_mm256_castpd256_pd128(v),
+                                      _mm256_extractf128_pd(v, 1));
+      return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    };
+    arrays.ax[b1] += sum(ax1);
+    arrays.ay[b1] += sum(ay1);
+    arrays.az[b1] += sum(az1);
+    return b2;
+  } else {
+    LOG(FATAL) << "Clang cannot use AVX without VEX-encoding everything";
+  }
+}
+
+// Processes the bodies with indices in [b2_begin, b2_end[ 8 at a time and
+// returns the index of the first body that was not processed.
+inline std::int64_t AccumulateMutualAccelerationsAVX512(
+    std::int64_t const b1,
+    std::int64_t const b2_begin,
+    std::int64_t const b2_end,
+    PointMassArrays& arrays) {
+  if constexpr (CanEmitAVXInstructions) {
+    __m512d const x1 = _mm512_set1_pd(arrays.x[b1]);
+    __m512d const y1 = _mm512_set1_pd(arrays.y[b1]);
+    __m512d const z1 = _mm512_set1_pd(arrays.z[b1]);
+    __m512d const μ1 = _mm512_set1_pd(arrays.μ[b1]);
+    __m512d ax1 = _mm512_setzero_pd();
+    __m512d ay1 = _mm512_setzero_pd();
+    __m512d az1 = _mm512_setzero_pd();
+    std::int64_t b2 = b2_begin;
+    for (; b2 + 8 <= b2_end; b2 += 8) {
+      __m512d const Δx = _mm512_sub_pd(x1, _mm512_loadu_pd(&arrays.x[b2]));
+      __m512d const Δy = _mm512_sub_pd(y1, _mm512_loadu_pd(&arrays.y[b2]));
+      __m512d const Δz = _mm512_sub_pd(z1, _mm512_loadu_pd(&arrays.z[b2]));
+
+      __m512d const Δq² = _mm512_add_pd(
+          _mm512_add_pd(_mm512_mul_pd(Δx, Δx), _mm512_mul_pd(Δy, Δy)),
+          _mm512_mul_pd(Δz, Δz));
+      __m512d const Δq_norm = _mm512_sqrt_pd(Δq²);
+      __m512d const one_over_Δq³ =
+          _mm512_div_pd(Δq_norm, _mm512_mul_pd(Δq², Δq²));
+
+      __m512d const μ1_over_Δq³ = _mm512_mul_pd(μ1, one_over_Δq³);
+      _mm512_storeu_pd(&arrays.ax[b2],
+                       _mm512_add_pd(_mm512_loadu_pd(&arrays.ax[b2]),
+                                     _mm512_mul_pd(Δx, μ1_over_Δq³)));
+      _mm512_storeu_pd(&arrays.ay[b2],
+                       _mm512_add_pd(_mm512_loadu_pd(&arrays.ay[b2]),
+                                     _mm512_mul_pd(Δy, μ1_over_Δq³)));
+      _mm512_storeu_pd(&arrays.az[b2],
+                       _mm512_add_pd(_mm512_loadu_pd(&arrays.az[b2]),
+                                     _mm512_mul_pd(Δz, μ1_over_Δq³)));
+
+      __m512d const μ2_over_Δq³ =
+          _mm512_mul_pd(_mm512_loadu_pd(&arrays.μ[b2]), one_over_Δq³);
+      ax1 = _mm512_sub_pd(ax1, _mm512_mul_pd(Δx, μ2_over_Δq³));
+      ay1 = _mm512_sub_pd(ay1, _mm512_mul_pd(Δy, μ2_over_Δq³));
+      az1 = _mm512_sub_pd(az1, _mm512_mul_pd(Δz, μ2_over_Δq³));
+    }
+
+    arrays.ax[b1] += _mm512_reduce_add_pd(ax1);
+    arrays.ay[b1] += _mm512_reduce_add_pd(ay1);
+    arrays.az[b1] += _mm512_reduce_add_pd(az1);
+    return b2;
+  } else {
+    LOG(FATAL) << "Clang cannot use AVX without VEX-encoding everything";
+  }
+}
+
+// Processes the bodies with indices in [b_begin, b_end[ one at a time.  This
+// is the same computation as
+// |Ephemeris::ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies|.
+inline bool AccumulateAccelerationsByPointMassScalar(
+    double const x1,
+    double const y1,
+    double const z1,
+    double const μ1,
+    double const collision_radius,
+    std::int64_t const b_begin,
+    std::int64_t const b_end,
+    PointMassArrays& arrays) {
+  bool collision = false;
+  for (std::int64_t b = b_begin; b < b_end; ++b) {
+    // A vector from the center of |b| to the center of the massive body.
+    double const Δx = x1 - arrays.x[b];
+    double const Δy = y1 - arrays.y[b];
+    double const Δz = z1 - arrays.z[b];
+
+    double const Δq² = Δx * Δx + Δy * Δy + Δz * Δz;
+    double const Δq_norm = std::sqrt(Δq²);
+    // Written so that NaNs result in a collision.
+    collision |= !(Δq_norm > collision_radius);
+    double const one_over_Δq³ = Δq_norm / (Δq² * Δq²);
+
+    double const μ1_over_Δq³ = μ1 * one_over_Δq³;
+    arrays.ax[b] += Δx * μ1_over_Δq³;
+    arrays.ay[b] += Δy * μ1_over_Δq³;
+    arrays.az[b] += Δz * μ1_over_Δq³;
+  }
+  return collision;
+}
+
+// Processes the bodies with indices in [b_begin, b_end[ 4 at a time.  Returns
+// the index of the first body that was not processed, and sets |collision| if
+// a collision was detected.
+inline std::int64_t AccumulateAccelerationsByPointMassAVX(
+    double const x1,
+    double const y1,
+    double const z1,
+    double const μ1,
+    double const collision_radius,
+    std::int64_t const b_begin,
+    std::int64_t const b_end,
+    PointMassArrays& arrays,
+    bool& collision) {
+  if constexpr (CanEmitAVXInstructions) {
+    __m256d const x1_256d = _mm256_set1_pd(x1);
+    __m256d const y1_256d = _mm256_set1_pd(y1);
+    __m256d const z1_256d = _mm256_set1_pd(z1);
+    __m256d const μ1_256d = _mm256_set1_pd(μ1);
+    __m256d const collision_radius_256d = _mm256_set1_pd(collision_radius);
+    __m256d collisions = _mm256_setzero_pd();
+    std::int64_t b = b_begin;
+    for (; b + 4 <= b_end; b += 4) {
+      __m256d const Δx = _mm256_sub_pd(x1_256d, _mm256_loadu_pd(&arrays.x[b]));
+      __m256d const Δy = _mm256_sub_pd(y1_256d, _mm256_loadu_pd(&arrays.y[b]));
+      __m256d const Δz = _mm256_sub_pd(z1_256d, _mm256_loadu_pd(&arrays.z[b]));
+
+      __m256d const Δq² = _mm256_add_pd(
+          _mm256_add_pd(_mm256_mul_pd(Δx, Δx), _mm256_mul_pd(Δy, Δy)),
+          _mm256_mul_pd(Δz, Δz));
+      __m256d const Δq_norm = _mm256_sqrt_pd(Δq²);
+      // The unordered predicate ensures that NaNs result in a collision.
+      collisions = _mm256_or_pd(
+          collisions,
+          _mm256_cmp_pd(Δq_norm, collision_radius_256d, _CMP_NGT_UQ));
+      __m256d const one_over_Δq³ =
+          _mm256_div_pd(Δq_norm, _mm256_mul_pd(Δq², Δq²));
+
+      __m256d const μ1_over_Δq³ = _mm256_mul_pd(μ1_256d, one_over_Δq³);
+      _mm256_storeu_pd(&arrays.ax[b],
+                       _mm256_add_pd(_mm256_loadu_pd(&arrays.ax[b]),
+                                     _mm256_mul_pd(Δx, μ1_over_Δq³)));
+      _mm256_storeu_pd(&arrays.ay[b],
+                       _mm256_add_pd(_mm256_loadu_pd(&arrays.ay[b]),
+                                     _mm256_mul_pd(Δy, μ1_over_Δq³)));
+      _mm256_storeu_pd(&arrays.az[b],
+                       _mm256_add_pd(_mm256_loadu_pd(&arrays.az[b]),
+                                     _mm256_mul_pd(Δz, μ1_over_Δq³)));
+    }
+    collision |= _mm256_movemask_pd(collisions) != 0;
+    return b;
+  } else {
+    LOG(FATAL) << "Clang cannot use AVX without VEX-encoding everything";
+  }
+}
+
+// Processes the bodies with indices in [b_begin, b_end[ 8 at a time.  Returns
+// the index of the first body that was not processed, and sets |collision| if
+// a collision was detected.
+inline std::int64_t AccumulateAccelerationsByPointMassAVX512(
+    double const x1,
+    double const y1,
+    double const z1,
+    double const μ1,
+    double const collision_radius,
+    std::int64_t const b_begin,
+    std::int64_t const b_end,
+    PointMassArrays& arrays,
+    bool& collision) {
+  if constexpr (CanEmitAVXInstructions) {
+    __m512d const x1_512d = _mm512_set1_pd(x1);
+    __m512d const y1_512d = _mm512_set1_pd(y1);
+    __m512d const z1_512d = _mm512_set1_pd(z1);
+    __m512d const μ1_512d = _mm512_set1_pd(μ1);
+    __m512d const collision_radius_512d = _mm512_set1_pd(collision_radius);
+    __mmask8 collisions = 0;
+    std::int64_t b = b_begin;
+    for (; b + 8 <= b_end; b += 8) {
+      __m512d const Δx = _mm512_sub_pd(x1_512d, _mm512_loadu_pd(&arrays.x[b]));
+      __m512d const Δy = _mm512_sub_pd(y1_512d, _mm512_loadu_pd(&arrays.y[b]));
+      __m512d const Δz = _mm512_sub_pd(z1_512d, _mm512_loadu_pd(&arrays.z[b]));
+
+      __m512d const Δq² = _mm512_add_pd(
+          _mm512_add_pd(_mm512_mul_pd(Δx, Δx), _mm512_mul_pd(Δy, Δy)),
+          _mm512_mul_pd(Δz, Δz));
+      __m512d const Δq_norm = _mm512_sqrt_pd(Δq²);
+      // The unordered predicate ensures that NaNs result in a collision.
+      collisions |=
+          _mm512_cmp_pd_mask(Δq_norm, collision_radius_512d, _CMP_NGT_UQ);
+      __m512d const one_over_Δq³ =
+          _mm512_div_pd(Δq_norm, _mm512_mul_pd(Δq², Δq²));
+
+      __m512d const μ1_over_Δq³ = _mm512_mul_pd(μ1_512d, one_over_Δq³);
+      _mm512_storeu_pd(&arrays.ax[b],
+                       _mm512_add_pd(_mm512_loadu_pd(&arrays.ax[b]),
+                                     _mm512_mul_pd(Δx, μ1_over_Δq³)));
+      _mm512_storeu_pd(&arrays.ay[b],
+                       _mm512_add_pd(_mm512_loadu_pd(&arrays.ay[b]),
+                                     _mm512_mul_pd(Δy, μ1_over_Δq³)));
+      _mm512_storeu_pd(&arrays.az[b],
+                       _mm512_add_pd(_mm512_loadu_pd(&arrays.az[b]),
+                                     _mm512_mul_pd(Δz, μ1_over_Δq³)));
+    }
+    collision |= collisions != 0;
+    return b;
+  } else {
+    LOG(FATAL) << "Clang cannot use AVX without VEX-encoding everything";
+  }
+}
+
+inline void PointMassArrays::Reset(std::int64_t const size) {
+  x.resize(size);
+  y.resize(size);
+  z.resize(size);
+  μ.resize(size);
+  ax.assign(size, 0);
+  ay.assign(size, 0);
+  az.assign(size, 0);
+}
+
+inline void AccumulateMutualAccelerations(std::int64_t const b1,
+                                          std::int64_t const b2_begin,
+                                          std::int64_t const b2_end,
+                                          PointMassArrays& arrays) {
+  DCHECK(b1 < b2_begin || b1 >= b2_end);
+  std::int64_t b2 = b2_begin;
+  if (UseAVX512) {
+    b2 = AccumulateMutualAccelerationsAVX512(b1, b2, b2_end, arrays);
+  }
+  if (UseAVX) {
+    b2 = AccumulateMutualAccelerationsAVX(b1, b2, b2_end, arrays);
+  }
+  AccumulateMutualAccelerationsScalar(b1, b2, b2_end, arrays);
+}
+
+inline bool AccumulateAccelerationsByPointMass(double const x1,
+                                               double const y1,
+                                               double const z1,
+                                               double const μ1,
+                                               double const collision_radius,
+                                               PointMassArrays& arrays) {
+  std::int64_t const b_end = arrays.x.size();
+  bool collision = false;
+  std::int64_t b = 0;
+  if (UseAVX512) {
+    b = AccumulateAccelerationsByPointMassAVX512(
+        x1, y1, z1, μ1, collision_radius, b, b_end, arrays, collision);
+  }
+  if (UseAVX) {
+    b = AccumulateAccelerationsByPointMassAVX(
+        x1, y1, z1, μ1, collision_radius, b, b_end, arrays, collision);
+  }
+  collision |= AccumulateAccelerationsByPointMassScalar(
+      x1, y1, z1, μ1, collision_radius, b, b_end, arrays);
+  return collision;
+}
+
+}  // namespace internal
+}  // namespace _point_mass_accelerations
+}  // namespace physics
+}  // namespace principia
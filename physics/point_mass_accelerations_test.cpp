@@ -0,0 +1,196 @@
+#include "physics/point_mass_accelerations.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "testing_utilities/almost_equals.hpp"
+
+namespace principia {
+namespace physics {
+namespace _point_mass_accelerations {
+namespace internal {
+
+using namespace principia::testing_utilities::_almost_equals;
+
+class PointMassAccelerationsTest : public testing::Test {
+ protected:
+  // Not a multiple of 4 or 8, to exercise the scalar tail of the vectorized
+  // code paths.
+  static constexpr std::int64_t number_of_bodies = 19;
+
+  PointMassAccelerationsTest() {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<> position_distribution(-1e12, 1e12);
+    std::uniform_real_distribution<> μ_distribution(1e5, 1e20);
+    arrays_.Reset(number_of_bodies);
+    for (std::int64_t b = 0; b < number_of_bodies; ++b) {
+      arrays_.x[b] = position_distribution(random);
+      arrays_.y[b] = position_distribution(random);
+      arrays_.z[b] = position_distribution(random);
+      arrays_.μ[b] = μ_distribution(random);
+    }
+  }
+
+  // Computes all the mutual accelerations using the scalar code.
+  PointMassArrays ScalarAccelerations() const {
+    PointMassArrays expected = arrays_;
+    for (std::int64_t b1 = 0; b1 < number_of_bodies; ++b1) {
+      AccumulateMutualAccelerationsScalar(
+          b1, /*b2_begin=*/b1 + 1, /*b2_end=*/number_of_bodies, expected);
+    }
+    return expected;
+  }
+
+  void ExpectAccelerationsMatch(PointMassArrays const& actual,
+                                PointMassArrays const& expected) const {
+    for (std::int64_t b = 0; b < number_of_bodies; ++b) {
+      EXPECT_THAT(actual.ax[b], AlmostEquals(expected.ax[b], 0, 32)) << b;
+      EXPECT_THAT(actual.ay[b], AlmostEquals(expected.ay[b], 0, 32)) << b;
+      EXPECT_THAT(actual.az[b], AlmostEquals(expected.az[b], 0, 32)) << b;
+    }
+  }
+
+  PointMassArrays arrays_;
+};
+
+TEST_F(PointMassAccelerationsTest, Scalar) {
+  // Check Newton's third law on the scalar code.
+  PointMassArrays const actual = ScalarAccelerations();
+  double mx = 0;
+  double my = 0;
+  double mz = 0;
+  double max_force = 0;
+  for (std::int64_t b = 0; b < number_of_bodies; ++b) {
+    mx += actual.μ[b] * actual.ax[b];
+    my += actual.μ[b] * actual.ay[b];
+    mz += actual.μ[b] * actual.az[b];
+    max_force = std::max(max_force, std::abs(actual.μ[b] * actual.ax[b]));
+  }
+  EXPECT_LT(std::abs(mx), 1e-12 * max_force);
+  EXPECT_LT(std::abs(my), 1e-12 * max_force);
+  EXPECT_LT(std::abs(mz), 1e-12 * max_force);
+}
+
+TEST_F(PointMassAccelerationsTest, AVX) {
+  // Note that we test even if |UseAVX| is false, i.e., even in debug.
+  if (!CanEmitAVXInstructions ||
+      !HasCPUFeatures(CPUFeatureFlags::AVX) ||
+      !OperatingSystemSupportsAVX()) {
+    GTEST_SKIP() << "Cannot test AVX on a machine without AVX";
+  }
+  PointMassArrays actual = arrays_;
+  for (std::int64_t b1 = 0; b1 < number_of_bodies; ++b1) {
+    std::int64_t const b2 = AccumulateMutualAccelerationsAVX(
+        b1, /*b2_begin=*/b1 + 1, /*b2_end=*/number_of_bodies, actual);
+    AccumulateMutualAccelerationsScalar(
+        b1, b2, /*b2_end=*/number_of_bodies, actual);
+  }
+  ExpectAccelerationsMatch(actual, ScalarAccelerations());
+}
+
+TEST_F(PointMassAccelerationsTest, AVX512) {
+  // Note that we test even if |UseAVX512| is false, i.e., even in debug.
+  if (!CanEmitAVXInstructions ||
+      !HasCPUFeatures(CPUExtendedFeatureFlags::AVX512F) ||
+      !OperatingSystemSupportsAVX512()) {
+    GTEST_SKIP() << "Cannot test AVX-512 on a machine without AVX-512";
+  }
+  PointMassArrays actual = arrays_;
+  for (std::int64_t b1 = 0; b1 < number_of_bodies; ++b1) {
+    std::int64_t const b2 = AccumulateMutualAccelerationsAVX512(
+        b1, /*b2_begin=*/b1 + 1, /*b2_end=*/number_of_bodies, actual);
+    AccumulateMutualAccelerationsScalar(
+        b1, b2, /*b2_end=*/number_of_bodies, actual);
+  }
+  ExpectAccelerationsMatch(actual, ScalarAccelerations());
+}
+
+TEST_F(PointMassAccelerationsTest, Dispatch) {
+  PointMassArrays actual = arrays_;
+  for (std::int64_t b1 = 0; b1 < number_of_bodies; ++b1) {
+    AccumulateMutualAccelerations(
+        b1, /*b2_begin=*/b1 + 1, /*b2_end=*/number_of_bodies, actual);
+  }
+  ExpectAccelerationsMatch(actual, ScalarAccelerations());
+}
+
+TEST_F(PointMassAccelerationsTest, Massless) {
+  double const x1 = 1e11;
+  double const y1 = -2e11;
+  double const z1 = 3e10;
+  double const μ1 = 1e20;
+
+  PointMassArrays expected = arrays_;
+  EXPECT_FALSE(AccumulateAccelerationsByPointMassScalar(
+      x1, y1, z1, μ1,
+      /*collision_radius=*/1e6,
+      /*b_begin=*/0, /*b_end=*/number_of_bodies,
+      expected));
+
+  if (CanEmitAVXInstructions &&
+      HasCPUFeatures(CPUFeatureFlags::AVX) &&
+      OperatingSystemSupportsAVX()) {
+    PointMassArrays actual = arrays_;
+    bool collision = false;
+    std::int64_t const b = AccumulateAccelerationsByPointMassAVX(
+        x1, y1, z1, μ1,
+        /*collision_radius=*/1e6,
+        /*b_begin=*/0, /*b_end=*/number_of_bodies,
+        actual, collision);
+    EXPECT_EQ(16, b);
+    collision |= AccumulateAccelerationsByPointMassScalar(
+        x1, y1, z1, μ1,
+        /*collision_radius=*/1e6,
+        b, /*b_end=*/number_of_bodies,
+        actual);
+    EXPECT_FALSE(collision);
+    ExpectAccelerationsMatch(actual, expected);
+  }
+
+  if (CanEmitAVXInstructions &&
+      HasCPUFeatures(CPUExtendedFeatureFlags::AVX512F) &&
+      OperatingSystemSupportsAVX512()) {
+    PointMassArrays actual = arrays_;
+    bool collision = false;
+    std::int64_t const b = AccumulateAccelerationsByPointMassAVX512(
+        x1, y1, z1, μ1,
+        /*collision_radius=*/1e6,
+        /*b_begin=*/0, /*b_end=*/number_of_bodies,
+        actual, collision);
+    EXPECT_EQ(16, b);
+    collision |= AccumulateAccelerationsByPointMassScalar(
+        x1, y1, z1, μ1,
+        /*collision_radius=*/1e6,
+        b, /*b_end=*/number_of_bodies,
+        actual);
+    EXPECT_FALSE(collision);
+    ExpectAccelerationsMatch(actual, expected);
+  }
+
+  PointMassArrays actual = arrays_;
+  EXPECT_FALSE(AccumulateAccelerationsByPointMass(
+      x1, y1, z1, μ1, /*collision_radius=*/1e6, actual));
+  ExpectAccelerationsMatch(actual, expected);
+}
+
+TEST_F(PointMassAccelerationsTest, Collision) {
+  // Put the massive body close to each of the massless bodies in turn, to
+  // exercise all the lanes.
+  for (std::int64_t b = 0; b < number_of_bodies; ++b) {
+    PointMassArrays actual = arrays_;
+    EXPECT_TRUE(AccumulateAccelerationsByPointMass(arrays_.x[b] + 1,
+                                                   arrays_.y[b],
+                                                   arrays_.z[b],
+                                                   /*μ1=*/1e20,
+                                                   /*collision_radius=*/1e6,
+                                                   actual)) << b;
+  }
+}
+
+}  // namespace internal
+}  // namespace _point_mass_accelerations
+}  // namespace physics
+}  // namespace principia